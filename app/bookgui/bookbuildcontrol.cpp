@@ -329,8 +329,7 @@ BookBuildControl::startAnalysis(const std::vector<Move>& moves) {
     scListener = make_unique<SearchListener>(*this, pos);
     sc->setListener(*scListener);
     std::shared_ptr<MoveList> moveList(std::make_shared<MoveList>());
-    MoveGen::pseudoLegalMoves(pos, *moveList);
-    MoveGen::removeIllegal(pos, *moveList);
+    MoveGen::legalMoves(pos, *moveList);
     sc->timeLimit(-1, -1);
     int minProbeDepth = UciParams::minProbeDepth->getIntPar();
     auto f = [this,moveList,minProbeDepth]() {
@@ -1030,8 +1030,7 @@ BookGui::queueRowActivated(const Gtk::TreeModel::Path& path,
 void
 BookGui::chessBoardMoveMade(const Move& move) {
     MoveList moveList;
-    MoveGen::pseudoLegalMoves(pos, moveList);
-    MoveGen::removeIllegal(pos, moveList);
+    MoveGen::legalMoves(pos, moveList);
     auto performMove = [this](const Move& move){
         Position newPos = pos;
         UndoInfo ui;
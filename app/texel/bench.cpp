@@ -0,0 +1,171 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * bench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "bench.hpp"
+#include "search.hpp"
+#include "parallel.hpp"
+#include "transpositionTable.hpp"
+#include "killerTable.hpp"
+#include "history.hpp"
+#include "evaluate.hpp"
+#include "treeLogger.hpp"
+#include "moveGen.hpp"
+#include "textio.hpp"
+#include "computerPlayer.hpp"
+#include "util/timeUtil.hpp"
+
+#include <iostream>
+#include <iomanip>
+
+
+const char* Bench::fens[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 10",
+    "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+    "rq3rk1/ppp2ppp/1bnpb3/3N2B1/3NP3/7P/PPPQ1PP1/2KR3R w - - 7 14",
+    "r1bq1r1k/1pp1n1pp/1p1p4/4p2Q/4Pp2/1BNP4/PPP2PPP/3R1RK1 w - - 2 14",
+    "r3r1k1/2p2ppp/p1p1bn2/8/1q2P3/2NPQN2/PPP3PP/R4RK1 b - - 2 15",
+    "r1bbk1nr/pp3p1p/2n5/1N4p1/2Np1B2/8/PPP2PPP/2KR1B1R w kq - 0 13",
+    "r1bq1rk1/ppp1nppp/4n3/3p3Q/3P4/1BP1B3/PP1N2PP/R4RK1 w - - 1 16",
+    "4r1k1/r1q2ppp/ppp2n2/4P3/5Rb1/1N1BQ3/PPP3PP/R5K1 w - - 1 17",
+    "2rqkb1r/ppp2p2/2npb1p1/1N1Nn2p/2P1PP2/8/PP2B1PP/R1BQK2R b KQ - 0 11",
+    "r1bq1r1k/b1p1npp1/p2p3p/1p6/3PP3/1B2NN2/PP3PPP/R2Q1RK1 w - - 1 16",
+    "3r1rk1/p5pp/bpp1pp2/8/q1PP1P2/b3P3/P2NQRPP/1R2B1K1 b - - 6 22",
+    "r1q2rk1/2p1bppp/2Pp4/p6b/Q1PNp3/4B3/PP1R1PPP/2K4R w - - 2 18",
+    "4k2r/1pb2ppp/1p2p3/1R1p4/3P4/2r1PN2/P4PPP/1R4K1 b - - 3 22",
+    "3q2k1/pb3p1p/4pbp1/2r5/PpN2N2/1P2P2P/5PP1/Q2R2K1 b - - 4 26",
+    "r1bqk2r/pp2bppp/2nppn2/8/3NP3/2N1B3/PPP1BPPP/R2QK2R w KQkq - 2 8",
+    "r2q1rk1/pb2bppp/1pn1pn2/2pp4/3P4/1PNBPN2/PB3PPP/R2Q1RK1 w - - 2 10",
+    "2r2rk1/1bqnbppp/p2ppn2/1p6/3NP3/1BN1BP2/PPPQ2PP/2KR3R w - - 4 13",
+    "r1b2rk1/2q1bppp/p2ppn2/1p6/3BPP2/2NB4/PPP3PP/R2Q1R1K w - - 0 13",
+    "r4rk1/1b2qppp/p3pn2/1pb5/3N4/1BN1P3/PP3PPP/R2Q1RK1 w - - 1 14",
+    "2kr3r/ppp1qppp/2n1bn2/4p3/2B1P3/2NP1N2/PPP2PPP/R2Q1RK1 w - - 5 10",
+    "6k1/6p1/6Pp/ppp5/3pn2P/1P3K2/1PP2P2/3N4 b - - 0 1",
+    "3b4/5kp1/1p1p1p1p/pP1PpP1P/P1P1P3/3KN3/8/8 w - - 0 1",
+    "2K5/p7/7P/5pR1/8/5k2/r7/8 w - - 0 1",
+    "8/6pk/1p6/8/PP3p1p/5P2/4KP1q/3Q4 w - - 0 1",
+    "7k/3p2pp/4q3/8/4Q3/5Kp1/P6b/8 w - - 0 1",
+    "8/2p5/8/2kPKp1p/2p4P/2P5/3P4/8 w - - 0 1",
+    "8/1p3pp1/7p/5P1P/2k3P1/8/2K2P2/8 w - - 0 1",
+    "8/pp2r1k1/2p1p3/3pP2p/1P1P1P1P/P5KR/8/8 w - - 0 1",
+    "8/3p4/p1bk3p/Pp6/1Kp1PpPp/2P2P1P/2P5/5B2 b - - 0 1",
+    "5k2/7R/4P2p/5K2/p1r2P1p/8/8/8 b - - 0 1",
+    "6k1/6p1/P6p/r1N5/5p2/7P/1b3PP1/4R1K1 w - - 0 1",
+    "1r3k2/4q3/2Pp3b/3Bp3/2Q2p2/1p1P2P1/1P2KP2/3N4 w - - 0 1",
+    "6k1/4pp1p/3p2p1/P1pPb3/R7/1r2P1PP/3B1P2/6K1 w - - 0 1",
+    "8/3p3B/5p2/5P2/p7/PP5b/k7/6K1 w - - 0 1",
+    "8/8/8/8/5kp1/P7/8/1K1N4 w - - 0 1",
+    "8/8/8/5N2/8/p7/8/2NK3k w - - 0 1",
+    "8/3k4/8/8/8/4B3/4KB2/2B5 w - - 0 1",
+    "8/8/1P6/5pr1/8/4R3/7k/2K5 w - - 0 1",
+    "8/2p4P/8/kr6/6R1/8/8/1K6 w - - 0 1",
+    "8/8/3P3k/8/1p6/8/1P6/1K3n2 b - - 0 1",
+    "8/R7/2q5/8/6k1/8/1P5p/K6R w - - 0 124",
+};
+
+bool
+Bench::main(const std::vector<std::string>& args, std::ostream& os) {
+    int hashMB = defaultHashMB;
+    int nThreads = defaultThreads;
+    int depth = defaultDepth;
+    if (args.size() > 3)
+        return false;
+    if ((args.size() > 0) && (!str2Num(args[0], hashMB) || hashMB < 1))
+        return false;
+    if ((args.size() > 1) && (!str2Num(args[1], nThreads) || nThreads < 1))
+        return false;
+    if ((args.size() > 2) && (!str2Num(args[2], depth) || depth < 1))
+        return false;
+    run(hashMB, nThreads, depth, os);
+    return true;
+}
+
+S64
+Bench::run(int hashMB, int nThreads, int depth, std::ostream& os) {
+    TranspositionTable tt(((U64)hashMB) * (1 << 20) / sizeof(TranspositionTable::TTEntry));
+    Notifier notifier;
+    ThreadCommunicator comm(nullptr, tt, notifier, false);
+    std::vector<std::shared_ptr<WorkerThread>> children;
+    WorkerThread::createWorkers(1, &comm, nThreads - 1, tt, children);
+
+    KillerTable kt;
+    History ht;
+    auto et = Evaluate::getEvalHashTables();
+    TreeLogger treeLog;
+    std::vector<U64> posHashList(SearchConst::MAX_SEARCH_DEPTH * 2);
+
+    class Handler : public Communicator::CommandHandler {
+    public:
+        explicit Handler(Communicator& comm) : comm(comm) {}
+        void stopAck() override { comm.sendStopAck(true); }
+    private:
+        Communicator& comm;
+    };
+    Handler handler(comm);
+
+    const int nPos = COUNT_OF(fens);
+    S64 totNodes = 0;
+    S64 t0 = currentTimeMillis();
+    for (int i = 0; i < nPos; i++) {
+        Position pos = TextIO::readFEN(fens[i]);
+        tt.clear();
+        ht.init();
+        Search::SearchTables st(comm.getCTT(), kt, ht, *et);
+        Search sc(pos, posHashList, 0, st, comm, treeLog);
+
+        MoveList moves;
+        MoveGen::legalMoves(pos, moves);
+        sc.scoreMoveList(moves, 0);
+        Move bestM = sc.iterativeDeepening(moves, depth, -1, 1, false, 0, true);
+
+        comm.sendStopSearch();
+        comm.sendStopAck(false);
+        while (!comm.hasStopAck()) {
+            comm.poll(handler);
+            if (!comm.hasStopAck())
+                notifier.wait();
+        }
+
+        S64 nodes = sc.getTotalNodesThisThread() + comm.getNumSearchedNodes();
+        totNodes += nodes;
+        os << "Position " << std::setw(2) << (i+1) << '/' << nPos
+           << " bestmove " << TextIO::moveToUCIString(bestM)
+           << " nodes " << nodes << std::endl;
+    }
+    S64 t1 = currentTimeMillis();
+    S64 elapsed = std::max(t1 - t0, (S64)1);
+
+    os << "===========================" << std::endl;
+    os << "Engine     : " << ComputerPlayer::engineName << std::endl;
+    os << "Build      : " << ComputerPlayer::buildOptions() << std::endl;
+    os << "Hash (MB)  : " << hashMB << std::endl;
+    os << "Threads    : " << nThreads << std::endl;
+    os << "Depth      : " << depth << std::endl;
+    os << "Total time : " << elapsed << " ms" << std::endl;
+    os << "Nodes      : " << totNodes << std::endl;
+    os << "Nodes/sec  : " << totNodes * 1000 / elapsed << std::endl;
+    os << "Signature  : " << totNodes << (nThreads > 1 ? " (not deterministic)" : "") << std::endl;
+    return totNodes;
+}
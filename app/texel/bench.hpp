@@ -0,0 +1,58 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * bench.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef BENCH_HPP_
+#define BENCH_HPP_
+
+#include "util/util.hpp"
+
+#include <vector>
+#include <string>
+#include <iosfwd>
+
+/**
+ * Fixed depth search of a built-in set of test positions. Used to measure
+ * engine speed and to detect unintended changes to the search tree.
+ */
+class Bench {
+public:
+    static const int defaultHashMB = 16;
+    static const int defaultThreads = 1;
+    static const int defaultDepth = 12;
+
+    /** Parse optional "[hashMB [threads [depth]]]" arguments and run the benchmark.
+     *  @return False if the arguments could not be parsed. */
+    static bool main(const std::vector<std::string>& args, std::ostream& os);
+
+    /** Search all test positions to a fixed depth and print the result to os.
+     *  The node count signature is only deterministic when nThreads is 1.
+     *  @return The total number of searched nodes. */
+    static S64 run(int hashMB, int nThreads, int depth, std::ostream& os);
+
+private:
+    static const char* fens[];
+};
+
+#endif /* BENCH_HPP_ */
@@ -244,10 +244,20 @@ EngineMainThread::doSearch() {
                 break;
             notifierWait();
         }
+        {
+            std::lock_guard<std::mutex> L(mutex);
+            lastSearchStats = sc->getSearchStats();
+        }
         notifier.notify();
     }
 }
 
+SearchStats
+EngineMainThread::getLastSearchStats() {
+    std::lock_guard<std::mutex> L(mutex);
+    return lastSearchStats;
+}
+
 void
 EngineMainThread::setOptions() {
     while (true) {
@@ -322,6 +332,7 @@ EngineControl::startPonder(const Position& pos, const std::vector<Move>& moves,
     stopThread();
     setupPosition(pos, moves);
     computeTimeLimit(sPar);
+    logTime = false;
     ponder = true;
     infinite = false;
     startThread(-1, -1, -1, -1, -1);
@@ -358,6 +369,7 @@ EngineControl::computeTimeLimit(const SearchParams& sPar) {
     earlyStopPercentage = -1;
     maxDepth = -1;
     maxNodes = -1;
+    logTime = false;
     if (sPar.infinite) {
         minTimeLimit = -1;
         maxTimeLimit = -1;
@@ -398,6 +410,15 @@ EngineControl::computeTimeLimit(const SearchParams& sPar) {
             // Leave at least 1s on the clock, but can't use negative time
             minTimeLimit = clamp(minTimeLimit, 1, time - margin);
             maxTimeLimit = clamp(maxTimeLimit, 1, time - margin);
+
+            logTime = !UciParams::timeLogFile->getStringPar().empty();
+            timeLogEntry = TimeLog::Entry();
+            timeLogEntry.timeLeft = time;
+            timeLogEntry.increment = inc;
+            timeLogEntry.movesToGo = sPar.movesToGo;
+            timeLogEntry.minTimeLimit = minTimeLimit;
+            timeLogEntry.maxTimeLimit = maxTimeLimit;
+            timeLogEntry.earlyStopPercentage = minTimeUsage;
         }
     }
 }
@@ -450,18 +471,19 @@ void
 EngineControl::startThread(int minTimeLimit, int maxTimeLimit, int earlyStopPercentage,
                            int maxDepth, int maxNodes) {
     Communicator* comm = engineThread.getCommunicator();
+    et->updateSize();
     Search::SearchTables st(comm->getCTT(), kt, ht, *et);
     sc = std::make_shared<Search>(pos, posHashList, posHashListSize, st, *comm, treeLog);
     sc->setListener(listener);
     sc->setStrength(getStrength(), randomSeed, getMaxNPS());
     std::shared_ptr<MoveList> moves(std::make_shared<MoveList>());
-    MoveGen::pseudoLegalMoves(pos, *moves);
-    MoveGen::removeIllegal(pos, *moves);
+    MoveGen::legalMoves(pos, *moves);
     if (searchMoves.size() > 0)
         moves->filter(searchMoves);
     onePossibleMove = false;
     if ((moves->size < 2) && !infinite) {
         onePossibleMove = true;
+        logTime = false;
         if (!ponder) {
             if (maxTimeLimit > 0) {
                 maxTimeLimit = clamp(maxTimeLimit/100, 1, 100);
@@ -539,8 +561,7 @@ EngineControl::getPonderMove(Position pos, const Move& m) {
     if (ent.getType() != TType::T_EMPTY) {
         ent.getMove(ret);
         MoveList moves;
-        MoveGen::pseudoLegalMoves(pos, moves);
-        MoveGen::removeIllegal(pos, moves);
+        MoveGen::legalMoves(pos, moves);
         bool contains = false;
         for (int mi = 0; mi < moves.size; mi++)
             if (moves[mi] == ret) {
@@ -608,10 +629,24 @@ EngineControl::waitReady() {
 
 void
 EngineControl::finishSearch(Position& pos, const Move& bestMove) {
+    if (SearchStats::enabled && sc)
+        sc->getSearchStats().print(os);
+    if (logTime && sc) {
+        sc->getTimeLogEntry(timeLogEntry);
+        if (!timeLogEntry.iterations.empty()) {
+            timeLogEntry.hashKey = pos.zobristHash();
+            TimeLog::appendToFile(UciParams::timeLogFile->getStringPar(), timeLogEntry);
+        }
+    }
     Move ponderMove = getPonderMove(pos, bestMove);
     listener.notifyPlayedMove(bestMove, ponderMove);
 }
 
+void
+EngineControl::printSearchStats(std::ostream& os) {
+    engineThread.getLastSearchStats().print(os);
+}
+
 static int eloToStrength[][2] = {
     {  -625,   0 },
     {  -574,  15 },
@@ -32,6 +32,7 @@
 #include "parallel.hpp"
 #include "history.hpp"
 #include "killerTable.hpp"
+#include "timeLog.hpp"
 
 #include <vector>
 #include <map>
@@ -89,6 +90,9 @@ public:
     /** Clear history tables in all helper threads when starting next search. */
     void setClearHistory();
 
+    /** Get search statistics for all threads from the last completed search. */
+    SearchStats getLastSearchStats();
+
 private:
     void doSearch();
     void setOptions();
@@ -124,6 +128,8 @@ private:
 
     std::map<std::string, std::string> pendingOptions;
     bool optionsSetFinished = true;
+
+    SearchStats lastSearchStats; // Protected by mutex
 };
 
 /**
@@ -153,6 +159,9 @@ public:
 
     void finishSearch(Position& pos, const Move& bestMove);
 
+    /** Print search statistics from the last completed search. */
+    void printSearchStats(std::ostream& os);
+
 private:
     /** Compute thinking time for current search. */
     void computeTimeLimit(const SearchParams& sPar);
@@ -209,6 +218,9 @@ private:
     int maxNodes;
     std::vector<Move> searchMoves;
 
+    bool logTime = false;         // True if current search should be written to the time log
+    TimeLog::Entry timeLogEntry;  // Clock information for current search
+
     // Random seed for reduced strength
     U64 randomSeed;
 };
@@ -28,10 +28,12 @@
 #include "tuigame.hpp"
 #include "treeLogger.hpp"
 #include "uciprotocol.hpp"
+#include "bench.hpp"
 #include "numa.hpp"
 #include "cluster.hpp"
 
 #include <memory>
+#include <iostream>
 
 /** Texel chess engine main function. */
 int main(int argc, char* argv[]) {
@@ -45,6 +47,13 @@ int main(int argc, char* argv[]) {
         game.play();
     } else if ((argc == 3) && (std::string(argv[1]) == "tree")) {
         TreeLoggerReader::main(argv[2]);
+    } else if ((argc >= 2) && (std::string(argv[1]) == "bench")) {
+        std::vector<std::string> args(argv + 2, argv + argc);
+        if (!Bench::main(args, std::cout)) {
+            std::cerr << "Usage: texel bench [hashMB [threads [depth]]]" << std::endl;
+            Cluster::instance().finalize();
+            return 2;
+        }
     } else {
         if ((argc == 2) && (std::string(argv[1]) == "-nonuma"))
             Numa::instance().disable();
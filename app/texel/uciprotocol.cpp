@@ -29,6 +29,8 @@
 #include "textio.hpp"
 #include "util/logger.hpp"
 #include "cluster.hpp"
+#include "bench.hpp"
+#include "tbStats.hpp"
 
 #include <iostream>
 
@@ -287,6 +289,20 @@ UCIProtocol::handleCommand(const std::string& cmdLine, std::ostream& os) {
                 engine->stopSearch();
         } else if (cmd == "ponderhit") {
             engine->ponderHit();
+        } else if (cmd == "bench") {
+            if (engine)
+                engine->stopSearch();
+            std::vector<std::string> args(tokens.begin() + 1, tokens.end());
+            if (!Bench::main(args, os))
+                os << "info string Usage: bench [hashMB [threads [depth]]]" << std::endl;
+        } else if (cmd == "stats") {
+            initEngine(os);
+            engine->printSearchStats(os);
+        } else if (cmd == "tbstats") {
+            if ((nTok > 1) && (tokens[1] == "clear"))
+                TBStats::clear();
+            else
+                TBStats::print(os);
         } else if (cmd == "quit") {
             if (engine)
                 engine->stopSearch();
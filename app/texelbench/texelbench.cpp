@@ -0,0 +1,553 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * texelbench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "bitBoard.hpp"
+#include "moveGen.hpp"
+#include "position.hpp"
+#include "search.hpp"
+#include "evaluate.hpp"
+#include "nnue.hpp"
+#include "transpositionTable.hpp"
+#include "textio.hpp"
+#include "computerPlayer.hpp"
+#include "constants.hpp"
+#include "util/timeUtil.hpp"
+#include "util/random.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <functional>
+
+
+/** Micro benchmarks for performance critical engine functions. Each benchmark
+ *  is timed a number of times and the time per operation is reported. */
+class MicroBench {
+public:
+    MicroBench(int nSamples, int ttSizeMB);
+
+    /** Run all benchmarks. */
+    void run();
+
+    /** Print results as human readable text. */
+    void printText(std::ostream& os) const;
+
+    /** Print results as a JSON object. */
+    void printJson(std::ostream& os) const;
+
+private:
+    /** Time "func", which performs nOps operations, nSamples times.
+     *  "setup" is called before each sample and is not included in the time. */
+    void measure(const std::string& name, int nOps,
+                 const std::function<void()>& setup,
+                 const std::function<void()>& func);
+    void measure(const std::string& name, int nOps,
+                 const std::function<void()>& func);
+
+    void benchSliders();
+    void benchMoveGen();
+    void benchMakeMove();
+    void benchSEE();
+    void benchEval();
+    void benchNNUE();
+    void benchTT();
+    void benchTextIO();
+
+    struct Result {
+        std::string name;
+        int nOps;
+        TimeSampleStatistics stat;
+    };
+
+    const int nSamples;
+    const int ttSizeMB;
+    std::vector<Result> results;
+
+    std::vector<Position> positions;        // Test positions not in check
+    std::vector<Position> inCheckPositions; // Test positions in check
+
+    volatile U64 sink = 0; // Prevents the compiler from optimizing away benchmarked code
+};
+
+static const char* baseFens[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 10",
+    "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+    "r1bq1r1k/1pp1n1pp/1p1p4/4p2Q/4Pp2/1BNP4/PPP2PPP/3R1RK1 w - - 2 14",
+    "2rqkb1r/ppp2p2/2npb1p1/1N1Nn2p/2P1PP2/8/PP2B1PP/R1BQK2R b KQ - 0 11",
+    "r1q2rk1/2p1bppp/2Pp4/p6b/Q1PNp3/4B3/PP1R1PPP/2K4R w - - 2 18",
+    "3q2k1/pb3p1p/4pbp1/2r5/PpN2N2/1P2P2P/5PP1/Q2R2K1 b - - 4 26",
+    "8/pp2r1k1/2p1p3/3pP2p/1P1P1P1P/P5KR/8/8 w - - 0 1",
+    "6k1/6p1/P6p/r1N5/5p2/7P/1b3PP1/4R1K1 w - - 0 1",
+    "1r3k2/4q3/2Pp3b/3Bp3/2Q2p2/1p1P2P1/1P2KP2/3N4 w - - 0 1",
+};
+
+MicroBench::MicroBench(int nSamples, int ttSizeMB)
+    : nSamples(nSamples), ttSizeMB(ttSizeMB) {
+    // Use the base positions and all positions reachable in one or two plies
+    for (const char* fen : baseFens) {
+        Position pos = TextIO::readFEN(fen);
+        positions.push_back(pos);
+        MoveList moves;
+        MoveGen::legalMoves(pos, moves);
+        UndoInfo ui, ui2;
+        for (int i = 0; i < moves.size; i++) {
+            pos.makeMove(moves[i], ui);
+            std::vector<Position>& v = MoveGen::inCheck(pos) ? inCheckPositions : positions;
+            v.push_back(pos);
+            MoveList moves2;
+            MoveGen::legalMoves(pos, moves2);
+            for (int j = 0; j < moves2.size; j += 5) {
+                pos.makeMove(moves2[j], ui2);
+                std::vector<Position>& v2 = MoveGen::inCheck(pos) ? inCheckPositions : positions;
+                v2.push_back(pos);
+                pos.unMakeMove(moves2[j], ui2);
+            }
+            pos.unMakeMove(moves[i], ui);
+        }
+    }
+}
+
+void
+MicroBench::measure(const std::string& name, int nOps,
+                    const std::function<void()>& setup,
+                    const std::function<void()>& func) {
+    Result r;
+    r.name = name;
+    r.nOps = std::max(nOps, 1);
+    setup();
+    func(); // Warm up caches and branch predictors
+    for (int i = 0; i < nSamples; i++) {
+        setup();
+        ScopedTimeSample sts(r.stat);
+        func();
+    }
+    results.push_back(r);
+}
+
+void
+MicroBench::measure(const std::string& name, int nOps,
+                    const std::function<void()>& func) {
+    measure(name, nOps, [](){}, func);
+}
+
+void
+MicroBench::run() {
+    benchSliders();
+    benchMoveGen();
+    benchMakeMove();
+    benchSEE();
+    benchEval();
+    benchNNUE();
+    benchTT();
+    benchTextIO();
+}
+
+void
+MicroBench::benchSliders() {
+    const int N = 1 << 16;
+    Random rnd(17);
+    std::vector<int> squares(N);
+    std::vector<U64> occupied(N);
+    for (int i = 0; i < N; i++) {
+        const Position& pos = positions[rnd.nextInt(positions.size())];
+        squares[i] = rnd.nextInt(64);
+        occupied[i] = pos.occupiedBB();
+    }
+#ifdef COMPACT_ATTACKS
+    const std::string variant = BitBoard::pextAttacks() ? " (compact pext)" : " (compact magic)";
+#else
+    const std::string variant = BitBoard::pextAttacks() ? " (pext)" : " (magic)";
+#endif
+    measure("bishopAttacks" + variant, N, [&]() {
+        U64 s = 0;
+        for (int i = 0; i < N; i++)
+            s += BitBoard::bishopAttacks(squares[i], occupied[i]);
+        sink += s;
+    });
+    measure("rookAttacks" + variant, N, [&]() {
+        U64 s = 0;
+        for (int i = 0; i < N; i++)
+            s += BitBoard::rookAttacks(squares[i], occupied[i]);
+        sink += s;
+    });
+}
+
+void
+MicroBench::benchMoveGen() {
+    MoveList moves;
+    measure("pseudoLegalMoves", positions.size(), [&]() {
+        for (const Position& pos : positions) {
+            moves.clear();
+            MoveGen::pseudoLegalMoves(pos, moves);
+            sink += moves.size;
+        }
+    });
+    measure("pseudoLegal+removeIllegal", positions.size(), [&]() {
+        for (Position& pos : positions) {
+            moves.clear();
+            MoveGen::pseudoLegalMoves(pos, moves);
+            MoveGen::removeIllegal(pos, moves);
+            sink += moves.size;
+        }
+    });
+    measure("legalMoves", positions.size(), [&]() {
+        for (const Position& pos : positions) {
+            moves.clear();
+            MoveGen::legalMoves(pos, moves);
+            sink += moves.size;
+        }
+    });
+    measure("checkEvasions", inCheckPositions.size(), [&]() {
+        for (const Position& pos : inCheckPositions) {
+            moves.clear();
+            MoveGen::checkEvasions(pos, moves);
+            sink += moves.size;
+        }
+    });
+    measure("pseudoLegalCaptures", positions.size(), [&]() {
+        for (const Position& pos : positions) {
+            moves.clear();
+            MoveGen::pseudoLegalCaptures(pos, moves);
+            sink += moves.size;
+        }
+    });
+}
+
+void
+MicroBench::benchMakeMove() {
+    std::vector<std::pair<Position,MoveList>> data;
+    int nMoves = 0;
+    for (Position pos : positions) {
+        MoveList moves;
+        MoveGen::legalMoves(pos, moves);
+        nMoves += moves.size;
+        data.push_back(std::make_pair(pos, moves));
+    }
+    measure("makeMove+unMakeMove", nMoves, [&]() {
+        UndoInfo ui;
+        for (auto& d : data) {
+            Position& pos = d.first;
+            const MoveList& moves = d.second;
+            for (int i = 0; i < moves.size; i++) {
+                pos.makeMove(moves[i], ui);
+                sink += pos.zobristHash();
+                pos.unMakeMove(moves[i], ui);
+            }
+        }
+    });
+}
+
+void
+MicroBench::benchSEE() {
+    std::vector<std::pair<Position,MoveList>> data;
+    int nMoves = 0;
+    for (Position pos : positions) {
+        MoveList moves;
+        MoveGen::pseudoLegalCaptures(pos, moves);
+        MoveGen::removeIllegal(pos, moves);
+        nMoves += moves.size;
+        data.push_back(std::make_pair(pos, moves));
+    }
+    measure("SEE", nMoves, [&]() {
+        for (auto& d : data) {
+            Position& pos = d.first;
+            const MoveList& moves = d.second;
+            for (int i = 0; i < moves.size; i++)
+                sink += Search::SEE(pos, moves[i], -SearchConst::MATE0, SearchConst::MATE0);
+        }
+    });
+}
+
+void
+MicroBench::benchEval() {
+    std::unique_ptr<Evaluate::EvalHashTables> et;
+    std::unique_ptr<Evaluate> eval;
+    auto newTables = [&]() {
+        eval.reset();
+        et = Evaluate::getEvalHashTables();
+        eval = make_unique<Evaluate>(*et);
+    };
+    auto evalAll = [&]() {
+        for (const Position& pos : positions)
+            sink += eval->evalPos(pos);
+    };
+    measure("evalPos (cold hash)", positions.size(), newTables, evalAll);
+    newTables();
+    measure("evalPos (warm hash)", positions.size(), evalAll);
+    measure("evalPos (lazy, cold hash)", positions.size(), newTables, [&]() {
+        for (const Position& pos : positions)
+            sink += eval->evalPos(pos, -1, 1);
+    });
+
+    std::vector<Position::SerializeData> data(positions.size());
+    for (size_t i = 0; i < positions.size(); i++)
+        positions[i].serialize(data[i]);
+    std::vector<int> scores(data.size());
+    measure("evalBatch (cold)", data.size(), newTables, [&]() {
+        eval->evalBatch(&data[0], data.size(), &scores[0]);
+        sink += scores[0];
+    });
+    measure("deSerialize+evalPos (cold)", data.size(), newTables, [&]() {
+        Position pos;
+        for (const Position::SerializeData& d : data) {
+            pos.deSerialize(d);
+            sink += eval->evalPos(pos);
+        }
+    });
+}
+
+void
+MicroBench::benchNNUE() {
+    std::string errMsg;
+    if (!NNUE::setNetwork(NNUE::randomNetwork(1), errMsg))
+        return;
+
+    std::vector<NNUE::Accumulator> accs(positions.size());
+    measure("NNUE refresh", positions.size(), [&]() {
+        for (size_t i = 0; i < positions.size(); i++)
+            NNUE::refresh(positions[i], accs[i]);
+    });
+    measure("NNUE evaluate", positions.size(), [&]() {
+        for (size_t i = 0; i < positions.size(); i++)
+            sink += NNUE::evaluate(accs[i], positions[i].isWhiteMove());
+    });
+    measure("NNUE evaluate (scalar)", positions.size(), [&]() {
+        for (size_t i = 0; i < positions.size(); i++)
+            sink += NNUE::evaluateScalar(accs[i], positions[i].isWhiteMove());
+    });
+
+#ifdef HAS_NNUE
+    NNUE::setEnabled(true);
+    std::vector<std::pair<Position,MoveList>> data;
+    int nMoves = 0;
+    for (const Position& p : positions) {
+        Position pos(p);
+        MoveList moves;
+        MoveGen::legalMoves(pos, moves);
+        nMoves += moves.size;
+        data.push_back(std::make_pair(pos, moves));
+    }
+    NNUE::AccumulatorStack stack;
+    measure("make+get+unmake (NNUE)", nMoves, [&]() {
+        UndoInfo ui;
+        for (auto& d : data) {
+            Position& pos = d.first;
+            const MoveList& moves = d.second;
+            stack.get(pos);
+            for (int i = 0; i < moves.size; i++) {
+                stack.push(pos, moves[i]);
+                pos.makeMove(moves[i], ui);
+                stack.setKey(pos.zobristHash());
+                sink += stack.get(pos).acc[0][0];
+                pos.unMakeMove(moves[i], ui);
+                stack.pop();
+            }
+        }
+    });
+
+    std::unique_ptr<Evaluate::EvalHashTables> et;
+    std::unique_ptr<Evaluate> eval;
+    auto newTables = [&]() {
+        eval.reset();
+        et = Evaluate::getEvalHashTables();
+        eval = make_unique<Evaluate>(*et);
+    };
+    measure("evalPos (NNUE, cold hash)", data.size(), newTables, [&]() {
+        for (const auto& d : data)
+            sink += eval->evalPos(d.first);
+    });
+    NNUE::setEnabled(false);
+#else
+    std::vector<std::pair<int,Move>> moves; // (position index, move)
+    for (size_t i = 0; i < positions.size(); i++) {
+        MoveList ml;
+        MoveGen::legalMoves(positions[i], ml);
+        for (int j = 0; j < ml.size; j++)
+            moves.push_back(std::make_pair((int)i, ml[j]));
+    }
+    measure("NNUE movePiece x2", moves.size(), [&]() {
+        for (const auto& pm : moves) {
+            NNUE::Accumulator& acc = accs[pm.first];
+            const Move& m = pm.second;
+            int p = positions[pm.first].getPiece(m.from());
+            NNUE::movePiece(acc, p, m.from(), m.to());
+            NNUE::movePiece(acc, p, m.to(), m.from());
+        }
+        sink += accs[0].acc[0][0];
+    });
+#endif
+
+    NNUE::loadNetwork("", errMsg);
+}
+
+void
+MicroBench::benchTT() {
+    U64 nEntries = (U64)ttSizeMB * (1 << 20) / sizeof(TranspositionTable::TTEntry);
+    TranspositionTable tt(nEntries);
+    const int N = 1 << 16;
+    Random rnd(4711);
+    std::vector<U64> keys(N), missKeys(N);
+    for (int i = 0; i < N; i++) {
+        keys[i] = rnd.nextU64();
+        missKeys[i] = rnd.nextU64();
+    }
+    Move m(E2, E4, Piece::EMPTY);
+    int depth = 0;
+    measure("TT insert (" + num2Str(ttSizeMB) + "MB)", N, [&]() {
+        for (int i = 0; i < N; i++)
+            tt.insert(keys[i], m, TType::T_EXACT, 0, ++depth & 63, 17);
+    });
+    TranspositionTable::TTEntry ent;
+    measure("TT probe hit (" + num2Str(ttSizeMB) + "MB)", N, [&]() {
+        for (int i = 0; i < N; i++) {
+            tt.probe(keys[i], ent);
+            sink += ent.getType();
+        }
+    });
+    measure("TT probe miss (" + num2Str(ttSizeMB) + "MB)", N, [&]() {
+        for (int i = 0; i < N; i++) {
+            tt.probe(missKeys[i], ent);
+            sink += ent.getType();
+        }
+    });
+}
+
+void
+MicroBench::benchTextIO() {
+    std::vector<std::string> fens;
+    for (const Position& pos : positions)
+        fens.push_back(TextIO::toFEN(pos));
+    measure("readFEN", fens.size(), [&]() {
+        for (const std::string& fen : fens)
+            sink += TextIO::readFEN(fen).zobristHash();
+    });
+    measure("toFEN", positions.size(), [&]() {
+        for (const Position& pos : positions)
+            sink += TextIO::toFEN(pos).length();
+    });
+    measure("readFEN (buffer)", fens.size(), [&]() {
+        Position pos;
+        for (const std::string& fen : fens) {
+            TextIO::readFEN(fen.data(), fen.length(), pos);
+            sink += pos.zobristHash();
+        }
+    });
+    measure("toFEN (buffer)", positions.size(), [&]() {
+        char buf[TextIO::MAX_FEN_LEN];
+        for (const Position& pos : positions)
+            sink += TextIO::toFEN(pos, buf);
+    });
+
+    std::vector<std::pair<Position,std::vector<std::string>>> sanData;
+    int nMoves = 0;
+    for (size_t i = 0; i < positions.size(); i += 10) {
+        const Position& pos = positions[i];
+        MoveList moves;
+        MoveGen::legalMoves(pos, moves);
+        std::vector<std::string> strMoves;
+        for (int j = 0; j < moves.size; j++)
+            strMoves.push_back(TextIO::moveToString(pos, moves[j], false));
+        nMoves += moves.size;
+        sanData.push_back(std::make_pair(pos, strMoves));
+    }
+    measure("stringToMove (SAN)", nMoves, [&]() {
+        for (auto& d : sanData) {
+            Position& pos = d.first;
+            for (const std::string& s : d.second)
+                sink += TextIO::stringToMove(pos, s).from();
+        }
+    });
+}
+
+void
+MicroBench::printText(std::ostream& os) const {
+    os << ComputerPlayer::engineName << " micro benchmarks, "
+       << nSamples << " samples" << std::endl;
+    os << std::left << std::setw(30) << "operation" << std::right
+       << std::setw(12) << "ns/op" << std::setw(12) << "std" << std::endl;
+    os << std::fixed << std::setprecision(2);
+    for (const Result& r : results) {
+        os << std::left << std::setw(30) << r.name << std::right
+           << std::setw(12) << r.stat.avg() * 1e9 / r.nOps
+           << std::setw(12) << r.stat.std() * 1e9 / r.nOps << std::endl;
+    }
+}
+
+void
+MicroBench::printJson(std::ostream& os) const {
+    os << "{\"engine\":\"" << ComputerPlayer::engineName << "\","
+       << "\"samples\":" << nSamples << ",\"results\":[";
+    os << std::fixed << std::setprecision(3);
+    bool first = true;
+    for (const Result& r : results) {
+        if (!first)
+            os << ',';
+        first = false;
+        os << "\n {\"name\":\"" << r.name << "\""
+           << ",\"opsPerSample\":" << r.nOps
+           << ",\"nsPerOp\":" << r.stat.avg() * 1e9 / r.nOps
+           << ",\"stdNs\":" << r.stat.std() * 1e9 / r.nOps << "}";
+    }
+    os << "\n]}" << std::endl;
+}
+
+static void
+usage() {
+    std::cerr << "Usage: texelbench [-json] [-n samples] [-tt sizeMB]\n";
+    std::cerr << " -json : Print results in JSON format\n";
+    std::cerr << " -n    : Number of time samples for each benchmark, default 20\n";
+    std::cerr << " -tt   : Transposition table size in MB, default 256\n";
+    std::cerr << std::flush;
+    ::exit(2);
+}
+
+int
+main(int argc, char* argv[]) {
+    bool json = false;
+    int nSamples = 20;
+    int ttSizeMB = 256;
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+        if (arg == "-json") {
+            json = true;
+        } else if ((arg == "-n") && (i + 1 < argc)) {
+            if (!str2Num(argv[++i], nSamples) || nSamples < 2)
+                usage();
+        } else if ((arg == "-tt") && (i + 1 < argc)) {
+            if (!str2Num(argv[++i], ttSizeMB) || ttSizeMB < 1)
+                usage();
+        } else
+            usage();
+    }
+
+    ComputerPlayer::initEngine();
+    MicroBench mb(nSamples, ttSizeMB);
+    mb.run();
+    if (json)
+        mb.printJson(std::cout);
+    else
+        mb.printText(std::cout);
+    return 0;
+}
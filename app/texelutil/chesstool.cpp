@@ -169,6 +169,7 @@ ChessTool::pgnToFen(std::istream& is, int everyNth) {
     static auto et = Evaluate::getEvalHashTables();
     static Search::SearchTables st(comm.getCTT(), kt, ht, *et);
     static TreeLogger treeLog;
+    et->updateSize();
     Random rnd;
 
     Position pos;
@@ -472,6 +473,30 @@ ChessTool::outliers(std::istream& is, int threshold) {
     std::cout << std::flush;
 }
 
+void
+ChessTool::nnueData(std::istream& is, const std::string& outFile) {
+    std::vector<PositionInfo> positions;
+    readFENFile(is, positions);
+    std::ofstream os(outFile, std::ios::binary);
+    if (!os)
+        throw ChessParseError("Cannot create file: " + outFile);
+    Position pos;
+    U8 rec[36];
+    for (const PositionInfo& pi : positions) {
+        pos.deSerialize(pi.posData);
+        for (int i = 0; i < 32; i++)
+            rec[i] = pos.getPiece(2*i) | (pos.getPiece(2*i+1) << 4);
+        rec[32] = pos.isWhiteMove() ? 1 : 0;
+        rec[33] = (U8)std::round(pi.result * 2);
+        int score = clamp(pi.searchScore, -32767, 32767);
+        rec[34] = score & 0xff;
+        rec[35] = (score >> 8) & 0xff;
+        os.write((const char*)rec, sizeof(rec));
+    }
+    if (!os)
+        throw ChessParseError("Error writing file: " + outFile);
+}
+
 void
 ChessTool::computeSearchScores(std::istream& is, const std::string& script, int nWorkers) {
     std::vector<PositionInfo> positions;
@@ -1150,6 +1175,9 @@ ChessTool::printParams() {
     os << "tempoBonusMG : " << tempoBonusMG << std::endl;
     os << "tempoBonusEG : " << tempoBonusEG << std::endl;
 
+    os << "lazyEvalMarginMG : " << lazyEvalMarginMG << std::endl;
+    os << "lazyEvalMarginEG : " << lazyEvalMarginEG << std::endl;
+
     os << "pawnLoMtrl          : " << pawnLoMtrl << std::endl;
     os << "pawnHiMtrl          : " << pawnHiMtrl << std::endl;
     os << "minorLoMtrl         : " << minorLoMtrl << std::endl;
@@ -1353,6 +1381,9 @@ ChessTool::patchParams(const std::string& directory) {
     replaceValue(tempoBonusMG, "tempoBonusMG", hppFile);
     replaceValue(tempoBonusEG, "tempoBonusEG", hppFile);
 
+    replaceValue(lazyEvalMarginMG, "lazyEvalMarginMG", hppFile);
+    replaceValue(lazyEvalMarginEG, "lazyEvalMarginEG", hppFile);
+
     replaceValue(pawnLoMtrl, "pawnLoMtrl", hppFile);
     replaceValue(pawnHiMtrl, "pawnHiMtrl", hppFile);
     replaceValue(minorLoMtrl, "minorLoMtrl", hppFile);
@@ -1632,8 +1663,29 @@ ChessTool::qEval(std::vector<PositionInfo>& positions) {
     qEval(positions, 0, positions.size());
 }
 
+/** Return evaluation hash tables for the current thread. The tables are kept
+ *  between qEval() calls, but are cleared when a new call starts, since the
+ *  evaluation parameters may have changed. */
+static Evaluate::EvalHashTables&
+threadEvalHashTables(U64 qEvalGeneration) {
+    static thread_local std::unique_ptr<Evaluate::EvalHashTables> et;
+    static thread_local U64 etGeneration = 0;
+    if (!et)
+        et = Evaluate::getEvalHashTables();
+    else if (etGeneration != qEvalGeneration) {
+        et->updateSize();
+        et->clear();
+    }
+    etGeneration = qEvalGeneration;
+    return *et;
+}
+
 void
 ChessTool::qEval(std::vector<PositionInfo>& positions, const int beg, const int end) {
+    static U64 qEvalGeneration = 0;
+    qEvalGeneration++;
+    const U64 generation = qEvalGeneration;
+
     TranspositionTable tt(512*1024);
     Notifier notifier;
     ThreadCommunicator comm(nullptr, tt, notifier, false);
@@ -1641,33 +1693,27 @@ ChessTool::qEval(std::vector<PositionInfo>& positions, const int beg, const int
     std::vector<U64> nullHist(SearchConst::MAX_SEARCH_DEPTH * 2);
     KillerTable kt;
     History ht;
-    std::shared_ptr<Evaluate::EvalHashTables> et;
     TreeLogger treeLog;
     Position pos;
+    std::vector<Position::SerializeData> data;
+    std::vector<int> scores;
 
     const int chunkSize = 5000;
 
-#pragma omp parallel for default(none) shared(positions,tt,comm) private(kt,ht,et,treeLog,pos) firstprivate(nullHist)
+#pragma omp parallel for default(none) shared(positions,tt,comm) private(kt,ht,treeLog,pos,data,scores) firstprivate(nullHist)
     for (int c = beg; c < end; c += chunkSize) {
-        if (!et)
-            et = Evaluate::getEvalHashTables();
-        Search::SearchTables st(comm.getCTT(), kt, ht, *et);
-
-        const int mate0 = SearchConst::MATE0;
+        Evaluate::EvalHashTables& et = threadEvalHashTables(generation);
+        Search::SearchTables st(comm.getCTT(), kt, ht, et);
         Search sc(pos, nullHist, 0, st, comm, treeLog);
 
-        for (int i = 0; i < chunkSize; i++) {
-            if (c + i >= end)
-                break;
-            PositionInfo& pi = positions[c + i];
-            pos.deSerialize(pi.posData);
-            sc.init(pos, nullHist, 0);
-            sc.q0Eval = UNKNOWN_SCORE;
-            int score = sc.quiesce(-mate0, mate0, 0, 0, MoveGen::inCheck(pos));
-            if (!pos.isWhiteMove())
-                score = -score;
-            pi.qScore = score;
-        }
+        const int n = std::min(chunkSize, end - c);
+        data.resize(n);
+        scores.resize(n);
+        for (int i = 0; i < n; i++)
+            data[i] = positions[c + i].posData;
+        sc.quiesceBatch(&data[0], n, &scores[0]);
+        for (int i = 0; i < n; i++)
+            positions[c + i].qScore = scores[i];
     }
 }
 
@@ -1732,8 +1778,7 @@ ChessTool::computeMoveOrderObjective(std::vector<PositionInfo>& positions, const
             pos.deSerialize(pi.posData);
 
             MoveList moves;
-            MoveGen::pseudoLegalMoves(pos, moves);
-            MoveGen::removeIllegal(pos, moves);
+            MoveGen::legalMoves(pos, moves);
 
             staticScoreMoveListQuiet(pos, eval, moves);
 
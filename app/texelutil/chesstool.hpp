@@ -126,6 +126,13 @@ public:
     /** Print positions where abs(qScore) >= threshold and game result != (1+sign(qScore))/2. */
     void outliers(std::istream& is, int threshold);
 
+    /** Convert a FEN file to binary neural network training data written to outFile.
+     *  Each position is stored as a 36 byte record: 32 bytes with the piece on each
+     *  square, a1 first, two squares per byte, low nibble first; 1 byte side to move,
+     *  1 for white; 1 byte game result for white, 0, 1 or 2 half points; 2 bytes
+     *  little endian search score from white's perspective. */
+    void nnueData(std::istream& is, const std::string& outFile);
+
     /** In a FEN file, update the search score in each line by running a script to get the new score.
      *  Use "nWorkers" worker threads. */
     void computeSearchScores(std::istream& is, const std::string& script, int nWorkers);
@@ -79,8 +79,7 @@ MatchBookCreator::createBookLines(Position& pos, std::vector<Move>& moveList, in
         return;
     }
     MoveList moves;
-    MoveGen::pseudoLegalMoves(pos, moves);
-    MoveGen::removeIllegal(pos, moves);
+    MoveGen::legalMoves(pos, moves);
     UndoInfo ui;
     for (int mi = 0; mi < moves.size; mi++) {
         const Move& m = moves[mi];
@@ -123,8 +122,7 @@ MatchBookCreator::evaluateBookLines(std::vector<BookLine>& lines, int searchTime
         }
 
         MoveList legalMoves;
-        MoveGen::pseudoLegalMoves(pos, legalMoves);
-        MoveGen::removeIllegal(pos, legalMoves);
+        MoveGen::legalMoves(pos, legalMoves);
 
         Search::SearchTables st(comm.getCTT(), kt, ht, *et);
         Search sc(pos, posHashList, posHashListSize, st, comm, treeLog);
@@ -28,6 +28,11 @@
 #include "spsa.hpp"
 #include "bookbuild.hpp"
 #include "proofgame.hpp"
+#include "perft.hpp"
+#include "smpbench.hpp"
+#include "timereplay.hpp"
+#include "benchcmp.hpp"
+#include "tbStats.hpp"
 #include "matchbookcreator.hpp"
 #include "tbgen.hpp"
 #include "parameters.hpp"
@@ -38,6 +43,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <thread>
 
 void
 parseParValues(const std::string& fname, std::vector<ParamValue>& parValues) {
@@ -71,11 +77,13 @@ setInitialValues(const std::string& fname) {
 
 void
 usage() {
-    std::cerr << "Usage: texelutil [-iv file] [-e] [-moveorder] cmd params\n";
+    std::cerr << "Usage: texelutil [-iv file] [-e] [-moveorder] [-eh table n] cmd params\n";
     std::cerr << " -iv file : Set initial parameter values\n";
     std::cerr << " -e : Use cross entropy error function\n";
     std::cerr << " -s : Use search score instead of game result\n";
     std::cerr << " -moveorder : Optimize static move ordering\n";
+    std::cerr << " -eh table n : Set number of entries in evaluation hash table,\n";
+    std::cerr << "               table is one of pawn, kingsafety, eval\n";
     std::cerr << "cmd is one of:\n";
     std::cerr << "\n";
     std::cerr << " p2f [n]  : Convert from PGN to FEN, using each position with probability 1/n.\n";
@@ -90,6 +98,7 @@ usage() {
     std::cerr << " search script nWorkers: Update search score in FEN file by running script\n";
     std::cerr << "                         on all lines. Run nWorkers scripts in parallel\n";
     std::cerr << " outliers threshold  : Print positions with unexpected game result\n";
+    std::cerr << " nnuedata outfile    : Write positions as binary neural network training data\n";
     std::cerr << " evaleffect evalfile : Print eval improvement when parameters are changed\n";
     std::cerr << " pawnadv  : Compute evaluation error for different pawn advantage\n";
     std::cerr << " score2prob : Compute table of expected score as function of centipawns\n";
@@ -141,10 +150,30 @@ usage() {
     std::cerr << "           -p : Consider game pairs when computing standard deviation.\n";
     std::cerr << "\n";
     std::cerr << " proofgame [-w a:b] [-i \"initFen\"] \"goalFen\"\n";
+    std::cerr << "\n";
+    std::cerr << " perft [-d] [-t nThreads] [-h hashMB] depth [\"fen\"] : Count leaf nodes\n";
+    std::cerr << "           -d : Print node count for each root move\n";
+    std::cerr << " smpbench [-t maxThreads] [-d depth] [-h hashMB] [-s] [fenFile]\n";
+    std::cerr << "           : Measure search speedup as a function of number of threads\n";
+    std::cerr << "           -s : Also search using shared pawn/king safety hash tables\n";
+    std::cerr << " timereplay logFile [formula ...] : Replay a TimeLogFile using alternative\n";
+    std::cerr << "           time allocation formulas. formula is a list of key=value pairs\n";
+    std::cerr << "           separated by commas. Keys: min, max, moves, buffer, hard\n";
+    std::cerr << " benchcmp [-n pairs] [-h hashMB] [-t threads] [-d depth] [-m maxSlowdown%]\n";
+    std::cerr << "          [-json file] [-oa name=value] [-ob name=value] engineA [engineB]\n";
+    std::cerr << "           : Compare bench NPS for two engines or two sets of UCI options.\n";
+    std::cerr << "           Exit status is 1 if engineB is significantly slower\n";
     std::cerr << std::flush;
     ::exit(2);
 }
 
+/** Print tablebase probe statistics, if they are being collected. */
+static void
+printTBStats() {
+    if (TBStats::enabled)
+        TBStats::print(std::cout);
+}
+
 void
 parseParamDomains(int argc, char* argv[], std::vector<ParamDomain>& params) {
     int i = 2;
@@ -350,6 +379,24 @@ doBookCmd(int argc, char* argv[]) {
     }
 }
 
+/** Set the size of one of the evaluation hash tables. */
+static void
+setEvalHashEntries(const std::string& table, const std::string& entries) {
+    int n;
+    if (!str2Num(entries, n))
+        usage();
+    std::shared_ptr<Parameters::SpinParam> par;
+    if (table == "pawn")
+        par = UciParams::pawnHashEntries;
+    else if (table == "kingsafety")
+        par = UciParams::kingSafetyHashEntries;
+    else if (table == "eval")
+        par = UciParams::evalHashEntries;
+    else
+        usage();
+    par->set(num2Str(n));
+}
+
 int
 main(int argc, char* argv[]) {
     std::ios::sync_with_stdio(false);
@@ -376,6 +423,10 @@ main(int argc, char* argv[]) {
                 optimizeMoveOrdering = true;
                 argc -= 1;
                 argv += 1;
+            } else if ((argc >= 4) && (std::string(argv[1]) == "-eh")) {
+                setEvalHashEntries(argv[2], argv[3]);
+                argc -= 3;
+                argv += 3;
             } else
                 break;
         }
@@ -410,6 +461,10 @@ main(int argc, char* argv[]) {
             if (!str2Num(argv[3], nWorkers))
                 usage();
             chessTool.computeSearchScores(std::cin, script, nWorkers);
+        } else if (cmd == "nnuedata") {
+            if (argc != 3)
+                usage();
+            chessTool.nnueData(std::cin, argv[2]);
         } else if (cmd == "outliers") {
             int threshold;
             if ((argc < 3) || !str2Num(argv[2], threshold))
@@ -477,6 +532,7 @@ main(int argc, char* argv[]) {
             for (int i = 2; i < argc; i++)
                 tbTypes.push_back(argv[i]);
             PosGenerator::dtmStat(tbTypes);
+            printTBStats();
         } else if (cmd == "dtzstat") {
             if (argc < 3)
                 usage();
@@ -484,6 +540,7 @@ main(int argc, char* argv[]) {
             for (int i = 2; i < argc; i++)
                 tbTypes.push_back(argv[i]);
             PosGenerator::dtzStat(tbTypes);
+            printTBStats();
         } else if (cmd == "egstat") {
             if (argc < 4)
                 usage();
@@ -492,6 +549,7 @@ main(int argc, char* argv[]) {
             for (int i = 3; i < argc; i++)
                 pieceTypes.push_back(argv[i]);
             PosGenerator::egStat(tbType, pieceTypes);
+            printTBStats();
         } else if (cmd == "wdltest") {
             if (argc < 3)
                 usage();
@@ -499,6 +557,7 @@ main(int argc, char* argv[]) {
             for (int i = 2; i < argc; i++)
                 tbTypes.push_back(argv[i]);
             PosGenerator::wdlTest(tbTypes);
+            printTBStats();
         } else if (cmd == "wdldump") {
             if (argc < 3)
                 usage();
@@ -506,6 +565,7 @@ main(int argc, char* argv[]) {
             for (int i = 2; i < argc; i++)
                 tbTypes.push_back(argv[i]);
             PosGenerator::wdlDump(tbTypes);
+            printTBStats();
         } else if (cmd == "dtztest") {
             if (argc < 3)
                 usage();
@@ -513,11 +573,13 @@ main(int argc, char* argv[]) {
             for (int i = 2; i < argc; i++)
                 tbTypes.push_back(argv[i]);
             PosGenerator::dtzTest(tbTypes);
+            printTBStats();
         } else if (cmd == "dtz") {
             if (argc < 3)
                 usage();
             std::string fen = argv[2];
             ChessTool::probeDTZ(fen);
+            printTBStats();
         } else if (cmd == "score2prob") {
             ScoreToProb sp;
             for (int i = -100; i <= 100; i++)
@@ -672,6 +734,149 @@ main(int argc, char* argv[]) {
             ProofGame ps(goalFen, a, b);
             std::vector<Move> movePath;
             ps.search(initFen, movePath);
+        } else if (cmd == "perft") {
+            bool divide = false;
+            int nThreads = 1;
+            int hashMB = 0;
+            int arg = 2;
+            while (arg < argc) {
+                std::string a(argv[arg]);
+                if (a == "-d") {
+                    divide = true;
+                    arg++;
+                } else if ((a == "-t") && (arg + 1 < argc)) {
+                    if (!str2Num(argv[arg+1], nThreads) || (nThreads < 1))
+                        usage();
+                    arg += 2;
+                } else if ((a == "-h") && (arg + 1 < argc)) {
+                    if (!str2Num(argv[arg+1], hashMB) || (hashMB < 0))
+                        usage();
+                    arg += 2;
+                } else
+                    break;
+            }
+            int depth;
+            if ((arg >= argc) || !str2Num(argv[arg], depth) || (depth < 0))
+                usage();
+            arg++;
+            std::string fen = TextIO::startPosFEN;
+            if (arg < argc)
+                fen = argv[arg++];
+            if (arg != argc)
+                usage();
+            Position pos = TextIO::readFEN(fen);
+            PerfT perfT(nThreads, hashMB);
+            perfT.run(pos, depth, divide, std::cout);
+        } else if (cmd == "smpbench") {
+            int maxThreads = std::max((int)std::thread::hardware_concurrency(), 1);
+            int depth = 16;
+            int hashMB = 256;
+            bool compareShared = false;
+            int arg = 2;
+            while (arg < argc) {
+                std::string a(argv[arg]);
+                if (a == "-s") {
+                    compareShared = true;
+                    arg++;
+                    continue;
+                }
+                if (arg + 1 >= argc)
+                    break;
+                if (a == "-t") {
+                    if (!str2Num(argv[arg+1], maxThreads) || (maxThreads < 1))
+                        usage();
+                } else if (a == "-d") {
+                    if (!str2Num(argv[arg+1], depth) || (depth < 1))
+                        usage();
+                } else if (a == "-h") {
+                    if (!str2Num(argv[arg+1], hashMB) || (hashMB < 1))
+                        usage();
+                } else
+                    break;
+                arg += 2;
+            }
+            std::vector<Position> positions;
+            if (arg < argc) {
+                for (const std::string& line : ChessTool::readFile(argv[arg++]))
+                    if (!trim(line).empty())
+                        positions.push_back(TextIO::readFEN(line));
+            } else {
+                positions = SmpBench::defaultPositions();
+            }
+            if (arg != argc)
+                usage();
+            SmpBench smpBench(maxThreads, depth, hashMB, compareShared);
+            std::vector<SmpBench::Result> results;
+            smpBench.run(positions, results, std::cerr);
+            SmpBench::printTable(results, std::cout);
+            std::cout << std::endl;
+            SmpBench::printCsv(results, std::cout);
+        } else if (cmd == "timereplay") {
+            if (argc < 3)
+                usage();
+            std::vector<TimeLog::Entry> entries;
+            TimeLog::readFile(argv[2], entries);
+            std::vector<TimeReplay::Result> results;
+            results.push_back(TimeReplay::logged(entries));
+            results.push_back(TimeReplay::replay(TimeReplay::Formula(), entries));
+            for (int i = 3; i < argc; i++)
+                results.push_back(TimeReplay::replay(TimeReplay::Formula::parse(argv[i]), entries));
+            TimeReplay::printResults(results, std::cout);
+        } else if (cmd == "benchcmp") {
+            BenchCmp::Engine engineA, engineB;
+            int nPairs = 10;
+            int hashMB = 16;
+            int threads = 1;
+            int depth = 12;
+            double maxSlowdown = 0;
+            std::string jsonFile;
+            int arg = 2;
+            while (arg + 1 < argc) {
+                std::string a(argv[arg]);
+                if (a == "-n") {
+                    if (!str2Num(argv[arg+1], nPairs) || (nPairs < 2))
+                        usage();
+                } else if (a == "-h") {
+                    if (!str2Num(argv[arg+1], hashMB) || (hashMB < 1))
+                        usage();
+                } else if (a == "-t") {
+                    if (!str2Num(argv[arg+1], threads) || (threads < 1))
+                        usage();
+                } else if (a == "-d") {
+                    if (!str2Num(argv[arg+1], depth) || (depth < 1))
+                        usage();
+                } else if (a == "-m") {
+                    if (!str2Num(argv[arg+1], maxSlowdown) || (maxSlowdown < 0))
+                        usage();
+                } else if (a == "-json") {
+                    jsonFile = argv[arg+1];
+                } else if ((a == "-oa") || (a == "-ob")) {
+                    std::string opt(argv[arg+1]);
+                    size_t idx = opt.find('=');
+                    if (idx == std::string::npos)
+                        usage();
+                    auto& options = (a == "-oa") ? engineA.options : engineB.options;
+                    options.push_back(std::make_pair(opt.substr(0, idx), opt.substr(idx + 1)));
+                } else
+                    break;
+                arg += 2;
+            }
+            if ((arg >= argc) || (arg + 2 < argc))
+                usage();
+            engineA.command = argv[arg];
+            engineB.command = (arg + 1 < argc) ? argv[arg+1] : argv[arg];
+            std::ofstream json;
+            if (!jsonFile.empty()) {
+                json.open(jsonFile, std::ios_base::out | std::ios_base::app);
+                if (!json)
+                    throw ChessParseError("Failed to open file: " + jsonFile);
+            }
+            BenchCmp benchCmp(engineA, engineB, nPairs, hashMB, threads, depth);
+            BenchCmp::Comparison c = benchCmp.run(maxSlowdown, std::cerr,
+                                                  jsonFile.empty() ? nullptr : &json);
+            BenchCmp::printComparison(c, std::cout);
+            if (c.slowdown)
+                return 1;
         } else {
             usage();
         }
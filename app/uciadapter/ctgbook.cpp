@@ -651,8 +651,7 @@ CtgBook::getBookMove(Position& pos, Move& out) {
         return false;
 
     MoveList legalMoves;
-    MoveGen::pseudoLegalMoves(pos, legalMoves);
-    MoveGen::removeIllegal(pos, legalMoves);
+    MoveGen::legalMoves(pos, legalMoves);
 
     float fSum = 0;
     for (const BookEntry& be : bookMoves) {
@@ -0,0 +1,76 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * attackInfo.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "attackInfo.hpp"
+
+/** Return all pieces that are the only piece between "sq" and a slider
+ *  in "bishops" or "rooks" that moves along the line to "sq". */
+static U64
+sliderBlockers(int sq, U64 bishops, U64 rooks, U64 occupied) {
+    U64 snipers = (BitBoard::bishopAttacks(sq, 0) & bishops) |
+                  (BitBoard::rookAttacks(sq, 0) & rooks);
+    U64 ret = 0;
+    while (snipers) {
+        int sniperSq = BitBoard::extractSquare(snipers);
+        U64 between = BitBoard::squaresBetween(sq, sniperSq) & occupied;
+        if (between && !(between & (between - 1)))
+            ret |= between;
+    }
+    return ret;
+}
+
+template <bool wtm>
+void
+AttackInfo::compute(const Position& pos) {
+    using MyColor = ColorTraits<wtm>;
+    using OtherColor = ColorTraits<!wtm>;
+    hashKey = pos.zobristHash();
+
+    const U64 occupied = pos.occupiedBB();
+    const U64 myPieces = pos.colorBB(wtm);
+    const int kingSq = pos.getKingSq(wtm);
+    const int oKingSq = pos.getKingSq(!wtm);
+
+    const U64 myBQ = pos.pieceTypeBB(MyColor::BISHOP, MyColor::QUEEN);
+    const U64 myRQ = pos.pieceTypeBB(MyColor::ROOK, MyColor::QUEEN);
+    const U64 oBQ = pos.pieceTypeBB(OtherColor::BISHOP, OtherColor::QUEEN);
+    const U64 oRQ = pos.pieceTypeBB(OtherColor::ROOK, OtherColor::QUEEN);
+
+    const U64 oPawnAtks = wtm ? BitBoard::wPawnAttacks(kingSq) : BitBoard::bPawnAttacks(kingSq);
+    checkers = (BitBoard::knightAttacks(kingSq) & pos.pieceTypeBB(OtherColor::KNIGHT)) |
+               (oPawnAtks & pos.pieceTypeBB(OtherColor::PAWN)) |
+               (BitBoard::bishopAttacks(kingSq, occupied) & oBQ) |
+               (BitBoard::rookAttacks(kingSq, occupied) & oRQ);
+    pinned = sliderBlockers(kingSq, oBQ, oRQ, occupied) & myPieces;
+    discoverers = sliderBlockers(oKingSq, myBQ, myRQ, occupied) & myPieces;
+
+    pawnChecks = wtm ? BitBoard::bPawnAttacks(oKingSq) : BitBoard::wPawnAttacks(oKingSq);
+    knightChecks = BitBoard::knightAttacks(oKingSq);
+    bishopChecks = BitBoard::bishopAttacks(oKingSq, occupied);
+    rookChecks = BitBoard::rookAttacks(oKingSq, occupied);
+}
+
+template void AttackInfo::compute<true>(const Position& pos);
+template void AttackInfo::compute<false>(const Position& pos);
@@ -0,0 +1,78 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * attackInfo.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef ATTACKINFO_HPP_
+#define ATTACKINFO_HPP_
+
+#include "position.hpp"
+
+/**
+ * Check and pin information for a position. The information is needed
+ * for every move at a search node, by legality testing and check detection,
+ * but only depends on the position. It is therefore computed once and reused
+ * until the position changes, which is detected using the position hash key.
+ *
+ * This is only a cache for move generation. It does not contain per-side or
+ * per-piece-type attack maps, and SEE and Evaluate do not use it. SEE computes
+ * the attackers of each target square itself, and Evaluate computes the
+ * attacks of each piece once per evaluation.
+ */
+class AttackInfo {
+public:
+    /** Make sure the information corresponds to "pos". Cheap if it already does. */
+    void update(const Position& pos);
+
+    /** Opponent pieces attacking the king of the side to move. */
+    U64 checkers;
+    /** Pieces of the side to move pinned to their own king. */
+    U64 pinned;
+    /** Pieces of the side to move that give discovered check if they
+     *  move off the line to the opponent king. */
+    U64 discoverers;
+
+    /** Squares from which a piece of the side to move would attack the
+     *  opponent king. A queen checks from bishopChecks | rookChecks. */
+    U64 pawnChecks;
+    U64 knightChecks;
+    U64 bishopChecks;
+    U64 rookChecks;
+
+private:
+    template <bool wtm> void compute(const Position& pos);
+
+    U64 hashKey = 0; // Hash key of the position the information corresponds to
+};
+
+inline void
+AttackInfo::update(const Position& pos) {
+    if (hashKey != pos.zobristHash()) {
+        if (pos.isWhiteMove())
+            compute<true>(pos);
+        else
+            compute<false>(pos);
+    }
+}
+
+#endif /* ATTACKINFO_HPP_ */
@@ -25,6 +25,9 @@
 
 #include "bitBoard.hpp"
 #include "position.hpp"
+#include "util/cpuInfo.hpp"
+#include <vector>
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 
@@ -122,6 +125,17 @@ const U64 BitBoard::bMagics[64] = {
 
 vector_aligned<U64> BitBoard::tableData;
 
+#ifdef COMPACT_ATTACKS
+U8* BitBoard::rIndex[64];
+U8* BitBoard::bIndex[64];
+vector_aligned<U8> BitBoard::indexData;
+#endif
+
+#ifdef HAS_CPU_DISPATCH
+bool BitBoard::usePext = false;
+bool BitBoard::usePopcnt = false;
+#endif
+
 const S8 BitBoard::dirTable[] = {
        -9,  0,  0,  0,  0,  0,  0, -8,  0,  0,  0,  0,  0,  0, -7,
     0,  0, -9,  0,  0,  0,  0,  0, -8,  0,  0,  0,  0,  0, -7,  0,
@@ -208,6 +222,16 @@ static StaticInitializer<BitBoard> bbInit;
 
 void
 BitBoard::staticInitialize() {
+    std::string missing = CpuInfo::instance().missingFeatures();
+    if (!missing.empty()) {
+        std::cerr << "This program requires CPU features not supported by this computer: "
+                  << missing << std::endl;
+        exit(1);
+    }
+#ifdef HAS_CPU_DISPATCH
+    usePext = CpuInfo::instance().hasFastPext();
+    usePopcnt = CpuInfo::instance().hasPopcnt();
+#endif
 
     for (int f = 0; f < 8; f++) {
         U64 m = 0;
@@ -266,7 +290,40 @@ BitBoard::staticInitialize() {
         bPawnBlockerMaskTable[sq] = m;
     }
 
-#ifdef HAS_BMI2
+    if (pextAttacks())
+        initPextTables();
+    else
+        initMagicTables();
+#ifdef COMPACT_ATTACKS
+    compactTables();
+#endif
+
+    // squaresBetween
+    for (int sq1 = 0; sq1 < 64; sq1++) {
+        for (int j = 0; j < 64; j++)
+            squaresBetweenTable[sq1][j] = 0;
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                if ((dx == 0) && (dy == 0))
+                    continue;
+                U64 m = 0;
+                int x = Square::getX(sq1);
+                int y = Square::getY(sq1);
+                while (true) {
+                    x += dx; y += dy;
+                    if ((x < 0) || (x > 7) || (y < 0) || (y > 7))
+                        break;
+                    int sq2 = Square::getSquare(x, y);
+                    squaresBetweenTable[sq1][sq2] = m;
+                    m |= 1ULL << sq2;
+                }
+            }
+        }
+    }
+}
+
+void
+BitBoard::initPextTables() {
     int tdSize = 0;
     for (int sq = 0; sq < 64; sq++) {
         int x = Square::getX(sq);
@@ -306,7 +363,10 @@ BitBoard::staticInitialize() {
         }
         bTables[sq] = table;
     }
-#else
+}
+
+void
+BitBoard::initMagicTables() {
     int rTableSize = 0;
     for (int sq = 0; sq < 64; sq++)
         rTableSize += 1 << (64 - rBits[sq]);
@@ -363,28 +423,56 @@ BitBoard::staticInitialize() {
         }
         bTables[sq] = table;
     }
-#endif
+}
 
-    // squaresBetween
-    for (int sq1 = 0; sq1 < 64; sq1++) {
-        for (int j = 0; j < 64; j++)
-            squaresBetweenTable[sq1][j] = 0;
-        for (int dx = -1; dx <= 1; dx++) {
-            for (int dy = -1; dy <= 1; dy++) {
-                if ((dx == 0) && (dy == 0))
-                    continue;
-                U64 m = 0;
-                int x = Square::getX(sq1);
-                int y = Square::getY(sq1);
-                while (true) {
-                    x += dx; y += dy;
-                    if ((x < 0) || (x > 7) || (y < 0) || (y > 7))
-                        break;
-                    int sq2 = Square::getSquare(x, y);
-                    squaresBetweenTable[sq1][sq2] = m;
-                    m |= 1ULL << sq2;
-                }
+#ifdef COMPACT_ATTACKS
+void
+BitBoard::compactTables() {
+    int rSize[64], bSize[64];
+    int idxSize = 0;
+    for (int sq = 0; sq < 64; sq++) {
+        rSize[sq] = 1 << (pextAttacks() ? bitCount(rMasks[sq]) : 64 - rBits[sq]);
+        bSize[sq] = 1 << (pextAttacks() ? bitCount(bMasks[sq]) : 64 - bBits[sq]);
+        idxSize += rSize[sq] + bSize[sq];
+    }
+    indexData.resize(idxSize);
+
+    // Store each distinct attack mask once per square. Unused magic table
+    // entries are mapped to index 0.
+    std::vector<U64> attacks;
+    int rOffs[64], bOffs[64];
+    int idxUsed = 0;
+    auto compact = [&](const U64* table, int tableSize, U8*& index) -> int {
+        const int offs = attacks.size();
+        index = &indexData[idxUsed];
+        idxUsed += tableSize;
+        for (int i = 0; i < tableSize; i++) {
+            const U64 atks = table[i];
+            int j = 0;
+            if (atks != 0xffffffffffffffffULL) {
+                const int n = attacks.size() - offs;
+                while ((j < n) && (attacks[offs + j] != atks))
+                    j++;
+                if (j == n)
+                    attacks.push_back(atks);
             }
+            assert(j < 256);
+            index[i] = (U8)j;
         }
+        return offs;
+    };
+    for (int sq = 0; sq < 64; sq++)
+        rOffs[sq] = compact(rTables[sq], rSize[sq], rIndex[sq]);
+    for (int sq = 0; sq < 64; sq++)
+        bOffs[sq] = compact(bTables[sq], bSize[sq], bIndex[sq]);
+
+    vector_aligned<U64> td;
+    td.resize(attacks.size());
+    std::copy(attacks.begin(), attacks.end(), td.begin());
+    tableData.swap(td);
+    for (int sq = 0; sq < 64; sq++) {
+        rTables[sq] = &tableData[rOffs[sq]];
+        bTables[sq] = &tableData[bOffs[sq]];
     }
 }
+#endif
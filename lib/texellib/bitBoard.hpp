@@ -45,6 +45,22 @@
 inline U64 pext(U64 value, U64 mask) {
     return _pext_u64(value, mask);
 }
+#elif defined(HAS_CPU_DISPATCH)
+#if _MSC_VER
+#include <immintrin.h>
+#include <nmmintrin.h>
+#endif
+/** pext for code not compiled with BMI2 enabled. Must only be called if
+ *  the CPU supports BMI2. */
+inline U64 pext(U64 value, U64 mask) {
+#if _MSC_VER
+    return _pext_u64(value, mask);
+#else
+    U64 ret;
+    __asm__("pextq %2, %1, %0" : "=r"(ret) : "r"(value), "r"(mask));
+    return ret;
+#endif
+}
 #endif
 
 class BitBoard {
@@ -138,7 +154,34 @@ public:
     /** Initialize static data. */
     static void staticInitialize();
 
+    /** True if slider attacks are computed using the pext instruction. */
+    static bool pextAttacks();
+
+    /** True if bitCount() uses the popcnt instruction. */
+    static bool popcntBitCount();
+
 private:
+    /** Initialize slider attack tables indexed by pext. */
+    static void initPextTables();
+    /** Initialize slider attack tables indexed by magic multiplication. */
+    static void initMagicTables();
+#ifdef COMPACT_ATTACKS
+    /** Replace the slider attack tables by 8-bit indices into the set of
+     *  distinct attack masks for each square. */
+    static void compactTables();
+#endif
+
+    /** Slider attack table entry for a square and occupancy. */
+    static int bishopIndex(int sq, U64 occupied);
+    static int rookIndex(int sq, U64 occupied);
+
+#ifdef HAS_CPU_DISPATCH
+    /** Instruction selection for CPU features not enabled at compile time.
+     *  Set once in staticInitialize() based on the cpuid information. */
+    static bool usePext;
+    static bool usePopcnt;
+#endif
+
     /** Squares attacked by a king on a given square. */
     static U64 kingAttacksTable[64];
     static U64 knightAttacksTable[64];
@@ -163,6 +206,12 @@ private:
 
     static vector_aligned<U64> tableData;
 
+#ifdef COMPACT_ATTACKS
+    static U8* rIndex[64];
+    static U8* bIndex[64];
+    static vector_aligned<U8> indexData;
+#endif
+
     static const S8 dirTable[];
     static const int trailingZ[64];
 };
@@ -190,21 +239,47 @@ BitBoard::mirrorY(U64 mask) {
     return t;
 }
 
+inline int
+BitBoard::bishopIndex(int sq, U64 occupied) {
+#ifdef HAS_BMI2
+    return (int)pext(occupied, bMasks[sq]);
+#else
+#ifdef HAS_CPU_DISPATCH
+    if (usePext)
+        return (int)pext(occupied, bMasks[sq]);
+#endif
+    return (int)(((occupied & bMasks[sq]) * bMagics[sq]) >> bBits[sq]);
+#endif
+}
+
 inline U64
 BitBoard::bishopAttacks(int sq, U64 occupied) {
+#ifdef COMPACT_ATTACKS
+    return bTables[sq][bIndex[sq][bishopIndex(sq, occupied)]];
+#else
+    return bTables[sq][bishopIndex(sq, occupied)];
+#endif
+}
+
+inline int
+BitBoard::rookIndex(int sq, U64 occupied) {
 #ifdef HAS_BMI2
-    return bTables[sq][pext(occupied, bMasks[sq])];
+    return (int)pext(occupied, rMasks[sq]);
 #else
-    return bTables[sq][(int)(((occupied & bMasks[sq]) * bMagics[sq]) >> bBits[sq])];
+#ifdef HAS_CPU_DISPATCH
+    if (usePext)
+        return (int)pext(occupied, rMasks[sq]);
+#endif
+    return (int)(((occupied & rMasks[sq]) * rMagics[sq]) >> rBits[sq]);
 #endif
 }
 
 inline U64
 BitBoard::rookAttacks(int sq, U64 occupied) {
-#ifdef HAS_BMI2
-    return rTables[sq][pext(occupied, rMasks[sq])];
+#ifdef COMPACT_ATTACKS
+    return rTables[sq][rIndex[sq][rookIndex(sq, occupied)]];
 #else
-    return rTables[sq][(int)(((occupied & rMasks[sq]) * rMagics[sq]) >> rBits[sq])];
+    return rTables[sq][rookIndex(sq, occupied)];
 #endif
 }
 
@@ -256,6 +331,28 @@ BitBoard::northFill(U64 mask) {
     return mask;
 }
 
+inline bool
+BitBoard::pextAttacks() {
+#ifdef HAS_BMI2
+    return true;
+#elif defined(HAS_CPU_DISPATCH)
+    return usePext;
+#else
+    return false;
+#endif
+}
+
+inline bool
+BitBoard::popcntBitCount() {
+#ifdef HAS_POPCNT
+    return true;
+#elif defined(HAS_CPU_DISPATCH)
+    return usePopcnt;
+#else
+    return false;
+#endif
+}
+
 inline int
 BitBoard::firstSquare(U64 mask) {
 #ifdef HAS_CTZ
@@ -292,6 +389,16 @@ BitBoard::bitCount(U64 mask) {
         return __builtin_popcountl(mask >> 32) +
                __builtin_popcountl(mask & 0xffffffffULL);
 #endif
+#elif defined(HAS_CPU_DISPATCH)
+    if (usePopcnt) {
+#if _MSC_VER
+        return (int)_mm_popcnt_u64(mask);
+#else
+        U64 ret;
+        __asm__("popcntq %1, %0" : "=r"(ret) : "r"(mask));
+        return (int)ret;
+#endif
+    }
 #endif
     const U64 k1 = 0x5555555555555555ULL;
     const U64 k2 = 0x3333333333333333ULL;
@@ -53,8 +53,7 @@ Book::getBookMove(Position& pos, Move& out) {
 
     bool pgBook = !UciParams::bookFile->getStringPar().empty();
     MoveList legalMoves;
-    MoveGen::pseudoLegalMoves(pos, legalMoves);
-    MoveGen::removeIllegal(pos, legalMoves);
+    MoveGen::legalMoves(pos, legalMoves);
     int sum = 0;
     for (const BookEntry& be : bookMoves) {
         bool contains = false;
@@ -345,24 +345,26 @@ MPICommunicator::doSendReportResult(int jobId, int score) {
 }
 
 void
-MPICommunicator::doSendReportStats(S64 nodesSearched, S64 tbHits) {
+MPICommunicator::doSendReportStats(S64 nodesSearched, S64 tbHits,
+                                   const SearchStats& stats) {
     bool done = false;
     for (std::shared_ptr<Command>& c : cmdQueue) {
         if (c->type == CommandType::REPORT_STATS) {
             ReportStatsCommand* rCmd = static_cast<ReportStatsCommand*>(c.get());
             rCmd->nodesSearched += nodesSearched;
             rCmd->tbHits += tbHits;
+            rCmd->searchStats += stats;
             done = true;
             break;
         }
     }
     if (!done)
-        cmdQueue.push_back(std::make_shared<ReportStatsCommand>(nodesSearched, tbHits));
+        cmdQueue.push_back(std::make_shared<ReportStatsCommand>(nodesSearched, tbHits, stats));
     mpiSend();
 }
 
 void
-MPICommunicator::retrieveStats(S64& nodesSearched, S64& tbHits) {
+MPICommunicator::retrieveStats(S64& nodesSearched, S64& tbHits, SearchStats& stats) {
     assert(false); // Not used
 }
 
@@ -465,7 +467,8 @@ MPICommunicator::mpiRecv() {
                     break;
                 case CommandType::REPORT_STATS: {
                     const ReportStatsCommand* rCmd = static_cast<const ReportStatsCommand*>(cmd.get());
-                    parent->sendReportStats(rCmd->nodesSearched, rCmd->tbHits, false);
+                    parent->sendReportStats(rCmd->nodesSearched, rCmd->tbHits,
+                                            rCmd->searchStats, false);
                     break;
                 }
                 case CommandType::TT_DATA: {
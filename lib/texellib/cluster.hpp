@@ -142,8 +142,10 @@ public:
     void doSendQuit() override;
 
     void doSendReportResult(int jobId, int score) override;
-    void doSendReportStats(S64 nodesSearched, S64 tbHits) override;
-    void retrieveStats(S64& nodesSearched, S64& tbHits) override;
+    void doSendReportStats(S64 nodesSearched, S64 tbHits,
+                           const SearchStats& stats) override;
+    void retrieveStats(S64& nodesSearched, S64& tbHits,
+                       SearchStats& stats) override;
     void doSendStopAck() override;
     void doSendQuitAck() override;
 
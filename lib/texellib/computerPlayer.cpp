@@ -31,6 +31,8 @@
 #include "clustertt.hpp"
 #include "textio.hpp"
 #include "tbprobe.hpp"
+#include "sharedEvalHash.hpp"
+#include "util/cpuInfo.hpp"
 
 #include <iostream>
 
@@ -47,6 +49,66 @@ ComputerPlayer::staticInitialize() {
     engineName = name;
 }
 
+std::string
+ComputerPlayer::buildOptions() {
+    auto onOff = [](bool on) { return on ? "ON" : "OFF"; };
+    bool bmi2 = false, popcnt = false, prefetch = false, prefetchPipeline = false;
+    bool largePages = false;
+    bool cpuDispatch = false, compactAttacks = false;
+    bool compactPosition = false, copyMake = false, nnue = false;
+#ifdef HAS_BMI2
+    bmi2 = true;
+#endif
+#ifdef HAS_POPCNT
+    popcnt = true;
+#endif
+#ifdef HAS_PREFETCH
+    prefetch = true;
+#endif
+#ifdef PREFETCH_PIPELINE
+    prefetchPipeline = true;
+#endif
+#ifdef USE_LARGE_PAGES
+    largePages = true;
+#endif
+#ifdef HAS_CPU_DISPATCH
+    cpuDispatch = true;
+#endif
+#ifdef COMPACT_ATTACKS
+    compactAttacks = true;
+#endif
+#ifdef COMPACT_POSITION
+    compactPosition = true;
+#endif
+#ifdef COPY_MAKE
+    copyMake = true;
+#endif
+#ifdef HAS_NNUE
+    nnue = true;
+#endif
+#ifdef CPU_TYPE
+    std::string cpuType = CPU_TYPE;
+#else
+    std::string cpuType = "generic";
+#endif
+    std::string ret;
+    ret += std::string("USE_BMI2=") + onOff(bmi2);
+    ret += std::string(" USE_POPCNT=") + onOff(popcnt);
+    ret += std::string(" USE_PREFETCH=") + onOff(prefetch);
+    ret += std::string(" USE_PREFETCH_PIPELINE=") + onOff(prefetchPipeline);
+    ret += std::string(" USE_LARGE_PAGES=") + onOff(largePages);
+    ret += std::string(" USE_CPU_DISPATCH=") + onOff(cpuDispatch);
+    ret += std::string(" USE_COMPACT_ATTACKS=") + onOff(compactAttacks);
+    ret += std::string(" USE_COMPACT_POSITION=") + onOff(compactPosition);
+    ret += std::string(" USE_COPY_MAKE=") + onOff(copyMake);
+    ret += std::string(" USE_NNUE=") + onOff(nnue);
+    if (nnue)
+        ret += " NNUE_SIMD=" + NNUE::simdName();
+    ret += " CPU_TYPE=" + cpuType;
+    ret += " CPU_FEATURES=" + CpuInfo::instance().featureString();
+    return ret;
+}
+
 void
 ComputerPlayer::initEngine() {
     Parameters::instance();
@@ -60,6 +122,28 @@ ComputerPlayer::initEngine() {
     UciParams::gtbCache->addListener(tbInit, false);
     UciParams::rtbPath->addListener(tbInit, false);
 
+#ifdef HAS_NNUE
+    UciParams::evalFile->addListener([]() {
+        std::string errMsg;
+        if (!NNUE::loadNetwork(UciParams::evalFile->getStringPar(), errMsg))
+            std::cout << "info string " << errMsg << std::endl;
+    });
+    UciParams::useNNUE->addListener([]() {
+        NNUE::setEnabled(UciParams::useNNUE->getBoolPar());
+    });
+#endif
+
+    auto sharedEvalHashReset = []() {
+        SharedEvalHash::instance().reset();
+    };
+    UciParams::sharedEvalHash->addListener(sharedEvalHashReset);
+    UciParams::sharedPawnHashEntries->addListener(sharedEvalHashReset, false);
+    UciParams::sharedKingSafetyHashEntries->addListener(sharedEvalHashReset, false);
+    UciParams::sharedEvalHashPerNode->addListener(sharedEvalHashReset, false);
+    UciParams::clearHash->addListener([]() {
+        SharedEvalHash::instance().clear();
+    }, false);
+
     knightMobScore.addListener(Evaluate::updateEvalParams);
     castleFactor.addListener(Evaluate::updateEvalParams, false);
 //    bV.addListener([]() { Parameters::instance().set("KnightValue", num2Str((int)bV)); });
@@ -69,6 +153,21 @@ ComputerPlayer::initEngine() {
     rV.addListener([]() { pieceValue[Piece::WROOK]   = pieceValue[Piece::BROOK]   = rV; });
     qV.addListener([]() { pieceValue[Piece::WQUEEN]  = pieceValue[Piece::BQUEEN]  = qV; });
     kV.addListener([]() { pieceValue[Piece::WKING]   = pieceValue[Piece::BKING]   = kV; });
+
+    // Evaluation tables depending on parameters are updated when any
+    // parameter changes, so that new parameters are handled automatically.
+    static bool evalParamListeners = false;
+    if (!evalParamListeners) {
+        evalParamListeners = true;
+        Parameters& params = Parameters::instance();
+        std::vector<std::string> parNames;
+        params.getParamNames(parNames);
+        for (const std::string& name : parNames) {
+            auto par = params.getParam(name);
+            if (par->getType() == Parameters::SPIN)
+                par->addListener(Evaluate::updateEvalParams, false);
+        }
+    }
 }
 
 ComputerPlayer::ComputerPlayer()
@@ -97,13 +196,13 @@ ComputerPlayer::getCommand(const Position& posIn, bool drawOffer, const std::vec
     TreeLogger treeLog;
     Notifier notifier;
     ThreadCommunicator comm(nullptr, tt, notifier, false);
+    et->updateSize();
     Search::SearchTables st(comm.getCTT(), kt, ht, *et);
     Search sc(pos, posHashList, posHashListSize, st, comm, treeLog);
 
     // Determine all legal moves
     MoveList moves;
-    MoveGen::pseudoLegalMoves(pos, moves);
-    MoveGen::removeIllegal(pos, moves);
+    MoveGen::legalMoves(pos, moves);
     sc.scoreMoveList(moves, 0);
 
     // Test for "game over"
@@ -185,13 +284,13 @@ ComputerPlayer::searchPosition(Position& pos, int maxTimeMillis) {
     TreeLogger treeLog;
     Notifier notifier;
     ThreadCommunicator comm(nullptr, tt, notifier, false);
+    et->updateSize();
     Search::SearchTables st(comm.getCTT(), kt, ht, *et);
     Search sc(pos, posHashList, 0, st, comm, treeLog);
 
     // Determine all legal moves
     MoveList moves;
-    MoveGen::pseudoLegalMoves(pos, moves);
-    MoveGen::removeIllegal(pos, moves);
+    MoveGen::legalMoves(pos, moves);
     sc.scoreMoveList(moves, 0);
 
     // Find best move using iterative deepening
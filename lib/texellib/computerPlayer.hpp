@@ -70,6 +70,10 @@ public:
     /** Performs initialization that must happen after static initialization. */
     static void initEngine();
 
+    /** Return the build options used when compiling the engine, as a
+     *  space separated list of "name=value" pairs. */
+    static std::string buildOptions();
+
 private:
     /** Check if a draw claim is allowed, possibly after playing "move".
      * @param move The move that may have to be made before claiming draw.
@@ -40,6 +40,8 @@ namespace SearchConst {
     const int MAX_SEARCH_DEPTH = 100;
 
     const int MAX_CLUSTER_BUF_SIZE = 8192; // Max size of cluster message
+
+    const int PREFETCH_DISTANCE = 4; // Number of moves to prefetch ahead when PREFETCH_PIPELINE is defined
 }
 
 namespace TType {
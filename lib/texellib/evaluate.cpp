@@ -27,7 +27,9 @@
 #include "endGameEval.hpp"
 #include "constants.hpp"
 #include "parameters.hpp"
+#include "util/random.hpp"
 #include <vector>
+#include <algorithm>
 
 int Evaluate::pieceValueOrder[Piece::nPieceTypes] = {
     0,
@@ -127,6 +129,10 @@ Evaluate::updateEvalParams() {
             knightMobScoreA[sq][m] = knightMobScore[offs + std::min(m, maxMob)];
         }
     }
+
+    // Material table
+    std::lock_guard<std::mutex> L(materialTableMutex);
+    materialTableDirty = true;
 }
 
 const int* Evaluate::psTab1[Piece::nPieceTypes];
@@ -134,40 +140,153 @@ const int* Evaluate::psTab2[Piece::nPieceTypes];
 
 int Evaluate::knightMobScoreA[64][9];
 
+std::shared_ptr<const Evaluate::MaterialTable> Evaluate::materialTableShared;
+bool Evaluate::materialTableDirty = true;
+std::mutex Evaluate::materialTableMutex;
+
 Evaluate::Evaluate(EvalHashTables& et)
     : pawnHash(et.pawnHash),
-      materialHash(et.materialHash),
+      materialTableRef(getMaterialTable()),
+      materialTable(materialTableRef->data()),
       kingSafetyHash(et.kingSafetyHash),
       evalHash(et.evalHash),
+      sharedHash(et.shared.get()),
       wKingZone(0), bKingZone(0),
       wKingAttacks(0), bKingAttacks(0),
       wAttacksBB(0), bAttacksBB(0),
       wPawnAttacks(0), bPawnAttacks(0),
-      whiteContempt(0) {
+      whiteContempt(0), useEvalHash(true) {
 }
 
 int
 Evaluate::evalPos(const Position& pos) {
-    return evalPos<false>(pos);
+    if (pos.isWhiteMove())
+        return evalPos<false, true, false>(pos, 0, 0);
+    else
+        return evalPos<false, false, false>(pos, 0, 0);
 }
 
 int
 Evaluate::evalPosPrint(const Position& pos) {
-    return evalPos<true>(pos);
+    if (pos.isWhiteMove())
+        return evalPos<true, true, false>(pos, 0, 0);
+    else
+        return evalPos<true, false, false>(pos, 0, 0);
+}
+
+int
+Evaluate::evalPos(const Position& pos, int alpha, int beta) {
+    if (pos.isWhiteMove())
+        return evalPos<false, true, true>(pos, alpha, beta);
+    else
+        return evalPos<false, false, true>(pos, alpha, beta);
+}
+
+/** Hash key of the pawn structure in a serialized position. */
+static U64
+serializedPawnKey(const Position::SerializeData& data) {
+    const U64 ones = 0x1111111111111111ULL;
+    U64 key = 0;
+    for (int i = 0; i < 4; i++) {
+        const U64 v = data.v[i];
+        // Set bit 0 in each 4-bit square value equal to WPAWN/BPAWN
+        const U64 w = v ^ (Piece::WPAWN * ones);
+        const U64 b = v ^ (Piece::BPAWN * ones);
+        const U64 wp = ~(w | (w >> 1) | (w >> 2) | (w >> 3)) & ones;
+        const U64 bp = ~(b | (b >> 1) | (b >> 2) | (b >> 3)) & ones;
+        key = hashU64(key + (wp | (bp << 1)));
+    }
+    return key;
+}
+
+void
+Evaluate::batchOrder(const Position::SerializeData* data, int n,
+                     std::vector<int>& order) {
+    std::vector<std::pair<U64,int>> keys(n);
+    for (int i = 0; i < n; i++)
+        keys[i] = std::make_pair(serializedPawnKey(data[i]), i);
+    std::sort(keys.begin(), keys.end());
+    order.resize(n);
+    for (int i = 0; i < n; i++)
+        order[i] = keys[i].second;
+}
+
+void
+Evaluate::evalBatch(const Position::SerializeData* data, int n, int* out) {
+    std::vector<int> order;
+    batchOrder(data, n, order);
+    const bool oldUseEvalHash = useEvalHash;
+    useEvalHash = false;
+    Position pos;
+    for (int idx : order) {
+        pos.deSerialize(data[idx]);
+        int score = evalPos(pos);
+        out[idx] = pos.isWhiteMove() ? score : -score;
+    }
+    useEvalHash = oldUseEvalHash;
 }
 
 template <bool print>
 inline int
-Evaluate::evalPos(const Position& pos) {
-    const bool useHashTable = !print;
+Evaluate::scaleScore(const Position& pos, int score) const {
+    if ((whiteContempt != 0) && !mhd->endGame) {
+        int mtrlPawns = pos.wMtrlPawns() + pos.bMtrlPawns();
+        int mtrl = pos.wMtrl() + pos.bMtrl();
+        int hiMtrl = (rV + bV*2 + nV*2) * 2;
+        int piecePlay = interpolate(mtrl - mtrlPawns, 0, 64, hiMtrl, 128);
+        score += whiteContempt * piecePlay / 128;
+        if (print) std::cout << "info string eval contemp:" << score << ' ' << piecePlay << std::endl;
+    }
+    if (pos.pieceTypeBB(Piece::WPAWN, Piece::BPAWN)) {
+        int hmc = clamp(pos.getHalfMoveClock() / 10, 0, 9);
+        score = score * halfMoveFactor[hmc] / 128;
+    }
+    if (print) std::cout << "info string eval halfmove:" << score << std::endl;
+    if (score > 0) {
+        int nStale = BitBoard::bitCount(BitBoard::southFill(phd->stalePawns & pos.pieceTypeBB(Piece::WPAWN)) & 0xff);
+        score = score * stalePawnFactor[nStale] / 128;
+    } else if (score < 0) {
+        int nStale = BitBoard::bitCount(BitBoard::southFill(phd->stalePawns & pos.pieceTypeBB(Piece::BPAWN)) & 0xff);
+        score = score * stalePawnFactor[nStale] / 128;
+    }
+    if (print) std::cout << "info string eval staleP :" << score << std::endl;
+
+    return score;
+}
+
+template <bool print, bool wtm, bool lazy>
+inline int
+Evaluate::evalPos(const Position& pos, int alpha, int beta) {
+    const bool useHashTable = !print && useEvalHash;
     EvalHashData* ehd = nullptr;
     U64 key = pos.historyHash();
+#ifdef HAS_NNUE
+    const bool nnue = NNUE::isActive();
+    if (nnue) // Don't mix scores from different evaluation functions
+        key ^= hashU64(NNUE::currentNetId());
+#endif
     if (useHashTable) {
         ehd = &getEvalHashEntry(key);
-        if ((ehd->data ^ key) < (1 << 16))
+        if ((ehd->data ^ key) < (1 << 16)) {
+            hashStats.add(SearchStats::EVAL_HASH_HITS);
             return (ehd->data & 0xffff) - (1 << 15);
+        }
+        hashStats.add(SearchStats::EVAL_HASH_MISSES);
+        if (SearchStats::enabled && ehd->data != EvalHashData().data)
+            hashStats.add(SearchStats::EVAL_HASH_OVERWRITES);
     }
 
+#ifdef HAS_NNUE
+    if (nnue) {
+        int score = NNUE::evaluate(nnueStack->get(pos), wtm);
+        if (print) std::cout << "info string eval nnue   :" << score << std::endl;
+        score = clamp(score, -(SearchConst::MATE0 / 2), SearchConst::MATE0 / 2);
+        if (useHashTable)
+            ehd->data = (key & 0xffffffffffff0000ULL) + (score + (1 << 15));
+        return score;
+    }
+#endif
+
     int score = materialScore(pos, print);
 
     wKingAttacks = bKingAttacks = 0;
@@ -182,8 +301,33 @@ Evaluate::evalPos(const Position& pos) {
 
     score += pieceSquareEval(pos);
     if (print) std::cout << "info string eval pst    :" << score << std::endl;
-    score += pawnBonus(pos);
+    score += pawnBonus<wtm>(pos);
     if (print) std::cout << "info string eval pawn   :" << score << std::endl;
+
+    if (lazy && !mhd->endGame) {
+        // The remaining terms are small compared to the margin, except in
+        // end games and when the opposite colored bishops scaling can apply.
+        const bool oppoBishops = pos.pieceTypeBB(Piece::WBISHOP) && pos.pieceTypeBB(Piece::BBISHOP) &&
+                                 (pos.wMtrl() - pos.wMtrlPawns() == pos.bMtrl() - pos.bMtrlPawns());
+        if (!oppoBishops) {
+            const int margin = interpolate(lazyEvalMarginEG, lazyEvalMarginMG, mhd->kingSafetyIPF);
+            const int tempo = interpolate(tempoBonusEG, tempoBonusMG, mhd->kingSafetyIPF);
+            int lo = scaleScore<false>(pos, score - margin);
+            int hi = scaleScore<false>(pos, score + margin);
+            if (!wtm) {
+                std::swap(lo, hi);
+                lo = -lo;
+                hi = -hi;
+            }
+            lo += tempo;
+            hi += tempo;
+            if (hi <= alpha)
+                return hi;
+            if (lo >= beta)
+                return lo;
+        }
+    }
+
     score += castleBonus(pos);
     if (print) std::cout << "info string eval castle :" << score << std::endl;
 
@@ -202,29 +346,8 @@ Evaluate::evalPos(const Position& pos) {
     if (mhd->endGame)
         score = EndGameEval::endGameEval<true>(pos, phd->passedPawns, score);
     if (print) std::cout << "info string eval endgame:" << score << std::endl;
-    if ((whiteContempt != 0) && !mhd->endGame) {
-        int mtrlPawns = pos.wMtrlPawns() + pos.bMtrlPawns();
-        int mtrl = pos.wMtrl() + pos.bMtrl();
-        int hiMtrl = (rV + bV*2 + nV*2) * 2;
-        int piecePlay = interpolate(mtrl - mtrlPawns, 0, 64, hiMtrl, 128);
-        score += whiteContempt * piecePlay / 128;
-        if (print) std::cout << "info string eval contemp:" << score << ' ' << piecePlay << std::endl;
-    }
-    if (pos.pieceTypeBB(Piece::WPAWN, Piece::BPAWN)) {
-        int hmc = clamp(pos.getHalfMoveClock() / 10, 0, 9);
-        score = score * halfMoveFactor[hmc] / 128;
-    }
-    if (print) std::cout << "info string eval halfmove:" << score << std::endl;
-    if (score > 0) {
-        int nStale = BitBoard::bitCount(BitBoard::southFill(phd->stalePawns & pos.pieceTypeBB(Piece::WPAWN)) & 0xff);
-        score = score * stalePawnFactor[nStale] / 128;
-    } else if (score < 0) {
-        int nStale = BitBoard::bitCount(BitBoard::southFill(phd->stalePawns & pos.pieceTypeBB(Piece::BPAWN)) & 0xff);
-        score = score * stalePawnFactor[nStale] / 128;
-    }
-    if (print) std::cout << "info string eval staleP :" << score << std::endl;
-
-    if (!pos.isWhiteMove())
+    score = scaleScore<print>(pos, score);
+    if (!wtm)
         score = -score;
 
     // Tempo bonus
@@ -252,8 +375,62 @@ static inline int correctionNvsQ(int n, int q) {
     return corr;
 }
 
+/** Add the pieces for one side of a materialTable index to pos. Pieces are
+ *  placed on their initial squares, since the material score only depends
+ *  on the number of pieces of each type. */
+static void
+setMaterialSide(Position& pos, int idx, bool white) {
+    const int p = idx % 9; idx /= 9;
+    const int r = idx % 3; idx /= 3;
+    const int n = idx % 3; idx /= 3;
+    const int b = idx % 3; idx /= 3;
+    const int q = idx;
+    const int y1 = white ? 0 : 7;
+    const int y2 = white ? 1 : 6;
+    auto piece = [white](int pc) { return white ? pc : Piece::makeBlack(pc); };
+    pos.setPiece(Square::getSquare(4, y1), piece(Piece::WKING));
+    if (q > 0) pos.setPiece(Square::getSquare(3, y1), piece(Piece::WQUEEN));
+    if (r > 0) pos.setPiece(Square::getSquare(0, y1), piece(Piece::WROOK));
+    if (r > 1) pos.setPiece(Square::getSquare(7, y1), piece(Piece::WROOK));
+    if (n > 0) pos.setPiece(Square::getSquare(1, y1), piece(Piece::WKNIGHT));
+    if (n > 1) pos.setPiece(Square::getSquare(6, y1), piece(Piece::WKNIGHT));
+    if (b > 0) pos.setPiece(Square::getSquare(2, y1), piece(Piece::WBISHOP));
+    if (b > 1) pos.setPiece(Square::getSquare(5, y1), piece(Piece::WBISHOP));
+    for (int x = 0; x < p; x++)
+        pos.setPiece(Square::getSquare(x, y2), piece(Piece::WPAWN));
+}
+
+std::shared_ptr<const Evaluate::MaterialTable>
+Evaluate::getMaterialTable() {
+    std::lock_guard<std::mutex> L(materialTableMutex);
+    if (materialTableDirty) {
+        materialTableShared = computeMaterialTable();
+        materialTableDirty = false;
+    }
+    return materialTableShared;
+}
+
+std::shared_ptr<const Evaluate::MaterialTable>
+Evaluate::computeMaterialTable() {
+    auto tablePtr = std::make_shared<MaterialTable>(nMaterialSide * nMaterialSide);
+    MaterialTable& table = *tablePtr;
+    for (int w = 0; w < nMaterialSide; w++) {
+        Position wPos;
+        setMaterialSide(wPos, w, true);
+        for (int b = 0; b < nMaterialSide; b++) {
+            Position pos(wPos);
+            setMaterialSide(pos, b, false);
+            const int idx = w * nMaterialSide + b;
+            assert(materialTableIndex(pos.materialId()) == idx);
+            computeMaterialScore(pos, table[idx], false);
+        }
+    }
+
+    return tablePtr;
+}
+
 void
-Evaluate::computeMaterialScore(const Position& pos, MaterialHashData& mhd, bool print) const {
+Evaluate::computeMaterialScore(const Position& pos, MaterialHashData& mhd, bool print) {
     // Compute material part of score
     int score = pos.wMtrl() - pos.bMtrl();
     if (print) std::cout << "info string eval mtrlraw:" << score << std::endl;
@@ -384,7 +561,7 @@ Evaluate::computeMaterialScore(const Position& pos, MaterialHashData& mhd, bool
 }
 
 int
-Evaluate::tradeBonus(const Position& pos, int wCorr, int bCorr) const {
+Evaluate::tradeBonus(const Position& pos, int wCorr, int bCorr) {
     const int wM = pos.wMtrl() + wCorr;
     const int bM = pos.bMtrl() + bCorr;
     const int wPawn = pos.wMtrlPawns();
@@ -498,12 +675,25 @@ Evaluate::castleBonus(const Position& pos) {
     return wBonus - bBonus;
 }
 
+template <bool wtm>
 int
 Evaluate::pawnBonus(const Position& pos) {
     U64 key = pos.pawnZobristHash();
     PawnHashData& phd = getPawnHashEntry(key);
-    if (phd.key != key)
-        computePawnHashData(pos, phd);
+    if (phd.key != key) {
+        hashStats.add(SearchStats::PAWN_HASH_MISSES);
+        if (phd.key != PawnHashData().key)
+            hashStats.add(SearchStats::PAWN_HASH_OVERWRITES);
+        if (sharedHash && probeSharedPawnHash(key, phd)) {
+            hashStats.add(SearchStats::SHARED_PAWN_HASH_HITS);
+        } else {
+            computePawnHashData(pos, phd);
+            if (sharedHash)
+                storeSharedPawnHash(phd);
+        }
+    } else {
+        hashStats.add(SearchStats::PAWN_HASH_HITS);
+    }
     this->phd = &phd;
     int score = phd.score;
 
@@ -612,7 +802,7 @@ Evaluate::pawnBonus(const Position& pos) {
                 int kScore = kingDist * 4;
                 if (kingDist > pawnDist) kScore += (kingDist - pawnDist) * (kingDist - pawnDist);
                 score += interpolate(kScore, 0, mhd->wPassedPawnIPF);
-                if (!pos.isWhiteMove())
+                if (!wtm)
                     kingDist--;
                 if ((pawnDist < kingDist) && (mtrlNoPawns == 0)) {
                     if (BitBoard::northFill(1ULL<<sq) & (1LL << pos.getKingSq(true)))
@@ -641,7 +831,7 @@ Evaluate::pawnBonus(const Position& pos) {
                 int kScore = kingDist * 4;
                 if (kingDist > pawnDist) kScore += (kingDist - pawnDist) * (kingDist - pawnDist);
                 score -= interpolate(kScore, 0, mhd->bPassedPawnIPF);
-                if (pos.isWhiteMove())
+                if (wtm)
                     kingDist--;
                 if ((pawnDist < kingDist) && (mtrlNoPawns == 0)) {
                     if (BitBoard::southFill(1ULL<<sq) & (1LL << pos.getKingSq(false)))
@@ -659,8 +849,8 @@ Evaluate::pawnBonus(const Position& pos) {
     const int prBonus = pawnRaceBonus;
     if (bestWPromSq >= 0) {
         if (bestBPromSq >= 0) {
-            int wPly = bestWPawnDist * 2; if (pos.isWhiteMove()) wPly--;
-            int bPly = bestBPawnDist * 2; if (!pos.isWhiteMove()) bPly--;
+            int wPly = bestWPawnDist * 2; if (wtm) wPly--;
+            int bPly = bestBPawnDist * 2; if (!wtm) bPly--;
             if (wPly < bPly - 1) {
                 score += prBonus;
             } else if (wPly == bPly - 1) {
@@ -1293,7 +1483,17 @@ int
 Evaluate::kingSafetyKPPart(const Position& pos) {
     const U64 key = pos.pawnZobristHash() ^ pos.kingZobristHash();
     KingSafetyHashData& ksh = getKingSafetyHashEntry(key);
-    if (ksh.key != key) {
+    if (ksh.key == key) {
+        hashStats.add(SearchStats::KS_HASH_HITS);
+    } else {
+        hashStats.add(SearchStats::KS_HASH_MISSES);
+        if (ksh.key != KingSafetyHashData().key)
+            hashStats.add(SearchStats::KS_HASH_OVERWRITES);
+        if (sharedHash && sharedHash->probeKingSafety(key, ksh.score)) {
+            hashStats.add(SearchStats::SHARED_KS_HASH_HITS);
+            ksh.key = key;
+            return ksh.score;
+        }
         int score = 0;
         const U64 wPawns = pos.pieceTypeBB(Piece::WPAWN);
         const U64 bPawns = pos.pieceTypeBB(Piece::BPAWN);
@@ -1396,10 +1596,85 @@ Evaluate::kingSafetyKPPart(const Position& pos) {
 
         ksh.key = key;
         ksh.score = score;
+        if (sharedHash)
+            sharedHash->storeKingSafety(key, score);
     }
     return ksh.score;
 }
 
+bool
+Evaluate::probeSharedPawnHash(U64 key, PawnHashData& ph) const {
+    U64 data[SharedEvalHash::nPawnData];
+    if (!sharedHash->probePawn(key, data))
+        return false;
+    ph.key = key;
+    ph.score = (S16)(data[0] & 0xffff);
+    ph.passedBonusW = (S16)((data[0] >> 16) & 0xffff);
+    ph.passedBonusB = (S16)((data[0] >> 32) & 0xffff);
+    ph.passedPawns = data[1];
+    ph.outPostsW = data[2];
+    ph.outPostsB = data[3];
+    ph.stalePawns = data[4];
+    return true;
+}
+
+void
+Evaluate::storeSharedPawnHash(const PawnHashData& ph) {
+    U64 data[SharedEvalHash::nPawnData];
+    data[0] = (U64)(U16)ph.score |
+              ((U64)(U16)ph.passedBonusW << 16) |
+              ((U64)(U16)ph.passedBonusB << 32);
+    data[1] = ph.passedPawns;
+    data[2] = ph.outPostsW;
+    data[3] = ph.outPostsB;
+    data[4] = ph.stalePawns;
+    sharedHash->storePawn(ph.key, data);
+}
+
+/** Return number of hash table entries corresponding to a UCI parameter.
+ *  The parameter is null if this is called during static initialization,
+ *  before UciParams have been created. Use the default size in that case. */
+static size_t
+hashEntries(const std::shared_ptr<Parameters::SpinParam>& par, int defaultEntries) {
+    int n = par ? par->getIntPar() : defaultEntries;
+    return (size_t)1 << floorLog2(n);
+}
+
+Evaluate::EvalHashTables::EvalHashTables() {
+    updateSize();
+}
+
+void
+Evaluate::EvalHashTables::clear() {
+    std::fill(pawnHash.begin(), pawnHash.end(), PawnHashData());
+    std::fill(kingSafetyHash.begin(), kingSafetyHash.end(), KingSafetyHashData());
+    std::fill(evalHash.begin(), evalHash.end(), EvalHashData());
+}
+
+void
+Evaluate::EvalHashTables::updateSize(int threadNo) {
+    shared = SharedEvalHash::instance().tablesForThread(threadNo);
+    // With shared tables, the per-thread tables only need to be large
+    // enough to hold the recently used entries
+    const size_t maxLocal = shared ? hashEntries(UciParams::sharedEvalHashLocalEntries, 1 << 12)
+                                   : (size_t)1 << 24;
+    size_t nPawn = std::min(hashEntries(UciParams::pawnHashEntries, 1 << 16), maxLocal);
+    if (pawnHash.size() != nPawn) {
+        pawnHash.clear();
+        pawnHash.resize(nPawn);
+    }
+    size_t nKingSafety = std::min(hashEntries(UciParams::kingSafetyHashEntries, 1 << 15), maxLocal);
+    if (kingSafetyHash.size() != nKingSafety) {
+        kingSafetyHash.clear();
+        kingSafetyHash.resize(nKingSafety);
+    }
+    size_t nEval = hashEntries(UciParams::evalHashEntries, 1 << 16);
+    if (evalHash.size() != nEval) {
+        evalHash.clear();
+        evalHash.resize(nEval);
+    }
+}
+
 std::unique_ptr<Evaluate::EvalHashTables>
 Evaluate::getEvalHashTables() {
     return make_unique<EvalHashTables>();
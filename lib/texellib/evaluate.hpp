@@ -28,8 +28,14 @@
 
 #include "piece.hpp"
 #include "position.hpp"
+#include "nnue.hpp"
+#include "searchStats.hpp"
+#include "sharedEvalHash.hpp"
 #include "util/alignedAlloc.hpp"
 
+#include <memory>
+#include <mutex>
+
 #if _MSC_VER
 #include <xmmintrin.h>
 #endif
@@ -81,14 +87,25 @@ private:
     };
 
 public:
+    /** Per thread hash tables used by the evaluation function. The table sizes
+     *  are controlled by the *HashEntries UCI parameters. */
     struct EvalHashTables {
         EvalHashTables();
+
+        /** Resize the tables if the UCI parameters have changed since the tables
+         *  were created. Resizing clears the tables. Also select the shared
+         *  tables to use for search thread threadNo. If shared tables are used,
+         *  the pawn and king safety tables are limited to
+         *  SharedEvalHashLocalEntries entries. */
+        void updateSize(int threadNo = 0);
+
+        /** Remove all entries. Needed if evaluation parameters have changed. */
+        void clear();
+
         std::vector<PawnHashData> pawnHash;
-        std::vector<MaterialHashData> materialHash;
         vector_aligned<KingSafetyHashData> kingSafetyHash;
-
-        using EvalHashType = std::array<EvalHashData,(1<<16)>;
-        EvalHashType evalHash;
+        std::vector<EvalHashData> evalHash;
+        std::shared_ptr<SharedEvalHash::Tables> shared; // Used on per-thread table misses if not null
     };
 
     /** Constructor. */
@@ -105,6 +122,11 @@ public:
     /** Prefetch hash table cache lines. */
     void prefetch(U64 key);
 
+    /** Get hash table hit/miss/overwrite counters. Only updated if
+     *  SEARCH_STATS is defined. */
+    const SearchStats& getHashStats() const;
+    void clearHashStats();
+
     /**
      * Static evaluation of a position.
      * @param pos The position to evaluate.
@@ -114,6 +136,39 @@ public:
     int evalPos(const Position& pos);
     int evalPosPrint(const Position& pos);
 
+    /**
+     * Static evaluation of a position, for use when only the relation to the
+     * (alpha,beta) window matters. The return value is exact if it is inside
+     * the window. Otherwise it can be a bound computed from a partial
+     * evaluation and a margin for the remaining terms. The margin is large
+     * enough that the bound is very rarely on the wrong side of the window.
+     */
+    int evalPos(const Position& pos, int alpha, int beta);
+
+    /**
+     * Static evaluation of many positions, for use by tuning tools. The
+     * positions are evaluated in batchOrder() order and the eval hash table
+     * is not used, since each position is normally only evaluated once.
+     * @param out Evaluation scores. Positive values are good for white.
+     */
+    void evalBatch(const Position::SerializeData* data, int n, int* out);
+
+    /** Compute an evaluation order for a batch of positions, where positions
+     *  with the same pawn structure are adjacent, to improve the pawn hash
+     *  table hit rate. */
+    static void batchOrder(const Position::SerializeData* data, int n,
+                           std::vector<int>& order);
+
+    /** Enable/disable use of the eval hash table. */
+    void setUseEvalHash(bool use);
+    /** Return true if the eval hash table is used. */
+    bool getUseEvalHash() const;
+
+    /** Get network accumulators from stack, which the caller keeps up to date
+     *  with the evaluated positions. If null, an internal stack is used, which
+     *  recomputes the accumulator when the position changes. */
+    void setNNUEStack(NNUE::AccumulatorStack* stack);
+
     void setWhiteContempt(int contempt);
     int getWhiteContempt() const;
 
@@ -137,10 +192,23 @@ public:
     static int interpolate(int v1, int v2, int k);
 
     static void staticInitialize();
+
+    /** Update tables that depend on evaluation parameters. Must be called
+     *  when an evaluation parameter has changed. The material table is not
+     *  rebuilt immediately. It is rebuilt when the next Evaluate object is
+     *  created. */
     static void updateEvalParams();
 
 private:
-    template <bool print> int evalPos(const Position& pos);
+    /** Static evaluation, specialized for the side to move. wtm must be
+     *  equal to pos.isWhiteMove(). If lazy is true, the evaluation can stop
+     *  early when the score is known to be outside the (alpha,beta) window. */
+    template <bool print, bool wtm, bool lazy>
+    int evalPos(const Position& pos, int alpha, int beta);
+
+    /** Apply contempt and the scale factors for the 50 move rule and for stale
+     *  pawns to a white POV score. The transformation is monotone. */
+    template <bool print> int scaleScore(const Position& pos, int score) const;
 
     EvalHashData& getEvalHashEntry(U64 key);
 
@@ -151,16 +219,29 @@ private:
     int materialScore(const Position& pos, bool print);
 
     /** Compute material score. */
-    void computeMaterialScore(const Position& pos, MaterialHashData& mhd, bool print) const;
+    static void computeMaterialScore(const Position& pos, MaterialHashData& mhd, bool print);
 
     /** Implement the "when ahead trade pieces, when behind trade pawns" rule. */
-    int tradeBonus(const Position& pos, int wCorr, int bCorr) const;
+    static int tradeBonus(const Position& pos, int wCorr, int bCorr);
+
+    /** Number of material configurations for one side in materialTable.
+     *  0-8 pawns, 0-2 rooks/knights/bishops, 0-1 queens. */
+    static const int nMaterialSide = 9 * 3 * 3 * 3 * 2;
+
+    /** Return materialTable index for one side, given the part of the
+     *  material id for that side, or -1 if not in the table. */
+    static int materialSideIndex(int sideId);
+
+    /** Return materialTable index for a material id, or -1 if the material
+     *  configuration is not in the table. */
+    static int materialTableIndex(int mId);
+
 
     /** Score castling ability. */
     int castleBonus(const Position& pos);
 
     PawnHashData& getPawnHashEntry(U64 key);
-    int pawnBonus(const Position& pos);
+    template <bool wtm> int pawnBonus(const Position& pos);
 
     /** Compute set of pawns that can not participate in "pawn breaks". */
     static U64 computeStalePawns(const Position& pos);
@@ -192,17 +273,46 @@ private:
     KingSafetyHashData& getKingSafetyHashEntry(U64 key);
     int kingSafetyKPPart(const Position& pos);
 
+    /** Get pawn hash data from the shared hash table. Return false if not found. */
+    bool probeSharedPawnHash(U64 key, PawnHashData& ph) const;
+    /** Store pawn hash data in the shared hash table. */
+    void storeSharedPawnHash(const PawnHashData& ph);
+
     static int castleMaskFactor[256];
     static int knightMobScoreA[64][9];
 
     std::vector<PawnHashData>& pawnHash;
     const PawnHashData* phd;
 
-    std::vector<MaterialHashData>& materialHash;
+    using MaterialTable = std::vector<MaterialHashData>;
+
+    /** Return the material table for the current evaluation parameters.
+     *  Rebuilds the table if the parameters have changed since it was built.
+     *  Rebuilding takes about 50ms, so this is only called when an Evaluate
+     *  object is created, never during search. */
+    static std::shared_ptr<const MaterialTable> getMaterialTable();
+
+    /** Compute the material table for the current evaluation parameters. */
+    static std::shared_ptr<const MaterialTable> computeMaterialTable();
+
+    /** Material data for all configurations without promoted pieces, indexed
+     *  by materialTableIndex(). Shared read-only by all Evaluate objects
+     *  created after the last parameter change. Older Evaluate objects keep
+     *  their own reference to the table they were created with. */
+    static std::shared_ptr<const MaterialTable> materialTableShared;
+    static bool materialTableDirty;    // True if parameters changed since the table was built
+    static std::mutex materialTableMutex;
+
+    std::shared_ptr<const MaterialTable> materialTableRef; // Keeps materialTable alive
+    const MaterialHashData* materialTable;
+
+    MaterialHashData extraMaterial; // Last material configuration not in materialTable
     const MaterialHashData* mhd;
 
     vector_aligned<KingSafetyHashData>& kingSafetyHash;
-    EvalHashTables::EvalHashType& evalHash;
+    std::vector<EvalHashData>& evalHash;
+    SharedEvalHash::Tables* sharedHash; // Owned by EvalHashTables::shared
+    SearchStats hashStats;
 
      // King safety variables
     U64 wKingZone, bKingZone;       // Squares close to king that are worth attacking
@@ -214,6 +324,12 @@ private:
     U64 wContactSupport, bContactSupport; // Attacks from P,N,B,R,K
 
     int whiteContempt; // Assume white is this many centipawns stronger than black
+    bool useEvalHash;
+
+#ifdef HAS_NNUE
+    NNUE::AccumulatorStack ownNNUEStack;
+    NNUE::AccumulatorStack* nnueStack = &ownNNUEStack;
+#endif
 };
 
 
@@ -241,13 +357,6 @@ Evaluate::EvalHashData::EvalHashData()
     : data(0xffffffffffff0000ULL) {
 }
 
-inline
-Evaluate::EvalHashTables::EvalHashTables() {
-    pawnHash.resize(1 << 16);
-    kingSafetyHash.resize(1 << 15);
-    materialHash.resize(1 << 14);
-}
-
 inline void
 Evaluate::prefetch(U64 key) {
 #ifdef HAS_PREFETCH
@@ -259,6 +368,33 @@ Evaluate::prefetch(U64 key) {
 #endif
 }
 
+inline const SearchStats&
+Evaluate::getHashStats() const {
+    return hashStats;
+}
+
+inline void
+Evaluate::clearHashStats() {
+    hashStats.clear();
+}
+
+inline void
+Evaluate::setUseEvalHash(bool use) {
+    useEvalHash = use;
+}
+
+inline bool
+Evaluate::getUseEvalHash() const {
+    return useEvalHash;
+}
+
+inline void
+Evaluate::setNNUEStack(NNUE::AccumulatorStack* stack) {
+#ifdef HAS_NNUE
+    nnueStack = stack ? stack : &ownNNUEStack;
+#endif
+}
+
 inline void
 Evaluate::setWhiteContempt(int contempt) {
     whiteContempt = contempt;
@@ -285,15 +421,52 @@ Evaluate::interpolate(int v1, int v2, int k) {
     return v1 + (v2 - v1) * k / IPOLMAX;
 }
 
+inline int
+Evaluate::materialSideIndex(int sideId) {
+    const int q = sideId / MatId::WQ;
+    sideId -= q * MatId::WQ;
+    const int b = sideId / MatId::WB;
+    sideId -= b * MatId::WB;
+    const int n = sideId / MatId::WN;
+    sideId -= n * MatId::WN;
+    const int r = sideId / MatId::WR;
+    const int p = sideId - r * MatId::WR;
+    if (q > 1 || b > 2 || n > 2 || r > 2)
+        return -1;
+    return (((q * 3 + b) * 3 + n) * 3 + r) * 9 + p;
+}
+
+inline int
+Evaluate::materialTableIndex(int mId) {
+    const int w = materialSideIndex(mId & 0xffff);
+    const int b = materialSideIndex((unsigned int)mId >> 16);
+    if (w < 0 || b < 0)
+        return -1;
+    return w * nMaterialSide + b;
+}
+
 inline int
 Evaluate::materialScore(const Position& pos, bool print) {
-    int mId = pos.materialId();
-    int key = (mId >> 16) * 40507 + mId;
-    MaterialHashData& newMhd = materialHash[key & (materialHash.size() - 1)];
-    if ((newMhd.id != mId) || print)
-        computeMaterialScore(pos, newMhd, print);
-    mhd = &newMhd;
-    return newMhd.score;
+    const int mId = pos.materialId();
+    if (!print) {
+        const int idx = materialTableIndex(mId);
+        if (idx >= 0) {
+            hashStats.add(SearchStats::MTRL_HASH_HITS);
+            mhd = &materialTable[idx];
+            return mhd->score;
+        }
+        if (extraMaterial.id == mId) {
+            hashStats.add(SearchStats::MTRL_HASH_HITS);
+        } else {
+            hashStats.add(SearchStats::MTRL_HASH_MISSES);
+            if (extraMaterial.id != -1)
+                hashStats.add(SearchStats::MTRL_HASH_OVERWRITES);
+        }
+    }
+    if ((extraMaterial.id != mId) || print)
+        computeMaterialScore(pos, extraMaterial, print);
+    mhd = &extraMaterial;
+    return extraMaterial.score;
 }
 
 inline Evaluate::PawnHashData&
@@ -53,6 +53,10 @@ public:
      */
     int getKillerScore(int ply, const Move& m) const;
 
+    /** Get the primary (idx = 0) or secondary (idx = 1) killer move at ply.
+     *  Returns an empty move if there is no such killer move. */
+    Move getKiller(int ply, int idx) const;
+
 private:
     /** There is one KTEntry for each ply in the search tree. */
     struct KTEntry {
@@ -98,4 +102,14 @@ KillerTable::getKillerScore(int ply, const Move& m) const {
     return 0;
 }
 
+inline Move
+KillerTable::getKiller(int ply, int idx) const {
+    Move m;
+    if (ply < (int)COUNT_OF(ktList)) {
+        const KTEntry& ent = ktList[ply];
+        m.setFromCompressed(idx == 0 ? ent.move0 : ent.move1);
+    }
+    return m;
+}
+
 #endif /* KILLERTABLE_HPP_ */
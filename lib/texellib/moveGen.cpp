@@ -140,6 +140,212 @@ MoveGen::pseudoLegalMoves(const Position& pos, MoveList& moveList) {
     }
 }
 
+template void MoveGen::legalMoves<true>(const Position& pos, MoveList& moveList);
+template void MoveGen::legalMoves<false>(const Position& pos, MoveList& moveList);
+
+template <bool wtm>
+void
+MoveGen::legalMoves(const Position& pos, MoveList& moveList) {
+    using MyColor = ColorTraits<wtm>;
+    using OtherColor = ColorTraits<!wtm>;
+    const U64 occupied = pos.occupiedBB();
+    const U64 oppPieces = pos.colorBB(!wtm);
+    const int kingSq = pos.getKingSq(wtm);
+    const U64 oppRooks = pos.pieceTypeBB(OtherColor::ROOK, OtherColor::QUEEN);
+    const U64 oppBishops = pos.pieceTypeBB(OtherColor::BISHOP, OtherColor::QUEEN);
+
+    // Squares non-king moves must go to. All squares not occupied by own
+    // pieces if not in check, the checking piece and the squares between
+    // it and the king if in single check, no squares if in double check.
+    U64 kingThreats = pos.pieceTypeBB(OtherColor::KNIGHT) & BitBoard::knightAttacks(kingSq);
+    kingThreats |= oppRooks & BitBoard::rookAttacks(kingSq, occupied);
+    kingThreats |= oppBishops & BitBoard::bishopAttacks(kingSq, occupied);
+    const U64 myPawnAttacks = wtm ? BitBoard::wPawnAttacks(kingSq) : BitBoard::bPawnAttacks(kingSq);
+    kingThreats |= pos.pieceTypeBB(OtherColor::PAWN) & myPawnAttacks;
+    U64 validTargets = ~pos.colorBB(wtm);
+    if (kingThreats != 0) {
+        if ((kingThreats & (kingThreats-1)) == 0) {
+            int threatSq = BitBoard::firstSquare(kingThreats);
+            validTargets = kingThreats | BitBoard::squaresBetween(kingSq, threatSq);
+        } else {
+            validTargets = 0;
+        }
+    }
+
+    // Pinned pieces. A pinned piece can only move to the squares between
+    // the king and the pinning piece, or capture the pinning piece.
+    U64 pinned = 0;
+    int nPins = 0;
+    int pinSq[8];
+    U64 pinRay[8];
+    U64 pinners = (BitBoard::rookAttacks(kingSq, oppPieces) & oppRooks) |
+                  (BitBoard::bishopAttacks(kingSq, oppPieces) & oppBishops);
+    while (pinners != 0) {
+        int sq = BitBoard::extractSquare(pinners);
+        U64 between = BitBoard::squaresBetween(kingSq, sq);
+        U64 blockers = between & occupied;
+        if ((blockers != 0) && ((blockers & (blockers-1)) == 0) && (blockers & pos.colorBB(wtm))) {
+            pinned |= blockers;
+            pinSq[nPins] = BitBoard::firstSquare(blockers);
+            pinRay[nPins] = between | (1ULL << sq);
+            nPins++;
+        }
+    }
+    auto pinMask = [&](int sq) -> U64 {
+        for (int i = 0; i < nPins; i++)
+            if (pinSq[i] == sq)
+                return pinRay[i];
+        return ~0ULL;
+    };
+
+    // Queen moves
+    U64 squares = pos.pieceTypeBB(MyColor::QUEEN);
+    while (squares != 0) {
+        int sq = BitBoard::extractSquare(squares);
+        U64 m = (BitBoard::rookAttacks(sq, occupied) | BitBoard::bishopAttacks(sq, occupied)) & validTargets;
+        if (pinned & (1ULL << sq))
+            m &= pinMask(sq);
+        addMovesByMask(moveList, sq, m);
+    }
+
+    // Rook moves
+    squares = pos.pieceTypeBB(MyColor::ROOK);
+    while (squares != 0) {
+        int sq = BitBoard::extractSquare(squares);
+        U64 m = BitBoard::rookAttacks(sq, occupied) & validTargets;
+        if (pinned & (1ULL << sq))
+            m &= pinMask(sq);
+        addMovesByMask(moveList, sq, m);
+    }
+
+    // Bishop moves
+    squares = pos.pieceTypeBB(MyColor::BISHOP);
+    while (squares != 0) {
+        int sq = BitBoard::extractSquare(squares);
+        U64 m = BitBoard::bishopAttacks(sq, occupied) & validTargets;
+        if (pinned & (1ULL << sq))
+            m &= pinMask(sq);
+        addMovesByMask(moveList, sq, m);
+    }
+
+    // King moves
+    {
+        const U64 occupiedNoKing = occupied & ~(1ULL << kingSq);
+        U64 m = BitBoard::kingAttacks(kingSq) & ~pos.colorBB(wtm);
+        while (m != 0) {
+            int sq = BitBoard::extractSquare(m);
+            if (!sqAttacked<wtm>(pos, sq, occupiedNoKing))
+                moveList.addMove(kingSq, sq, Piece::EMPTY);
+        }
+        const int k0 = wtm ? E1 : E8;
+        if ((kingSq == k0) && (kingThreats == 0)) {
+            const U64 OO_SQ = wtm ? BitBoard::sqMask(F1,G1) : BitBoard::sqMask(F8,G8);
+            const U64 OOO_SQ = wtm ? BitBoard::sqMask(B1,C1,D1) : BitBoard::sqMask(B8,C8,D8);
+            const int hCastle = wtm ? Position::H1_CASTLE : Position::H8_CASTLE;
+            const int aCastle = wtm ? Position::A1_CASTLE : Position::A8_CASTLE;
+            if (((pos.getCastleMask() & (1 << hCastle)) != 0) &&
+                ((OO_SQ & occupied) == 0) &&
+                (pos.getPiece(k0 + 3) == MyColor::ROOK) &&
+                !sqAttacked<wtm>(pos, k0 + 1, occupied) &&
+                !sqAttacked<wtm>(pos, k0 + 2, occupied)) {
+                moveList.addMove(k0, k0 + 2, Piece::EMPTY);
+            }
+            if (((pos.getCastleMask() & (1 << aCastle)) != 0) &&
+                ((OOO_SQ & occupied) == 0) &&
+                (pos.getPiece(k0 - 4) == MyColor::ROOK) &&
+                !sqAttacked<wtm>(pos, k0 - 1, occupied) &&
+                !sqAttacked<wtm>(pos, k0 - 2, occupied)) {
+                moveList.addMove(k0, k0 - 2, Piece::EMPTY);
+            }
+        }
+    }
+
+    // Knight moves. A pinned knight can not move.
+    U64 knights = pos.pieceTypeBB(MyColor::KNIGHT) & ~pinned;
+    while (knights != 0) {
+        int sq = BitBoard::extractSquare(knights);
+        U64 m = BitBoard::knightAttacks(sq) & validTargets;
+        addMovesByMask(moveList, sq, m);
+    }
+
+    // Pawn moves. A pinned pawn can only move in the direction of the pin.
+    const U64 pawns = pos.pieceTypeBB(MyColor::PAWN);
+    U64 pushPawns = pawns, capt7Pawns = pawns, capt9Pawns = pawns;
+    U64 pinnedPawns = pawns & pinned;
+    while (pinnedPawns != 0) {
+        int sq = BitBoard::extractSquare(pinnedPawns);
+        const U64 mask = ~(1ULL << sq);
+        switch (std::abs(BitBoard::getDirection(kingSq, sq))) {
+        case 8: capt7Pawns &= mask; capt9Pawns &= mask; break;
+        case 7: pushPawns &= mask;  capt9Pawns &= mask; break;
+        case 9: pushPawns &= mask;  capt7Pawns &= mask; break;
+        default: pushPawns &= mask; capt7Pawns &= mask; capt9Pawns &= mask; break;
+        }
+    }
+
+    // En passant captures remove two pawns from the board, so check for
+    // discovered attacks on the king explicitly
+    const int epSquare = pos.getEpSquare();
+    U64 epMask = (epSquare >= 0) ? (1ULL << epSquare) : 0ULL;
+    auto epLegal = [&](int fromSq) -> bool {
+        const U64 captMask = 1ULL << (epSquare + (wtm ? -8 : 8));
+        if ((validTargets & (epMask | captMask)) == 0)
+            return false;
+        U64 occ = (occupied & ~(1ULL << fromSq) & ~captMask) | epMask;
+        return ((BitBoard::rookAttacks(kingSq, occ) & oppRooks) == 0) &&
+               ((BitBoard::bishopAttacks(kingSq, occ) & oppBishops) == 0);
+    };
+    const U64 captTargets = oppPieces & validTargets;
+    if (wtm) {
+        U64 m = (pushPawns << 8) & ~occupied;
+        addPawnMovesByMask<wtm>(moveList, m & validTargets, -8, true);
+        m = ((m & BitBoard::maskRow3) << 8) & ~occupied;
+        addPawnDoubleMovesByMask(moveList, m & validTargets, -16);
+
+        U64 ep = (pawns << 7) & BitBoard::maskAToGFiles & epMask;
+        if (ep && !epLegal(epSquare - 7))
+            ep = 0;
+        m = (capt7Pawns << 7) & BitBoard::maskAToGFiles & captTargets;
+        addPawnMovesByMask<wtm>(moveList, m | ep, -7, true);
+
+        ep = (pawns << 9) & BitBoard::maskBToHFiles & epMask;
+        if (ep && !epLegal(epSquare - 9))
+            ep = 0;
+        m = (capt9Pawns << 9) & BitBoard::maskBToHFiles & captTargets;
+        addPawnMovesByMask<wtm>(moveList, m | ep, -9, true);
+    } else {
+        U64 m = (pushPawns >> 8) & ~occupied;
+        addPawnMovesByMask<wtm>(moveList, m & validTargets, 8, true);
+        m = ((m & BitBoard::maskRow6) >> 8) & ~occupied;
+        addPawnDoubleMovesByMask(moveList, m & validTargets, 16);
+
+        U64 ep = (pawns >> 9) & BitBoard::maskAToGFiles & epMask;
+        if (ep && !epLegal(epSquare + 9))
+            ep = 0;
+        m = (capt9Pawns >> 9) & BitBoard::maskAToGFiles & captTargets;
+        addPawnMovesByMask<wtm>(moveList, m | ep, 9, true);
+
+        ep = (pawns >> 7) & BitBoard::maskBToHFiles & epMask;
+        if (ep && !epLegal(epSquare + 7))
+            ep = 0;
+        m = (capt7Pawns >> 7) & BitBoard::maskBToHFiles & captTargets;
+        addPawnMovesByMask<wtm>(moveList, m | ep, 7, true);
+    }
+
+#ifdef MOVELIST_DEBUG
+    {
+        // Extra check that exactly the legal moves were generated
+        MoveList allMoves;
+        pseudoLegalMoves(pos, allMoves);
+        Position tmpPos(pos);
+        removeIllegal(tmpPos, allMoves);
+        assert(allMoves.size == moveList.size);
+        for (int i = 0; i < moveList.size; i++)
+            assert(allMoves[i] == moveList[i]);
+    }
+#endif
+}
+
 template void MoveGen::checkEvasions<true>(const Position& pos, MoveList& moveList);
 template void MoveGen::checkEvasions<false>(const Position& pos, MoveList& moveList);
 
@@ -651,3 +857,91 @@ MoveGen::isLegal(Position& pos, const Move& m, bool isInCheck) {
         }
     }
 }
+
+bool
+MoveGen::isPseudoLegal(const Position& pos, const Move& m) {
+    const int from = m.from();
+    const int to = m.to();
+    if (from == to)
+        return false;
+    const bool wtm = pos.isWhiteMove();
+    const int p = pos.getPiece(from);
+    if ((p == Piece::EMPTY) || (Piece::isWhite(p) != wtm))
+        return false;
+    const U64 toMask = 1ULL << to;
+    if (pos.colorBB(wtm) & toMask)
+        return false;
+    const U64 occupied = pos.occupiedBB();
+    const int promoteTo = m.promoteTo();
+
+    switch (Piece::makeWhite(p)) {
+    case Piece::WKING: {
+        if (promoteTo != Piece::EMPTY)
+            return false;
+        if (BitBoard::kingAttacks(from) & toMask)
+            return true;
+        const int k0 = wtm ? E1 : E8;
+        if (from != k0)
+            return false;
+        if (to == k0 + 2) {
+            const U64 OO_SQ = wtm ? BitBoard::sqMask(F1,G1) : BitBoard::sqMask(F8,G8);
+            const int hCastle = wtm ? Position::H1_CASTLE : Position::H8_CASTLE;
+            return ((pos.getCastleMask() & (1 << hCastle)) != 0) &&
+                   ((OO_SQ & occupied) == 0) &&
+                   (pos.getPiece(k0 + 3) == (wtm ? Piece::WROOK : Piece::BROOK)) &&
+                   !sqAttacked(pos, k0) &&
+                   !sqAttacked(pos, k0 + 1);
+        }
+        if (to == k0 - 2) {
+            const U64 OOO_SQ = wtm ? BitBoard::sqMask(B1,C1,D1) : BitBoard::sqMask(B8,C8,D8);
+            const int aCastle = wtm ? Position::A1_CASTLE : Position::A8_CASTLE;
+            return ((pos.getCastleMask() & (1 << aCastle)) != 0) &&
+                   ((OOO_SQ & occupied) == 0) &&
+                   (pos.getPiece(k0 - 4) == (wtm ? Piece::WROOK : Piece::BROOK)) &&
+                   !sqAttacked(pos, k0) &&
+                   !sqAttacked(pos, k0 - 1);
+        }
+        return false;
+    }
+    case Piece::WQUEEN:
+        return (promoteTo == Piece::EMPTY) &&
+               (((BitBoard::rookAttacks(from, occupied) |
+                  BitBoard::bishopAttacks(from, occupied)) & toMask) != 0);
+    case Piece::WROOK:
+        return (promoteTo == Piece::EMPTY) &&
+               ((BitBoard::rookAttacks(from, occupied) & toMask) != 0);
+    case Piece::WBISHOP:
+        return (promoteTo == Piece::EMPTY) &&
+               ((BitBoard::bishopAttacks(from, occupied) & toMask) != 0);
+    case Piece::WKNIGHT:
+        return (promoteTo == Piece::EMPTY) &&
+               ((BitBoard::knightAttacks(from) & toMask) != 0);
+    case Piece::WPAWN: {
+        const int y = Square::getY(to);
+        if ((y == 0) || (y == 7)) {
+            if ((promoteTo == Piece::EMPTY) || (Piece::isWhite(promoteTo) != wtm))
+                return false;
+            switch (Piece::makeWhite(promoteTo)) {
+            case Piece::WQUEEN: case Piece::WROOK: case Piece::WBISHOP: case Piece::WKNIGHT:
+                break;
+            default:
+                return false;
+            }
+        } else if (promoteTo != Piece::EMPTY) {
+            return false;
+        }
+        const int fwd = wtm ? 8 : -8;
+        if (to == from + fwd)
+            return (occupied & toMask) == 0;
+        if (to == from + 2 * fwd)
+            return (Square::getY(from) == (wtm ? 1 : 6)) &&
+                   ((occupied & ((1ULL << (from + fwd)) | toMask)) == 0);
+        const U64 atk = wtm ? BitBoard::wPawnAttacks(from) : BitBoard::bPawnAttacks(from);
+        const int epSquare = pos.getEpSquare();
+        const U64 epMask = (epSquare >= 0) ? (1ULL << epSquare) : 0ULL;
+        return (atk & toMask & (pos.colorBB(!wtm) | epMask)) != 0;
+    }
+    default:
+        return false;
+    }
+}
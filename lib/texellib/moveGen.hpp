@@ -28,6 +28,7 @@
 
 #include "move.hpp"
 #include "position.hpp"
+#include "attackInfo.hpp"
 #include "util/util.hpp"
 
 #include <cassert>
@@ -49,8 +50,10 @@ public:
 
     int size;
 
-private:
+    /** Maximum number of moves a list can hold. */
     static const int MAX_MOVES = 256;
+
+private:
     int buf[sizeof(Move[MAX_MOVES])/sizeof(int)];
 };
 
@@ -69,6 +72,16 @@ public:
     static void pseudoLegalMoves(const Position& pos, MoveList& moveList);
     static void pseudoLegalMoves(const Position& pos, MoveList& moveList);
 
+    /**
+     * Generate and return a list of legal moves. Pinned pieces and the set of
+     * squares that resolve a check are computed once, so no move needs to be
+     * made to determine if it is legal. The moves are generated in the same
+     * order as by pseudoLegalMoves().
+     */
+    template <bool wtm>
+    static void legalMoves(const Position& pos, MoveList& moveList);
+    static void legalMoves(const Position& pos, MoveList& moveList);
+
     /**
      * Generate and return a list of pseudo-legal check evasion moves.
      * Pseudo-legal means that the moves don't necessarily defend from check threats.
@@ -89,9 +102,13 @@ public:
 
     /** Return true if the side to move is in check. */
     static bool inCheck(const Position& pos);
+    /** Like inCheck(pos), but uses and updates cached attack information. */
+    static bool inCheck(const Position& pos, AttackInfo& ai);
 
     /** Return true if making a move delivers check to the opponent */
     static bool givesCheck(const Position& pos, const Move& m);
+    /** Like givesCheck(pos, m), but uses and updates cached attack information. */
+    static bool givesCheck(const Position& pos, const Move& m, AttackInfo& ai);
 
     /** Return true if the side to move can take the opponents king. */
     static bool canTakeKing(Position& pos);
@@ -111,6 +128,13 @@ public:
     /** Return true if the pseudo-legal move "move" is legal is position "pos".
      * isInCheck must be equal to inCheck(pos). */
     static bool isLegal(Position& pos, const Move& move, bool isInCheck);
+    /** Like isLegal(), but uses and updates cached attack information,
+     *  which also provides the in check status. */
+    static bool isLegal(Position& pos, const Move& move, AttackInfo& ai);
+
+    /** Return true if "move" is contained in the list generated by pseudoLegalMoves().
+     * Cheaper than generating the move list. Used to validate hash and killer moves. */
+    static bool isPseudoLegal(const Position& pos, const Move& move);
 
 private:
     /** Return the next piece in a given direction, starting from sq. */
@@ -161,6 +185,14 @@ MoveGen::pseudoLegalMoves(const Position& pos, MoveList& moveList) {
         pseudoLegalMoves<false>(pos, moveList);
 }
 
+inline void
+MoveGen::legalMoves(const Position& pos, MoveList& moveList) {
+    if (pos.isWhiteMove())
+        legalMoves<true>(pos, moveList);
+    else
+        legalMoves<false>(pos, moveList);
+}
+
 inline void
 MoveGen::checkEvasions(const Position& pos, MoveList& moveList) {
     if (pos.isWhiteMove())
@@ -191,6 +223,85 @@ MoveGen::inCheck(const Position& pos) {
     return sqAttacked(pos, kingSq);
 }
 
+inline bool
+MoveGen::inCheck(const Position& pos, AttackInfo& ai) {
+    ai.update(pos);
+    return ai.checkers != 0;
+}
+
+inline bool
+MoveGen::givesCheck(const Position& pos, const Move& m, AttackInfo& ai) {
+    ai.update(pos);
+    const int from = m.from();
+    const int to = m.to();
+    const U64 toMask = 1ULL << to;
+    const int p = Piece::makeWhite(pos.getPiece(from));
+    if (m.promoteTo() != Piece::EMPTY)
+        return givesCheck(pos, m);
+    switch (p) {
+    case Piece::WQUEEN:
+        if (toMask & (ai.bishopChecks | ai.rookChecks))
+            return true;
+        break;
+    case Piece::WROOK:
+        if (toMask & ai.rookChecks)
+            return true;
+        break;
+    case Piece::WBISHOP:
+        if (toMask & ai.bishopChecks)
+            return true;
+        break;
+    case Piece::WKNIGHT:
+        if (toMask & ai.knightChecks)
+            return true;
+        break;
+    case Piece::WPAWN:
+        if (toMask & ai.pawnChecks)
+            return true;
+        if (to == pos.getEpSquare())
+            return givesCheck(pos, m);
+        break;
+    case Piece::WKING:
+        if ((to == from + 2) || (to == from - 2))
+            return givesCheck(pos, m);
+        break;
+    }
+    if (ai.discoverers & (1ULL << from)) {
+        const int oKingSq = pos.getKingSq(!pos.isWhiteMove());
+        if (BitBoard::getDirection(from, oKingSq) != BitBoard::getDirection(to, oKingSq))
+            return true;
+    }
+    return false;
+}
+
+inline bool
+MoveGen::isLegal(Position& pos, const Move& m, AttackInfo& ai) {
+    ai.update(pos);
+    const bool isInCheck = ai.checkers != 0;
+    const int kSq = pos.getKingSq(pos.isWhiteMove());
+    if (m.from() == kSq) {
+        if (isInCheck && ((m.to() == kSq + 2) || (m.to() == kSq - 2)))
+            return isLegal(pos, m, isInCheck);
+        U64 occupied = pos.occupiedBB() & ~(1ULL << kSq);
+        return !sqAttacked(pos, m.to(), occupied);
+    }
+    if (m.to() == pos.getEpSquare())
+        return isLegal(pos, m, isInCheck);
+    const U64 fromMask = 1ULL << m.from();
+    if (isInCheck) {
+        // A pinned piece can not capture or block the checking piece
+        const U64 checkers = ai.checkers;
+        if ((ai.pinned & fromMask) || (checkers & (checkers - 1)))
+            return false;
+        const U64 validTargets = checkers |
+                                 BitBoard::squaresBetween(kSq, BitBoard::firstSquare(checkers));
+        return (validTargets & (1ULL << m.to())) != 0;
+    }
+    if (!(ai.pinned & fromMask))
+        return true;
+    return BitBoard::getDirection(kSq, m.from()) == BitBoard::getDirection(kSq, m.to());
+}
+
 inline bool
 MoveGen::canTakeKing(Position& pos) {
     pos.setWhiteMove(!pos.isWhiteMove());
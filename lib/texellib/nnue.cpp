@@ -0,0 +1,801 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * nnue.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "nnue.hpp"
+#include "position.hpp"
+#include "move.hpp"
+#include "util/cpuInfo.hpp"
+#include "util/random.hpp"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Select SIMD kernels. AVX2 is used if the compiler targets it, or if
+// CPU dispatch is enabled and the CPU supports it. Otherwise SSE4.1 or
+// NEON is used if the compiler targets it, else plain C++ code.
+#if defined(__AVX2__)
+#define NNUE_AVX2
+#define NNUE_AVX2_TARGET
+#elif defined(HAS_CPU_DISPATCH) && (defined(__x86_64__) || defined(_M_X64))
+#define NNUE_AVX2
+#define NNUE_AVX2_DISPATCH
+#if defined(__GNUC__)
+#define NNUE_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define NNUE_AVX2_TARGET
+#endif
+#endif
+
+#if defined(__SSE4_1__)
+#define NNUE_SSE4
+#elif defined(__ARM_NEON)
+#define NNUE_NEON
+#endif
+
+#if defined(NNUE_AVX2) || defined(NNUE_SSE4)
+#include <immintrin.h>
+#endif
+#ifdef NNUE_NEON
+#include <arm_neon.h>
+#endif
+
+NNUE::Network NNUE::net;
+bool NNUE::enabled = false;
+U32 NNUE::netId = 1;
+
+namespace {
+
+/** Network file header. All data is stored in little endian byte order. */
+struct FileHeader {
+    U32 magic;
+    U32 version;
+    U32 nFeatures;
+    U32 nHidden;
+    U32 nL2;
+    U32 nL3;
+    U32 pad[10];
+};
+static_assert(sizeof(FileHeader) == 64, "Sections must be 64 byte aligned");
+
+const U32 fileMagic = 0x4e4e5854; // "TXNN"
+const U32 fileVersion = 1;
+
+const size_t ftBiasSize    = NNUE::nHidden * sizeof(S16);
+const size_t ftWeightsSize = NNUE::nFeatures * NNUE::nHidden * sizeof(S16);
+const size_t l1BiasSize    = NNUE::nL2 * sizeof(S32);
+const size_t l1WeightsSize = NNUE::nL2 * 2 * NNUE::nHidden;
+const size_t l2BiasSize    = NNUE::nL3 * sizeof(S32);
+const size_t l2WeightsSize = NNUE::nL3 * NNUE::nL2;
+const size_t outWeightsSize = NNUE::nL3;
+const size_t outBiasSize   = sizeof(S32);
+
+const size_t fileSize = sizeof(FileHeader) + ftBiasSize + ftWeightsSize +
+                        l1BiasSize + l1WeightsSize + l2BiasSize + l2WeightsSize +
+                        outWeightsSize + outBiasSize;
+
+/** Memory holding the current network. Either a memory mapped file or
+ *  a copy owned by this program. */
+struct NetData {
+    vector_aligned<U8> buf;
+    void* mapAddr = nullptr;
+    size_t mapLen = 0;
+#ifdef _WIN32
+    HANDLE mapHandle = nullptr;
+#endif
+};
+NetData netData;
+
+#ifdef NNUE_AVX2_DISPATCH
+const bool useAvx2 = CpuInfo::instance().hasAvx2();
+#elif defined(NNUE_AVX2)
+const bool useAvx2 = true;
+#endif
+
+// ----------------------------------------------------------------------------
+// Scalar kernels
+
+#if !defined(NNUE_SSE4) && !defined(NNUE_NEON)
+void
+addRowScalar(S16* acc, const S16* w) {
+    for (int i = 0; i < NNUE::nHidden; i++)
+        acc[i] += w[i];
+}
+
+void
+subRowScalar(S16* acc, const S16* w) {
+    for (int i = 0; i < NNUE::nHidden; i++)
+        acc[i] -= w[i];
+}
+#endif
+
+void
+clipAccScalar(const S16* in, U8* out) {
+    for (int i = 0; i < NNUE::nHidden; i++)
+        out[i] = (U8)clamp((int)in[i], 0, 127);
+}
+
+void
+affineScalar(const U8* in, int nIn, const S8* w, const S32* bias, S32* out, int nOut) {
+    for (int j = 0; j < nOut; j++) {
+        const S8* row = &w[(size_t)j * nIn];
+        S32 sum = bias[j];
+        for (int i = 0; i < nIn; i++)
+            sum += in[i] * row[i];
+        out[j] = sum;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// AVX2 kernels
+
+#ifdef NNUE_AVX2
+NNUE_AVX2_TARGET void
+addRowAvx2(S16* acc, const S16* w) {
+    for (int i = 0; i < NNUE::nHidden; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)&acc[i]);
+        __m256i b = _mm256_loadu_si256((const __m256i*)&w[i]);
+        _mm256_storeu_si256((__m256i*)&acc[i], _mm256_add_epi16(a, b));
+    }
+}
+
+NNUE_AVX2_TARGET void
+subRowAvx2(S16* acc, const S16* w) {
+    for (int i = 0; i < NNUE::nHidden; i += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)&acc[i]);
+        __m256i b = _mm256_loadu_si256((const __m256i*)&w[i]);
+        _mm256_storeu_si256((__m256i*)&acc[i], _mm256_sub_epi16(a, b));
+    }
+}
+
+NNUE_AVX2_TARGET void
+clipAccAvx2(const S16* in, U8* out) {
+    const __m256i maxVal = _mm256_set1_epi8(127);
+    for (int i = 0; i < NNUE::nHidden; i += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)&in[i]);
+        __m256i b = _mm256_loadu_si256((const __m256i*)&in[i + 16]);
+        __m256i p = _mm256_packus_epi16(a, b);
+        p = _mm256_permute4x64_epi64(p, 0xd8); // Undo lane interleaving
+        _mm256_storeu_si256((__m256i*)&out[i], _mm256_min_epu8(p, maxVal));
+    }
+}
+
+NNUE_AVX2_TARGET void
+affineAvx2(const U8* in, int nIn, const S8* w, const S32* bias, S32* out, int nOut) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    auto dot = [&ones](__m256i sum, __m256i x, const S8* row) NNUE_AVX2_TARGET {
+        __m256i y = _mm256_loadu_si256((const __m256i*)row);
+        __m256i p = _mm256_maddubs_epi16(x, y);
+        return _mm256_add_epi32(sum, _mm256_madd_epi16(p, ones));
+    };
+    int j = 0;
+    for ( ; j + 4 <= nOut; j += 4) { // Four outputs at a time to share reductions
+        const S8* row = &w[(size_t)j * nIn];
+        __m256i s0 = _mm256_setzero_si256(), s1 = s0, s2 = s0, s3 = s0;
+        for (int i = 0; i < nIn; i += 32) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)&in[i]);
+            s0 = dot(s0, x, &row[i]);
+            s1 = dot(s1, x, &row[i + nIn]);
+            s2 = dot(s2, x, &row[i + 2 * nIn]);
+            s3 = dot(s3, x, &row[i + 3 * nIn]);
+        }
+        s0 = _mm256_hadd_epi32(_mm256_hadd_epi32(s0, s1), _mm256_hadd_epi32(s2, s3));
+        __m128i s = _mm_add_epi32(_mm256_castsi256_si128(s0),
+                                  _mm256_extracti128_si256(s0, 1));
+        s = _mm_add_epi32(s, _mm_loadu_si128((const __m128i*)&bias[j]));
+        _mm_storeu_si128((__m128i*)&out[j], s);
+    }
+    for ( ; j < nOut; j++) {
+        const S8* row = &w[(size_t)j * nIn];
+        __m256i sum = _mm256_setzero_si256();
+        for (int i = 0; i < nIn; i += 32)
+            sum = dot(sum, _mm256_loadu_si256((const __m256i*)&in[i]), &row[i]);
+        __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                                  _mm256_extracti128_si256(sum, 1));
+        s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4e));
+        s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xb1));
+        out[j] = bias[j] + _mm_cvtsi128_si32(s);
+    }
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// SSE4.1 kernels
+
+#ifdef NNUE_SSE4
+void
+addRowSse4(S16* acc, const S16* w) {
+    for (int i = 0; i < NNUE::nHidden; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i*)&acc[i]);
+        __m128i b = _mm_loadu_si128((const __m128i*)&w[i]);
+        _mm_storeu_si128((__m128i*)&acc[i], _mm_add_epi16(a, b));
+    }
+}
+
+void
+subRowSse4(S16* acc, const S16* w) {
+    for (int i = 0; i < NNUE::nHidden; i += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i*)&acc[i]);
+        __m128i b = _mm_loadu_si128((const __m128i*)&w[i]);
+        _mm_storeu_si128((__m128i*)&acc[i], _mm_sub_epi16(a, b));
+    }
+}
+
+void
+clipAccSse4(const S16* in, U8* out) {
+    const __m128i maxVal = _mm_set1_epi8(127);
+    for (int i = 0; i < NNUE::nHidden; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)&in[i]);
+        __m128i b = _mm_loadu_si128((const __m128i*)&in[i + 8]);
+        __m128i p = _mm_packus_epi16(a, b);
+        _mm_storeu_si128((__m128i*)&out[i], _mm_min_epu8(p, maxVal));
+    }
+}
+
+void
+affineSse4(const U8* in, int nIn, const S8* w, const S32* bias, S32* out, int nOut) {
+    const __m128i ones = _mm_set1_epi16(1);
+    auto dot = [&ones](__m128i sum, __m128i x, const S8* row) {
+        __m128i y = _mm_loadu_si128((const __m128i*)row);
+        __m128i p = _mm_maddubs_epi16(x, y);
+        return _mm_add_epi32(sum, _mm_madd_epi16(p, ones));
+    };
+    int j = 0;
+    for ( ; j + 4 <= nOut; j += 4) { // Four outputs at a time to share reductions
+        const S8* row = &w[(size_t)j * nIn];
+        __m128i s0 = _mm_setzero_si128(), s1 = s0, s2 = s0, s3 = s0;
+        for (int i = 0; i < nIn; i += 16) {
+            __m128i x = _mm_loadu_si128((const __m128i*)&in[i]);
+            s0 = dot(s0, x, &row[i]);
+            s1 = dot(s1, x, &row[i + nIn]);
+            s2 = dot(s2, x, &row[i + 2 * nIn]);
+            s3 = dot(s3, x, &row[i + 3 * nIn]);
+        }
+        __m128i s = _mm_hadd_epi32(_mm_hadd_epi32(s0, s1), _mm_hadd_epi32(s2, s3));
+        s = _mm_add_epi32(s, _mm_loadu_si128((const __m128i*)&bias[j]));
+        _mm_storeu_si128((__m128i*)&out[j], s);
+    }
+    for ( ; j < nOut; j++) {
+        const S8* row = &w[(size_t)j * nIn];
+        __m128i sum = _mm_setzero_si128();
+        for (int i = 0; i < nIn; i += 16)
+            sum = dot(sum, _mm_loadu_si128((const __m128i*)&in[i]), &row[i]);
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+        out[j] = bias[j] + _mm_cvtsi128_si32(sum);
+    }
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// NEON kernels
+
+#ifdef NNUE_NEON
+void
+addRowNeon(S16* acc, const S16* w) {
+    for (int i = 0; i < NNUE::nHidden; i += 8)
+        vst1q_s16(&acc[i], vaddq_s16(vld1q_s16(&acc[i]), vld1q_s16(&w[i])));
+}
+
+void
+subRowNeon(S16* acc, const S16* w) {
+    for (int i = 0; i < NNUE::nHidden; i += 8)
+        vst1q_s16(&acc[i], vsubq_s16(vld1q_s16(&acc[i]), vld1q_s16(&w[i])));
+}
+
+void
+clipAccNeon(const S16* in, U8* out) {
+    const uint8x16_t maxVal = vdupq_n_u8(127);
+    for (int i = 0; i < NNUE::nHidden; i += 16) {
+        uint8x16_t p = vcombine_u8(vqmovun_s16(vld1q_s16(&in[i])),
+                                   vqmovun_s16(vld1q_s16(&in[i + 8])));
+        vst1q_u8(&out[i], vminq_u8(p, maxVal));
+    }
+}
+
+void
+affineNeon(const U8* in, int nIn, const S8* w, const S32* bias, S32* out, int nOut) {
+    for (int j = 0; j < nOut; j++) {
+        const S8* row = &w[(size_t)j * nIn];
+        int32x4_t sum = vdupq_n_s32(0);
+        for (int i = 0; i < nIn; i += 16) {
+            int8x16_t x = vreinterpretq_s8_u8(vld1q_u8(&in[i])); // Inputs are <= 127
+            int8x16_t y = vld1q_s8(&row[i]);
+            int16x8_t p = vmull_s8(vget_low_s8(x), vget_low_s8(y));
+            p = vmlal_s8(p, vget_high_s8(x), vget_high_s8(y));
+            sum = vpadalq_s16(sum, p);
+        }
+        out[j] = bias[j] + vgetq_lane_s32(sum, 0) + vgetq_lane_s32(sum, 1) +
+                           vgetq_lane_s32(sum, 2) + vgetq_lane_s32(sum, 3);
+    }
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// Kernel selection
+
+inline void
+addRow(S16* acc, const S16* w) {
+#ifdef NNUE_AVX2
+    if (useAvx2)
+        return addRowAvx2(acc, w);
+#endif
+#if defined(NNUE_SSE4)
+    addRowSse4(acc, w);
+#elif defined(NNUE_NEON)
+    addRowNeon(acc, w);
+#else
+    addRowScalar(acc, w);
+#endif
+}
+
+inline void
+subRow(S16* acc, const S16* w) {
+#ifdef NNUE_AVX2
+    if (useAvx2)
+        return subRowAvx2(acc, w);
+#endif
+#if defined(NNUE_SSE4)
+    subRowSse4(acc, w);
+#elif defined(NNUE_NEON)
+    subRowNeon(acc, w);
+#else
+    subRowScalar(acc, w);
+#endif
+}
+
+template <bool simd>
+inline void
+clipAcc(const S16* in, U8* out) {
+    if (!simd)
+        return clipAccScalar(in, out);
+#ifdef NNUE_AVX2
+    if (useAvx2)
+        return clipAccAvx2(in, out);
+#endif
+#if defined(NNUE_SSE4)
+    clipAccSse4(in, out);
+#elif defined(NNUE_NEON)
+    clipAccNeon(in, out);
+#else
+    clipAccScalar(in, out);
+#endif
+}
+
+template <bool simd>
+inline void
+affine(const U8* in, int nIn, const S8* w, const S32* bias, S32* out, int nOut) {
+    if (!simd)
+        return affineScalar(in, nIn, w, bias, out, nOut);
+#ifdef NNUE_AVX2
+    if (useAvx2)
+        return affineAvx2(in, nIn, w, bias, out, nOut);
+#endif
+#if defined(NNUE_SSE4)
+    affineSse4(in, nIn, w, bias, out, nOut);
+#elif defined(NNUE_NEON)
+    affineNeon(in, nIn, w, bias, out, nOut);
+#else
+    affineScalar(in, nIn, w, bias, out, nOut);
+#endif
+}
+
+/** Scale down hidden layer output and apply clipped ReLU. */
+inline void
+clipLayer(const S32* in, U8* out, int n) {
+    for (int i = 0; i < n; i++)
+        out[i] = (U8)clamp(in[i] >> NNUE::weightShift, 0, 127);
+}
+
+bool
+isLittleEndian() {
+    const U16 v = 1;
+    U8 b;
+    memcpy(&b, &v, 1);
+    return b == 1;
+}
+
+}
+
+// ----------------------------------------------------------------------------
+
+bool
+NNUE::initNetwork(const U8* data, size_t len, std::string& errMsg) {
+    if (!isLittleEndian()) {
+        errMsg = "Network files are only supported on little endian computers";
+        return false;
+    }
+    FileHeader hdr;
+    if (len < sizeof(hdr)) {
+        errMsg = "Network file too small";
+        return false;
+    }
+    memcpy(&hdr, data, sizeof(hdr));
+    if (hdr.magic != fileMagic || hdr.version != fileVersion) {
+        errMsg = "Not a network file or unsupported version";
+        return false;
+    }
+    if (hdr.nFeatures != (U32)nFeatures || hdr.nHidden != (U32)nHidden ||
+        hdr.nL2 != (U32)nL2 || hdr.nL3 != (U32)nL3) {
+        errMsg = "Network has wrong layer sizes";
+        return false;
+    }
+    if (len != fileSize) {
+        errMsg = "Network file has wrong size";
+        return false;
+    }
+
+    const U8* p = data + sizeof(hdr);
+    net.ftBias     = (const S16*)p; p += ftBiasSize;
+    net.ftWeights  = (const S16*)p; p += ftWeightsSize;
+    net.l1Bias     = (const S32*)p; p += l1BiasSize;
+    net.l1Weights  = (const S8*)p;  p += l1WeightsSize;
+    net.l2Bias     = (const S32*)p; p += l2BiasSize;
+    net.l2Weights  = (const S8*)p;  p += l2WeightsSize;
+    net.outWeights = (const S8*)p;  p += outWeightsSize;
+    net.outBias    = (const S32*)p;
+    netId++;
+    return true;
+}
+
+void
+NNUE::unloadNetwork() {
+    net = Network();
+    netId++;
+    if (netData.mapAddr) {
+#ifdef _WIN32
+        UnmapViewOfFile(netData.mapAddr);
+        CloseHandle(netData.mapHandle);
+        netData.mapHandle = nullptr;
+#else
+        munmap(netData.mapAddr, netData.mapLen);
+#endif
+        netData.mapAddr = nullptr;
+        netData.mapLen = 0;
+    }
+    netData.buf = vector_aligned<U8>();
+}
+
+bool
+NNUE::loadNetwork(const std::string& fileName, std::string& errMsg) {
+    unloadNetwork();
+    if (fileName.empty())
+        return true;
+
+#ifdef _WIN32
+    HANDLE hFile = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE) {
+        errMsg = "Cannot open network file: " + fileName;
+        return false;
+    }
+    LARGE_INTEGER size;
+    HANDLE hMap = nullptr;
+    if (GetFileSizeEx(hFile, &size))
+        hMap = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(hFile);
+    void* addr = hMap ? MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!addr) {
+        if (hMap)
+            CloseHandle(hMap);
+        errMsg = "Cannot map network file: " + fileName;
+        return false;
+    }
+    netData.mapHandle = hMap;
+    size_t len = size.QuadPart;
+#else
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        errMsg = "Cannot open network file: " + fileName;
+        return false;
+    }
+    struct stat st;
+    void* addr = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        errMsg = "Cannot map network file: " + fileName;
+        return false;
+    }
+    size_t len = st.st_size;
+#endif
+    netData.mapAddr = addr;
+    netData.mapLen = len;
+
+    if (!initNetwork((const U8*)addr, len, errMsg)) {
+        unloadNetwork();
+        return false;
+    }
+    return true;
+}
+
+bool
+NNUE::setNetwork(const std::vector<U8>& data, std::string& errMsg) {
+    unloadNetwork();
+    netData.buf.assign(data.begin(), data.end());
+    if (!initNetwork(netData.buf.data(), netData.buf.size(), errMsg)) {
+        unloadNetwork();
+        return false;
+    }
+    return true;
+}
+
+std::vector<U8>
+NNUE::randomNetwork(U64 seed) {
+    Random rnd(seed);
+    std::vector<U8> data(fileSize);
+    FileHeader hdr{};
+    hdr.magic = fileMagic;
+    hdr.version = fileVersion;
+    hdr.nFeatures = nFeatures;
+    hdr.nHidden = nHidden;
+    hdr.nL2 = nL2;
+    hdr.nL3 = nL3;
+    memcpy(&data[0], &hdr, sizeof(hdr));
+
+    U8* p = &data[sizeof(hdr)];
+    auto fill16 = [&rnd,&p](size_t n, int lo, int hi) {
+        for (size_t i = 0; i < n; i++, p += sizeof(S16)) {
+            S16 v = lo + rnd.nextInt(hi - lo + 1);
+            memcpy(p, &v, sizeof(v));
+        }
+    };
+    auto fill32 = [&rnd,&p](size_t n, int lo, int hi) {
+        for (size_t i = 0; i < n; i++, p += sizeof(S32)) {
+            S32 v = lo + rnd.nextInt(hi - lo + 1);
+            memcpy(p, &v, sizeof(v));
+        }
+    };
+    auto fill8 = [&rnd,&p](size_t n, int lo, int hi) {
+        for (size_t i = 0; i < n; i++)
+            *p++ = (U8)(S8)(lo + rnd.nextInt(hi - lo + 1));
+    };
+    fill16(nHidden, 0, 64);
+    fill16(nFeatures * nHidden, -32, 32);
+    fill32(nL2, -2000, 2000);
+    fill8(nL2 * 2 * nHidden, -128, 127);
+    fill32(nL3, -2000, 2000);
+    fill8(nL3 * nL2, -128, 127);
+    fill8(nL3, -128, 127);
+    fill32(1, -1000, 1000);
+    return data;
+}
+
+void
+NNUE::setEnabled(bool e) {
+    if (e != enabled) {
+        enabled = e;
+        netId++;
+    }
+}
+
+std::string
+NNUE::simdName() {
+    std::string ret;
+#ifdef NNUE_AVX2
+    if (useAvx2)
+        return "AVX2";
+#endif
+#if defined(NNUE_SSE4)
+    return "SSE4.1";
+#elif defined(NNUE_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+void
+NNUE::refresh(const Position& pos, Accumulator& acc) {
+    for (int persp = 0; persp < 2; persp++) {
+        S16* a = acc.acc[persp];
+        memcpy(a, net.ftBias, ftBiasSize);
+        U64 m = pos.occupiedBB();
+        while (m) {
+            int sq = BitBoard::extractSquare(m);
+            addRow(a, &net.ftWeights[featureIdx(persp, pos.getPiece(sq), sq) * nHidden]);
+        }
+    }
+    acc.netId = netId;
+}
+
+void
+NNUE::addPiece(Accumulator& acc, int piece, int square) {
+    addRow(acc.acc[0], &net.ftWeights[featureIdx(0, piece, square) * nHidden]);
+    addRow(acc.acc[1], &net.ftWeights[featureIdx(1, piece, square) * nHidden]);
+}
+
+void
+NNUE::removePiece(Accumulator& acc, int piece, int square) {
+    subRow(acc.acc[0], &net.ftWeights[featureIdx(0, piece, square) * nHidden]);
+    subRow(acc.acc[1], &net.ftWeights[featureIdx(1, piece, square) * nHidden]);
+}
+
+void
+NNUE::movePiece(Accumulator& acc, int piece, int fromSq, int toSq) {
+    for (int persp = 0; persp < 2; persp++) {
+        subRow(acc.acc[persp], &net.ftWeights[featureIdx(persp, piece, fromSq) * nHidden]);
+        addRow(acc.acc[persp], &net.ftWeights[featureIdx(persp, piece, toSq) * nHidden]);
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void
+NNUE::AccumulatorStack::setRoot(const Position& pos) {
+    const U64 key = pos.zobristHash();
+    if (top >= 0 && entries[top].key == key)
+        return;
+    if (entries.empty())
+        entries.resize(16);
+    top = 0;
+    entries[0].acc.netId = 0;
+    entries[0].key = key;
+    entries[0].nChanges = 0;
+}
+
+NNUE::AccumulatorStack::Entry&
+NNUE::AccumulatorStack::pushEntry(const Position& pos) {
+    setRoot(pos);
+    if (++top >= (int)entries.size())
+        entries.resize(entries.size() * 2);
+    Entry& e = entries[top];
+    e.acc.netId = 0;
+    e.key = 0;
+    e.nChanges = 0;
+    return e;
+}
+
+void
+NNUE::AccumulatorStack::push(const Position& pos, const Move& m) {
+    Entry& e = pushEntry(pos);
+    auto change = [&e](int piece, int from, int to) {
+        e.changes[e.nChanges++] = Change{ (S8)piece, (S8)from, (S8)to };
+    };
+    const int from = m.from();
+    const int to = m.to();
+    const int p = pos.getPiece(from);
+    const int captured = pos.getPiece(to);
+    if (captured != Piece::EMPTY)
+        change(captured, to, -1);
+    if (m.promoteTo() != Piece::EMPTY) {
+        change(p, from, -1);
+        change(m.promoteTo(), -1, to);
+        return;
+    }
+    change(p, from, to);
+    if (p == Piece::WPAWN || p == Piece::BPAWN) {
+        if (to == pos.getEpSquare() && captured == Piece::EMPTY) {
+            if (p == Piece::WPAWN)
+                change(Piece::BPAWN, to - 8, -1);
+            else
+                change(Piece::WPAWN, to + 8, -1);
+        }
+    } else if (p == Piece::WKING || p == Piece::BKING) {
+        const int rook = p == Piece::WKING ? Piece::WROOK : Piece::BROOK;
+        if (to == from + 2)
+            change(rook, to + 1, to - 1);
+        else if (to == from - 2)
+            change(rook, to - 2, to + 1);
+    }
+}
+
+void
+NNUE::AccumulatorStack::pushNull(const Position& pos) {
+    pushEntry(pos);
+}
+
+void
+NNUE::AccumulatorStack::setKey(U64 key) {
+    entries[top].key = key;
+}
+
+void
+NNUE::AccumulatorStack::pop() {
+    if (top > 0)
+        top--;
+    else
+        top = -1;
+}
+
+const NNUE::Accumulator&
+NNUE::AccumulatorStack::get(const Position& pos) {
+    setRoot(pos);
+    int i = top;
+    while (i >= 0 && entries[i].acc.netId != netId)
+        i--;
+    if (i < 0) { // No accumulator computed for the current network
+        refresh(pos, entries[top].acc);
+        return entries[top].acc;
+    }
+    for (i++; i <= top; i++) {
+        Entry& e = entries[i];
+        e.acc = entries[i-1].acc;
+        for (int c = 0; c < e.nChanges; c++) {
+            const Change& ch = e.changes[c];
+            if (ch.from < 0)
+                addPiece(e.acc, ch.piece, ch.to);
+            else if (ch.to < 0)
+                removePiece(e.acc, ch.piece, ch.from);
+            else
+                movePiece(e.acc, ch.piece, ch.from, ch.to);
+        }
+    }
+    return entries[top].acc;
+}
+
+// ----------------------------------------------------------------------------
+
+template <bool simd>
+static inline int
+evalLayers(const NNUE::Accumulator& acc, bool wtm,
+           const S8* l1Weights, const S32* l1Bias,
+           const S8* l2Weights, const S32* l2Bias,
+           const S8* outWeights, const S32* outBias) {
+    const int nHidden = NNUE::nHidden;
+    const int nL2 = NNUE::nL2;
+    const int nL3 = NNUE::nL3;
+
+    alignas(64) U8 input[2 * nHidden];
+    const int us = wtm ? 0 : 1;
+    clipAcc<simd>(acc.acc[us], &input[0]);
+    clipAcc<simd>(acc.acc[1 - us], &input[nHidden]);
+
+    alignas(64) S32 l1Out[nL2];
+    alignas(64) U8 l1Act[nL2];
+    affine<simd>(input, 2 * nHidden, l1Weights, l1Bias, l1Out, nL2);
+    clipLayer(l1Out, l1Act, nL2);
+
+    alignas(64) S32 l2Out[nL3];
+    alignas(64) U8 l2Act[nL3];
+    affine<simd>(l1Act, nL2, l2Weights, l2Bias, l2Out, nL3);
+    clipLayer(l2Out, l2Act, nL3);
+
+    S32 out;
+    affine<simd>(l2Act, nL3, outWeights, outBias, &out, 1);
+    return out / NNUE::outputScale;
+}
+
+int
+NNUE::evaluate(const Accumulator& acc, bool wtm) {
+    return evalLayers<true>(acc, wtm, net.l1Weights, net.l1Bias, net.l2Weights,
+                            net.l2Bias, net.outWeights, net.outBias);
+}
+
+int
+NNUE::evaluateScalar(const Accumulator& acc, bool wtm) {
+    return evalLayers<false>(acc, wtm, net.l1Weights, net.l1Bias, net.l2Weights,
+                             net.l2Bias, net.outWeights, net.outBias);
+}
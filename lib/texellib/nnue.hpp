@@ -0,0 +1,201 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * nnue.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef NNUE_HPP_
+#define NNUE_HPP_
+
+#include "util/util.hpp"
+#include "piece.hpp"
+
+#include <string>
+#include <vector>
+
+class Position;
+class Move;
+
+/**
+ * Efficiently updatable neural network evaluation.
+ *
+ * The input features are the 12*64 (piece, square) combinations, seen from
+ * both the white and the black point of view. The first layer output, the
+ * accumulator, is kept up to date incrementally when pieces are added,
+ * removed or moved. The remaining layers are small int8 affine layers with
+ * clipped ReLU activations, computed from scratch for each evaluation.
+ *
+ * Network weights are read from a file, which is memory mapped when the
+ * operating system supports it.
+ */
+class NNUE {
+public:
+    static const int nFeatures = 12 * 64; // Input features per perspective
+    static const int nHidden = 256;       // Accumulator size per perspective
+    static const int nL2 = 32;            // Output size of first hidden layer
+    static const int nL3 = 32;            // Output size of second hidden layer
+    static const int weightShift = 6;     // Scale factor 64 for hidden layer weights
+    static const int outputScale = 16;    // Output layer value per centipawn
+
+    /** First layer output for the white and the black perspective. */
+    struct Accumulator {
+        S16 acc[2][nHidden];
+        U32 netId = 0;  // Network the accumulator is valid for, 0 if invalid
+    };
+
+    /** Accumulators for the positions along a search path. Making a move only
+     *  records which pieces change. An accumulator is computed when the
+     *  position is evaluated, starting from the closest computed parent
+     *  accumulator. Undoing a move is a pop. */
+    class AccumulatorStack {
+    public:
+        /** Record the piece changes for move m, which is about to be made in
+         *  pos. setKey() must be called after the move has been made. */
+        void push(const Position& pos, const Move& m);
+        /** Record a null move in pos. setKey() must be called after the
+         *  null move has been made. */
+        void pushNull(const Position& pos);
+        /** Set the hash key of the position after the last pushed move. */
+        void setKey(U64 key);
+        /** Remove the last pushed move. */
+        void pop();
+
+        /** Return the accumulator for pos. If pos is not the position after
+         *  the pushed moves, the stack is reset to contain only pos. */
+        const Accumulator& get(const Position& pos);
+
+    private:
+        /** A piece change. from == -1 adds a piece, to == -1 removes a piece. */
+        struct Change {
+            S8 piece;
+            S8 from;
+            S8 to;
+        };
+        struct Entry {
+            Accumulator acc;
+            U64 key = 0;       // Position hash key
+            int nChanges = 0;  // Piece changes from the parent position
+            Change changes[3];
+        };
+
+        /** Make pos the root position if it is not the last position in the stack. */
+        void setRoot(const Position& pos);
+        /** Add an entry for a child position and return it. */
+        Entry& pushEntry(const Position& pos);
+
+        std::vector<Entry> entries;
+        int top = -1;          // Index of the current position, -1 if empty
+    };
+
+    /** Load network from file. An empty file name unloads the current network.
+     *  On failure the current network is unloaded and errMsg is set. */
+    static bool loadNetwork(const std::string& fileName, std::string& errMsg);
+
+    /** Use a network stored in memory, in the same format as the network
+     *  file. The data is copied. */
+    static bool setNetwork(const std::vector<U8>& data, std::string& errMsg);
+
+    /** Create network data with random weights. Used by tests and benchmarks. */
+    static std::vector<U8> randomNetwork(U64 seed);
+
+    /** Return true if a network is loaded. */
+    static bool hasNetwork();
+
+    /** Enable/disable use of the network in the evaluation function. */
+    static void setEnabled(bool enabled);
+
+    /** Return true if the network evaluation is enabled and a network is loaded. */
+    static bool isActive();
+
+    /** Identifier of the current network. Accumulators with a different
+     *  netId must be recomputed before they can be used. */
+    static U32 currentNetId();
+
+    /** Return the name of the SIMD instruction set used by the kernels. */
+    static std::string simdName();
+
+    /** Compute accumulator from scratch for a position. */
+    static void refresh(const Position& pos, Accumulator& acc);
+
+    /** Incrementally update accumulator. */
+    static void addPiece(Accumulator& acc, int piece, int square);
+    static void removePiece(Accumulator& acc, int piece, int square);
+    static void movePiece(Accumulator& acc, int piece, int fromSq, int toSq);
+
+    /** Evaluate a valid accumulator using the remaining network layers.
+     *  @return Score in centipawns, positive if good for the side to move. */
+    static int evaluate(const Accumulator& acc, bool wtm);
+
+    /** Like evaluate() but uses scalar code. Used to test the SIMD kernels. */
+    static int evaluateScalar(const Accumulator& acc, bool wtm);
+
+private:
+    /** Network parameters, pointing into the loaded network data. */
+    struct Network {
+        const S16* ftBias = nullptr;    // [nHidden]
+        const S16* ftWeights = nullptr; // [nFeatures][nHidden]
+        const S32* l1Bias = nullptr;    // [nL2]
+        const S8* l1Weights = nullptr;  // [nL2][2*nHidden]
+        const S32* l2Bias = nullptr;    // [nL3]
+        const S8* l2Weights = nullptr;  // [nL3][nL2]
+        const S8* outWeights = nullptr; // [nL3]
+        const S32* outBias = nullptr;   // [1]
+    };
+
+    /** Set up network pointers from file data. Return false if invalid. */
+    static bool initNetwork(const U8* data, size_t len, std::string& errMsg);
+    /** Release network data. */
+    static void unloadNetwork();
+
+    /** Feature index for a piece on a square, seen from a perspective. */
+    static int featureIdx(int persp, int piece, int square);
+
+    static Network net;
+    static bool enabled;
+    static U32 netId;
+};
+
+inline int
+NNUE::featureIdx(int persp, int piece, int square) {
+    if (persp) {
+        piece = Piece::isWhite(piece) ? Piece::makeBlack(piece) : Piece::makeWhite(piece);
+        square ^= 56;
+    }
+    return (piece - 1) * 64 + square;
+}
+
+inline bool
+NNUE::hasNetwork() {
+    return net.ftWeights != nullptr;
+}
+
+inline bool
+NNUE::isActive() {
+    return enabled && hasNetwork();
+}
+
+inline U32
+NNUE::currentNetId() {
+    return netId;
+}
+
+#endif /* NNUE_HPP_ */
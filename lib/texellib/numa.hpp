@@ -47,12 +47,13 @@ public:
     /** Bind current thread to NUMA node determined by nodeForThread(). */
     void bindThread(int threadNo) const;
 
+    /** Preferred node for a given search thread, or -1 if NUMA awareness
+     *  is not available or disabled. */
+    int nodeForThread(int threadNo) const;
+
 private:
     Numa();
 
-    /** Preferred node for a given search thread. */
-    int nodeForThread(int threadNo) const;
-
     struct NodeInfo {
         int node = 0;
         int numCores = 0;
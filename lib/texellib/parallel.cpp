@@ -118,6 +118,10 @@ Communicator::sendInitSearch(const Position& pos,
                              bool clearHistory, int whiteContempt) {
     nodesSearched = 0;
     tbHits = 0;
+    {
+        std::lock_guard<std::mutex> L(mutex);
+        searchStats.clear();
+    }
     for (auto& c : children)
         c->doSendInitSearch(pos, posHashList, posHashListSize, clearHistory, whiteContempt);
 }
@@ -165,15 +169,23 @@ Communicator::sendReportResult(int jobId, int score) {
 }
 
 void
-Communicator::sendReportStats(S64 nodesSearched, S64 tbHits, bool propagate) {
+Communicator::sendReportStats(S64 nodesSearched, S64 tbHits, const SearchStats& stats,
+                              bool propagate) {
     if (parent && propagate) {
-        retrieveStats(nodesSearched, tbHits);
-        parent->doSendReportStats(nodesSearched, tbHits);
+        SearchStats totStats(stats);
+        retrieveStats(nodesSearched, tbHits, totStats);
+        parent->doSendReportStats(nodesSearched, tbHits, totStats);
     } else {
-        doSendReportStats(nodesSearched, tbHits);
+        doSendReportStats(nodesSearched, tbHits, stats);
     }
 }
 
+SearchStats
+Communicator::getSearchStats() {
+    std::lock_guard<std::mutex> L(mutex);
+    return searchStats;
+}
+
 void
 Communicator::sendStopAck(bool child) {
     if (child) {
@@ -380,6 +392,7 @@ U8*
 Communicator::ReportStatsCommand::toByteBuf(U8* buffer) const {
     buffer = Command::toByteBuf(buffer);
     buffer = Serializer::serialize<64>(buffer, nodesSearched, tbHits);
+    buffer = searchStats.toByteBuf(buffer);
     return buffer;
 }
 
@@ -387,6 +400,7 @@ const U8*
 Communicator::ReportStatsCommand::fromByteBuf(const U8* buffer) {
     buffer = Command::fromByteBuf(buffer);
     buffer = Serializer::deSerialize<64>(buffer, nodesSearched, tbHits);
+    buffer = searchStats.fromByteBuf(buffer);
     return buffer;
 }
 
@@ -517,19 +531,24 @@ ThreadCommunicator::doSendReportResult(int jobId, int score) {
 }
 
 void
-ThreadCommunicator::doSendReportStats(S64 nodesSearched, S64 tbHits) {
+ThreadCommunicator::doSendReportStats(S64 nodesSearched, S64 tbHits,
+                                      const SearchStats& stats) {
     std::lock_guard<std::mutex> L(mutex);
     this->nodesSearched += nodesSearched;
     this->tbHits += tbHits;
+    searchStats += stats;
 }
 
 void
-ThreadCommunicator::retrieveStats(S64& nodesSearched, S64& tbHits) {
+ThreadCommunicator::retrieveStats(S64& nodesSearched, S64& tbHits,
+                                  SearchStats& stats) {
     std::lock_guard<std::mutex> L(mutex);
     nodesSearched += this->nodesSearched;
     tbHits += this->tbHits;
+    stats += searchStats;
     this->nodesSearched = 0;
     this->tbHits = 0;
+    searchStats.clear();
 }
 
 void
@@ -730,8 +749,8 @@ WorkerThread::sendReportResult(int jobId, int score) {
 }
 
 void
-WorkerThread::sendReportStats(S64 nodesSearched, S64 tbHits) {
-    comm->sendReportStats(nodesSearched, tbHits, true);
+WorkerThread::sendReportStats(S64 nodesSearched, S64 tbHits, const SearchStats& stats) {
+    comm->sendReportStats(nodesSearched, tbHits, stats, true);
 }
 
 class ThreadStopHandler : public Search::StopHandler {
@@ -758,6 +777,7 @@ private:
     int counter;             // Counts number of calls to shouldStop
     S64 lastReportedNodes;
     S64 lastReportedTbHits;
+    SearchStats lastReportedStats;
 };
 
 ThreadStopHandler::ThreadStopHandler(WorkerThread& wt, int jobId, const Search& sc,
@@ -795,13 +815,19 @@ ThreadStopHandler::reportNodes() {
     S64 tbHits = totTbHits - lastReportedTbHits;
     lastReportedTbHits = totTbHits;
 
-    wt.sendReportStats(nodes, tbHits);
+    SearchStats totStats = sc.getSearchStatsThisThread();
+    SearchStats stats(totStats);
+    stats -= lastReportedStats;
+    lastReportedStats = totStats;
+
+    wt.sendReportStats(nodes, tbHits, stats);
 }
 
 void
 WorkerThread::doSearch(CommHandler& commHandler) {
     if (!et)
         et = Evaluate::getEvalHashTables();
+    et->updateSize(threadNo);
     if (!kt)
         kt = make_unique<KillerTable>();
     if (!ht)
@@ -28,6 +28,7 @@
 
 #include "evaluate.hpp"
 #include "searchUtil.hpp"
+#include "searchStats.hpp"
 #include "constants.hpp"
 #include "util/timeUtil.hpp"
 
@@ -110,7 +111,8 @@ public:
 
     void sendReportResult(int jobId, int score);
 
-    void sendReportStats(S64 nodesSearched, S64 tbHits, bool propagate);
+    void sendReportStats(S64 nodesSearched, S64 tbHits, const SearchStats& stats,
+                         bool propagate);
 
     void sendStopAck(bool child);
     /** Forward stop ack from cluster child. */
@@ -152,6 +154,9 @@ public:
     S64 getNumSearchedNodes() const;
     S64 getTbHits() const;
 
+    /** Get search statistics for all helper threads. */
+    SearchStats getSearchStats();
+
 protected:
     virtual void doSendAssignThreads(int nThreads, int firstThreadNo) = 0;
     virtual void doSendInitSearch(const Position& pos,
@@ -164,8 +169,10 @@ protected:
     virtual void doSendQuit() = 0;
 
     virtual void doSendReportResult(int jobId, int score) = 0;
-    virtual void doSendReportStats(S64 nodesSearched, S64 tbHits) = 0;
-    virtual void retrieveStats(S64& nodesSearched, S64& tbHits) = 0;
+    virtual void doSendReportStats(S64 nodesSearched, S64 tbHits,
+                                   const SearchStats& stats) = 0;
+    virtual void retrieveStats(S64& nodesSearched, S64& tbHits,
+                               SearchStats& stats) = 0;
     virtual void doSendStopAck() = 0;
     virtual void doSendQuitAck() = 0;
 
@@ -263,14 +270,16 @@ protected:
     };
     struct ReportStatsCommand : public Command {
         ReportStatsCommand() {}
-        ReportStatsCommand(S64 nodesSearched, S64 tbHits)
-            : Command(REPORT_STATS), nodesSearched(nodesSearched), tbHits(tbHits) {
+        ReportStatsCommand(S64 nodesSearched, S64 tbHits, const SearchStats& stats)
+            : Command(REPORT_STATS), nodesSearched(nodesSearched), tbHits(tbHits),
+              searchStats(stats) {
         }
         U8* toByteBuf(U8* buffer) const override;
         const U8* fromByteBuf(const U8* buffer) override;
 
         S64 nodesSearched = 0;
         S64 tbHits = 0;
+        SearchStats searchStats;
     };
     std::deque<std::shared_ptr<Command>> cmdQueue;
 
@@ -281,6 +290,7 @@ protected:
 
     std::atomic<S64> nodesSearched{0};
     std::atomic<S64> tbHits{0};
+    SearchStats searchStats; // Protected by mutex
 };
 
 
@@ -309,8 +319,10 @@ protected:
     void doSendQuit() override;
 
     void doSendReportResult(int jobId, int score) override;
-    void doSendReportStats(S64 nodesSearched, S64 tbHits) override;
-    void retrieveStats(S64& nodesSearched, S64& tbHits) override;
+    void doSendReportStats(S64 nodesSearched, S64 tbHits,
+                           const SearchStats& stats) override;
+    void retrieveStats(S64& nodesSearched, S64& tbHits,
+                       SearchStats& stats) override;
     void doSendStopAck() override;
     void doSendQuitAck() override;
 
@@ -350,8 +362,8 @@ public:
     /** Send search result to parent. */
     void sendReportResult(int jobId, int score);
 
-    /** Send node counters to parent. */
-    void sendReportStats(S64 nodesSearched, S64 tbHits);
+    /** Send node counters and search statistics to parent. */
+    void sendReportStats(S64 nodesSearched, S64 tbHits, const SearchStats& stats);
 
     /** Return thread number. The first worker thread is number 1. */
     int getThreadNo() const;
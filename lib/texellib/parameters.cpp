@@ -50,6 +50,18 @@ namespace UciParams {
     std::shared_ptr<CheckParam> analysisAgeHash(std::make_shared<CheckParam>("AnalysisAgeHash", true));
     std::shared_ptr<ButtonParam> clearHash(std::make_shared<ButtonParam>("Clear Hash"));
 
+    std::shared_ptr<SpinParam> pawnHashEntries(std::make_shared<SpinParam>("PawnHashEntries", 2, 1<<24, 1<<16));
+    std::shared_ptr<SpinParam> kingSafetyHashEntries(std::make_shared<SpinParam>("KingSafetyHashEntries", 2, 1<<24, 1<<15));
+    std::shared_ptr<SpinParam> evalHashEntries(std::make_shared<SpinParam>("EvalHashEntries", 1, 1<<24, 1<<16));
+
+    std::shared_ptr<CheckParam> sharedEvalHash(std::make_shared<CheckParam>("SharedEvalHash", false));
+    std::shared_ptr<SpinParam> sharedPawnHashEntries(std::make_shared<SpinParam>("SharedPawnHashEntries", 2, 1<<26, 1<<20));
+    std::shared_ptr<SpinParam> sharedKingSafetyHashEntries(std::make_shared<SpinParam>("SharedKingSafetyHashEntries", 2, 1<<26, 1<<20));
+    std::shared_ptr<CheckParam> sharedEvalHashPerNode(std::make_shared<CheckParam>("SharedEvalHashPerNode", true));
+    std::shared_ptr<SpinParam> sharedEvalHashLocalEntries(std::make_shared<SpinParam>("SharedEvalHashLocalEntries", 2, 1<<24, 1<<12));
+
+    std::shared_ptr<StringParam> timeLogFile(std::make_shared<StringParam>("TimeLogFile", ""));
+
     std::shared_ptr<SpinParam> strength(std::make_shared<SpinParam>("Strength", 0, 1000, 1000));
     std::shared_ptr<SpinParam> maxNPS(std::make_shared<SpinParam>("MaxNPS", 0, 10000000, 0));
     std::shared_ptr<CheckParam> limitStrength(std::make_shared<CheckParam>("UCI_LimitStrength", false));
@@ -67,6 +79,11 @@ namespace UciParams {
     std::shared_ptr<SpinParam> minProbeDepth(std::make_shared<SpinParam>("MinProbeDepth", 0, 100, 1));
     std::shared_ptr<SpinParam> minProbeDepth6(std::make_shared<SpinParam>("MinProbeDepth6", 0, 100, 1));
     std::shared_ptr<SpinParam> minProbeDepth7(std::make_shared<SpinParam>("MinProbeDepth7", 0, 100, 10));
+
+#ifdef HAS_NNUE
+    std::shared_ptr<CheckParam> useNNUE(std::make_shared<CheckParam>("UseNNUE", false));
+    std::shared_ptr<StringParam> evalFile(std::make_shared<StringParam>("EvalFile", ""));
+#endif
 }
 
 int pieceValue[Piece::nPieceTypes];
@@ -130,6 +147,9 @@ DEFINE_PARAM(pawnStormBonus);
 DEFINE_PARAM(tempoBonusMG);
 DEFINE_PARAM(tempoBonusEG);
 
+DEFINE_PARAM(lazyEvalMarginMG);
+DEFINE_PARAM(lazyEvalMarginEG);
+
 DEFINE_PARAM(pawnLoMtrl);
 DEFINE_PARAM(pawnHiMtrl);
 DEFINE_PARAM(minorLoMtrl);
@@ -648,6 +668,18 @@ Parameters::Parameters() {
     addPar(UciParams::analysisAgeHash);
     addPar(UciParams::clearHash);
 
+    addPar(UciParams::pawnHashEntries);
+    addPar(UciParams::kingSafetyHashEntries);
+    addPar(UciParams::evalHashEntries);
+
+    addPar(UciParams::sharedEvalHash);
+    addPar(UciParams::sharedPawnHashEntries);
+    addPar(UciParams::sharedKingSafetyHashEntries);
+    addPar(UciParams::sharedEvalHashPerNode);
+    addPar(UciParams::sharedEvalHashLocalEntries);
+
+    addPar(UciParams::timeLogFile);
+
     addPar(UciParams::strength);
     addPar(UciParams::maxNPS);
     addPar(UciParams::limitStrength);
@@ -666,6 +698,11 @@ Parameters::Parameters() {
     addPar(UciParams::minProbeDepth6);
     addPar(UciParams::minProbeDepth7);
 
+#ifdef HAS_NNUE
+    addPar(UciParams::useNNUE);
+    addPar(UciParams::evalFile);
+#endif
+
     // Evaluation parameters
     REGISTER_PARAM(pV, "PawnValue");
     REGISTER_PARAM(nV, "KnightValue");
@@ -726,6 +763,9 @@ Parameters::Parameters() {
     REGISTER_PARAM(tempoBonusMG, "TempoBonusMG");
     REGISTER_PARAM(tempoBonusEG, "TempoBonusEG");
 
+    REGISTER_PARAM(lazyEvalMarginMG, "LazyEvalMarginMG");
+    REGISTER_PARAM(lazyEvalMarginEG, "LazyEvalMarginEG");
+
     REGISTER_PARAM(pawnLoMtrl, "PawnLoMtrl");
     REGISTER_PARAM(pawnHiMtrl, "PawnHiMtrl");
     REGISTER_PARAM(minorLoMtrl, "MinorLoMtrl");
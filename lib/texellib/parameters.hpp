@@ -377,6 +377,24 @@ namespace UciParams {
     extern std::shared_ptr<Parameters::CheckParam> analysisAgeHash;
     extern std::shared_ptr<Parameters::ButtonParam> clearHash;
 
+    // Number of entries in per-thread evaluation hash tables, rounded down to a power of 2
+    extern std::shared_ptr<Parameters::SpinParam> pawnHashEntries;
+    extern std::shared_ptr<Parameters::SpinParam> kingSafetyHashEntries;
+    extern std::shared_ptr<Parameters::SpinParam> evalHashEntries;
+
+    // Pawn and king safety hash tables shared by all search threads, used in
+    // addition to the per-thread tables. Optionally one copy per NUMA node.
+    extern std::shared_ptr<Parameters::CheckParam> sharedEvalHash;
+    extern std::shared_ptr<Parameters::SpinParam> sharedPawnHashEntries;
+    extern std::shared_ptr<Parameters::SpinParam> sharedKingSafetyHashEntries;
+    extern std::shared_ptr<Parameters::CheckParam> sharedEvalHashPerNode;
+    // Max number of entries in the per-thread pawn and king safety tables when
+    // the shared tables are used, rounded down to a power of 2
+    extern std::shared_ptr<Parameters::SpinParam> sharedEvalHashLocalEntries;
+
+    /** If not empty, time usage information is appended to this file after each move. */
+    extern std::shared_ptr<Parameters::StringParam> timeLogFile;
+
     extern std::shared_ptr<Parameters::SpinParam> strength;
     extern std::shared_ptr<Parameters::SpinParam> maxNPS;
     extern std::shared_ptr<Parameters::CheckParam> limitStrength;
@@ -394,6 +412,11 @@ namespace UciParams {
     extern std::shared_ptr<Parameters::SpinParam> minProbeDepth;  // Generic min TB probe depth
     extern std::shared_ptr<Parameters::SpinParam> minProbeDepth6; // Min probe depth for 6-men
     extern std::shared_ptr<Parameters::SpinParam> minProbeDepth7; // Min probe depth for 7-men
+
+#ifdef HAS_NNUE
+    extern std::shared_ptr<Parameters::CheckParam> useNNUE;
+    extern std::shared_ptr<Parameters::StringParam> evalFile;
+#endif
 }
 
 // ----------------------------------------------------------------------------
@@ -464,6 +487,9 @@ DECLARE_PARAM(pawnStormBonus,            12, 0, 20, useUciParam);
 DECLARE_PARAM(tempoBonusMG, 8, -100, 100, useUciParam);
 DECLARE_PARAM(tempoBonusEG, 3, -100, 100, useUciParam);
 
+DECLARE_PARAM(lazyEvalMarginMG, 800, 0, 2000, useUciParam);
+DECLARE_PARAM(lazyEvalMarginEG, 300, 0, 2000, useUciParam);
+
 DECLARE_PARAM(pawnLoMtrl,          1007, 0, 10000, useUciParam);
 DECLARE_PARAM(pawnHiMtrl,          6415, 0, 10000, useUciParam);
 DECLARE_PARAM(minorLoMtrl,         2228, 0, 10000, useUciParam);
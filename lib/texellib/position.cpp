@@ -189,11 +189,21 @@ Position::hashAfterMove(const Move& move) const {
 
 void
 Position::makeMove(const Move& move, UndoInfo& ui) {
+    if (whiteMove)
+        makeMove<true>(move, ui);
+    else
+        makeMove<false>(move, ui);
+}
+
+template <bool wtm>
+void
+Position::makeMove(const Move& move, UndoInfo& ui) {
+    using MyColor = ColorTraits<wtm>;
+    using OtherColor = ColorTraits<!wtm>;
     ui.capturedPiece = squares[move.to()];
     ui.castleMask = castleMask;
     ui.epSquare = epSquare;
     ui.halfMoveClock = halfMoveClock;
-    bool wtm = whiteMove;
 
     hashKey ^= whiteHashKey;
 
@@ -204,25 +214,19 @@ Position::makeMove(const Move& move, UndoInfo& ui) {
     int prevEpSquare = epSquare;
     setEpSquare(-1);
 
-    if ((capP != Piece::EMPTY) || ((pieceTypeBB(Piece::WPAWN, Piece::BPAWN) & fromMask) != 0)) {
+    if ((capP != Piece::EMPTY) || ((pieceTypeBB(MyColor::PAWN) & fromMask) != 0)) {
         halfMoveClock = 0;
 
         // Handle en passant and epSquare
-        if (p == Piece::WPAWN) {
-            if (move.to() - move.from() == 2 * 8) {
+        if (p == MyColor::PAWN) {
+            const int fwd = wtm ? 8 : -8;
+            if (move.to() - move.from() == 2 * fwd) {
                 int x = Square::getX(move.to());
-                if (BitBoard::epMaskW[x] & pieceTypeBB(Piece::BPAWN))
-                    setEpSquare(move.from() + 8);
+                U64 epMask = wtm ? BitBoard::epMaskW[x] : BitBoard::epMaskB[x];
+                if (epMask & pieceTypeBB(OtherColor::PAWN))
+                    setEpSquare(move.from() + fwd);
             } else if (move.to() == prevEpSquare) {
-                clearPiece(move.to() - 8);
-            }
-        } else if (p == Piece::BPAWN) {
-            if (move.to() - move.from() == -2 * 8) {
-                int x = Square::getX(move.to());
-                if (BitBoard::epMaskB[x] & pieceTypeBB(Piece::WPAWN))
-                    setEpSquare(move.from() - 8);
-            } else if (move.to() == prevEpSquare) {
-                clearPiece(move.to() + 8);
+                clearPiece(move.to() - fwd);
             }
         }
 
@@ -233,7 +237,7 @@ Position::makeMove(const Move& move, UndoInfo& ui) {
         halfMoveClock++;
 
         // Handle castling
-        if ((pieceTypeBB(Piece::WKING, Piece::BKING) & fromMask) != 0) {
+        if ((pieceTypeBB(MyColor::KING) & fromMask) != 0) {
             int k0 = move.from();
             if (move.to() == k0 + 2) { // O-O
                 movePieceNotPawn(k0 + 3, k0 + 1);
@@ -253,6 +257,9 @@ Position::makeMove(const Move& move, UndoInfo& ui) {
     whiteMove = !wtm;
 }
 
+template void Position::makeMove<true>(const Move& move, UndoInfo& ui);
+template void Position::makeMove<false>(const Move& move, UndoInfo& ui);
+
 void
 Position::makeMoveB(const Move& move, UndoInfo& ui) {
     ui.capturedPiece = squares[move.to()];
@@ -135,8 +135,14 @@ public:
 
     /** Apply a move to the current position. */
     void makeMove(const Move& move, UndoInfo& ui);
+    /** Like makeMove(), but specialized for the side to move. wtm must be
+     *  equal to isWhiteMove(). */
+    template <bool wtm> void makeMove(const Move& move, UndoInfo& ui);
 
     void unMakeMove(const Move& move, const UndoInfo& ui);
+    /** Like unMakeMove(), but specialized for the side that made the move.
+     *  wtm must be equal to !isWhiteMove(). */
+    template <bool wtm> void unMakeMove(const Move& move, const UndoInfo& ui);
 
     /** Special make move functions used by MoveGen::isLegal(). Does not update all data members. */
     void makeMoveB(const Move& move, UndoInfo& ui);
@@ -209,6 +215,36 @@ private:
     void movePieceNotPawnB(int from, int to);
 
 
+#ifdef COMPACT_POSITION
+    // Same data as below, but with small types and the most frequently used
+    // data first, so that the position needs fewer cache lines.
+    U64 pieceTypeBB_[Piece::nPieceTypes];
+    U64 whiteBB_, blackBB_;
+
+    U64 hashKey;           // Cached Zobrist hash key
+    U64 pHashKey;          // Cached Zobrist pawn hash key
+    MatId matId;           // Cached material identifier
+
+    int wMtrl_;              // Total value of all white pieces and pawns
+    int bMtrl_;              // Total value of all black pieces and pawns
+    int wMtrlPawns_;         // Total value of all white pawns
+    int bMtrlPawns_;         // Total value of all black pawns
+
+    /** Number of half-moves since last 50-move reset. */
+    int halfMoveClock;
+    /** Game move number, starting from 1. */
+    int fullMoveCounter;
+
+    S8 epSquare;
+    U8 castleMask;
+    bool whiteMove;
+
+    U8 squares[64];
+
+    // Piece square table scores
+    short psScore1_[Piece::nPieceTypes];
+    short psScore2_[Piece::nPieceTypes];
+#else
     int wMtrl_;              // Total value of all white pieces and pawns
     int bMtrl_;              // Total value of all black pieces and pawns
     int wMtrlPawns_;         // Total value of all white pawns
@@ -238,6 +274,7 @@ private:
     U64 hashKey;           // Cached Zobrist hash key
     U64 pHashKey;          // Cached Zobrist pawn hash key
     MatId matId;           // Cached material identifier
+#endif
 
     static U8 castleSqMask[64]; // Castle masks retained for each square
 
@@ -428,25 +465,34 @@ Position::getKingSq(bool white) const {
 
 inline void
 Position::unMakeMove(const Move& move, const UndoInfo& ui) {
+    if (whiteMove)
+        unMakeMove<false>(move, ui);
+    else
+        unMakeMove<true>(move, ui);
+}
+
+template <bool wtm>
+inline void
+Position::unMakeMove(const Move& move, const UndoInfo& ui) {
+    using MyColor = ColorTraits<wtm>;
+    using OtherColor = ColorTraits<!wtm>;
     hashKey ^= whiteHashKey;
-    whiteMove = !whiteMove;
+    whiteMove = wtm;
     int p = squares[move.to()];
     setPiece(move.from(), p);
     setPiece(move.to(), ui.capturedPiece);
     setCastleMask(ui.castleMask);
     setEpSquare(ui.epSquare);
     halfMoveClock = ui.halfMoveClock;
-    bool wtm = whiteMove;
     if (move.promoteTo() != Piece::EMPTY) {
-        p = wtm ? Piece::WPAWN : Piece::BPAWN;
+        p = MyColor::PAWN;
         setPiece(move.from(), p);
     }
     if (!wtm)
         fullMoveCounter--;
 
     // Handle castling
-    int king = wtm ? Piece::WKING : Piece::BKING;
-    if (p == king) {
+    if (p == MyColor::KING) {
         int k0 = move.from();
         if (move.to() == k0 + 2) { // O-O
             movePieceNotPawn(k0 + 1, k0 + 3);
@@ -456,13 +502,8 @@ Position::unMakeMove(const Move& move, const UndoInfo& ui) {
     }
 
     // Handle en passant
-    if (move.to() == epSquare) {
-        if (p == Piece::WPAWN) {
-            setPiece(move.to() - 8, Piece::BPAWN);
-        } else if (p == Piece::BPAWN) {
-            setPiece(move.to() + 8, Piece::WPAWN);
-        }
-    }
+    if ((move.to() == epSquare) && (p == MyColor::PAWN))
+        setPiece(move.to() + (wtm ? -8 : 8), OtherColor::PAWN);
 }
 
 inline void
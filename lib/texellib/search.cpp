@@ -48,6 +48,12 @@ Search::Search(const Position& pos0, const std::vector<U64>& posHashList0,
                TreeLogger& logFile)
     : eval(st.et), kt(st.kt), ht(st.ht), tt(st.tt), comm(comm), threadNo(0),
       logFile(logFile) {
+#ifdef COPY_MAKE
+    posStack.resize(COUNT_OF(searchTreeInfo));
+#endif
+#ifdef HAS_NNUE
+    eval.setNNUEStack(&nnueStack);
+#endif
     stopHandler = make_unique<DefaultStopHandler>(*this);
     init(pos0, posHashList0, posHashListSize0);
 }
@@ -69,7 +75,13 @@ Search::init(const Position& pos0, const std::vector<U64>& posHashList0,
     tLastStats = currentTimeMillis();
     totalNodes = 0;
     tbHits = 0;
+    stats.clear();
+    eval.clearHashStats();
+    nHelperJobs = 0;
+    nHelperResults = 0;
+    nHelperResultsUsed = 0;
     nodesToGo = 0;
+    timeUsed = 0;
 }
 
 void
@@ -79,6 +91,21 @@ Search::timeLimit(int minTimeLimit, int maxTimeLimit, int earlyStopPercent) {
     earlyStopPercentage = (earlyStopPercent > 0 ? earlyStopPercent : minTimeUsage);
 }
 
+double
+Search::nodeFractionHardFactor(double f) {
+    if      (f < 0.20) return 3.5;
+    else if (f < 0.40) return 3.5 + (1.0 - 3.5) * (f - 0.20) / (0.40 - 0.20);
+    else if (f < 0.60) return 1.0;
+    else if (f < 0.85) return 1.0 + (0.3 - 1.0) * (f - 0.60) / (0.85 - 0.60);
+    else               return 0.3;
+}
+
+void
+Search::getTimeLogEntry(TimeLog::Entry& entry) const {
+    entry.timeUsed = timeUsed;
+    entry.iterations = iterationLog;
+}
+
 void
 Search::setStrength(int strength, U64 randomSeed, int maxNPS) {
     if (strength < 0) strength = 0;
@@ -107,7 +134,14 @@ Search::iterativeDeepening(const MoveList& scMovesIn,
     tStart = currentTimeMillis();
     totalNodes = 0;
     tbHits = 0;
+    stats.clear();
+    eval.clearHashStats();
+    nHelperJobs = 0;
+    nHelperResults = 0;
+    nHelperResultsUsed = 0;
     nodesToGo = 0;
+    timeUsed = 0;
+    iterationLog.clear();
     if (scMovesIn.size <= 0)
         return Move(); // No moves to search
 
@@ -139,12 +173,15 @@ Search::iterativeDeepening(const MoveList& scMovesIn,
     int posHashFirstNew0 = posHashFirstNew;
     bool knownLoss = false; // True if at least one of the first maxPV moves is a known loss
     hardFactor = 1.0;
+    Move prevBestMove = bestMove;
     try {
     for (int depth = 1; ; depth++, firstIteration = false) {
         if (listener) listener->notifyDepth(depth);
         int aspirationDelta = 0;
         UndoInfo ui;
         bool needMoreTime = false;
+        TimeLog::Iteration iterInfo;
+        iterInfo.depth = depth;
         for (int mi = 0; mi < (int)rootMoves.size(); mi++) {
             posHashFirstNew = posHashFirstNew0 + ((maxPV > 1) ? 1 : 0);
             int alpha, beta;
@@ -177,7 +214,7 @@ Search::iterativeDeepening(const MoveList& scMovesIn,
                 !givesCheck && !passedPawnPush(pos, m) && (mi >= rootLMRMoveCount + maxPV)) {
                 lmrS = 1;
             }
-            pos.makeMove(m, ui);
+            makeMove(m, ui, 0);
             totalNodes++;
             nodesToGo--;
             SearchTreeInfo& sti = searchTreeInfo[0];
@@ -190,7 +227,7 @@ Search::iterativeDeepening(const MoveList& scMovesIn,
                 score = -negaScoutRoot(true, -beta, -alpha, 1, depth - 1, givesCheck);
             nodesThisMove += totalNodes;
             posHashListSize--;
-            pos.unMakeMove(m, ui);
+            unMakeMove(m, ui, 0);
             storeSearchResult(rootMoves, mi, depth, alpha, beta, score);
             if ((mi < maxPV) || (score > rootMoves[maxPV-1].score()))
                 notifyPV(rootMoves, mi, maxPV);
@@ -210,6 +247,7 @@ Search::iterativeDeepening(const MoveList& scMovesIn,
                     if (mi != 0) {
                         needMoreTime = true;
                         hardFactor = std::max(hardFactor, 1.0);
+                        iterInfo.flags |= TimeLog::Iteration::FAIL_HIGH;
                     }
                     bestMove = m;
                 } else { // score <= alpha
@@ -219,14 +257,15 @@ Search::iterativeDeepening(const MoveList& scMovesIn,
                     alphaRetryDelta = alphaRetryDelta * 3 / 2;
                     needMoreTime = searchNeedMoreTime = true;
                     hardFactor = std::max(hardFactor, 2.0);
+                    iterInfo.flags |= TimeLog::Iteration::FAIL_LOW;
                 }
-                pos.makeMove(m, ui);
+                makeMove(m, ui, 0);
                 totalNodes++;
                 nodesToGo--;
                 score = -negaScoutRoot(true, -beta, -alpha, 1, depth - 1, givesCheck);
                 nodesThisMove += totalNodes;
                 posHashListSize--;
-                pos.unMakeMove(m, ui);
+                unMakeMove(m, ui, 0);
                 storeSearchResult(rootMoves, mi, depth, alpha, beta, score);
                 notifyPV(rootMoves, mi, maxPV);
             }
@@ -243,25 +282,30 @@ Search::iterativeDeepening(const MoveList& scMovesIn,
             }
             bestMove = rootMoves[0].move;
             bestExactMove = bestMove;
+            if (!(bestMove == prevBestMove)) {
+                iterInfo.bestMoveChanges++;
+                prevBestMove = bestMove;
+            }
             if (!firstIteration) {
                 S64 timeLimit = needMoreTime ? maxTimeMillis : minTimeMillis;
                 if (timeLimit >= 0) {
                     U64 tNow = currentTimeMillis();
-                    if (tNow - tStart >= (U64)timeLimit)
+                    if (tNow - tStart >= (U64)timeLimit) {
+                        if (mi + 1 < (int)rootMoves.size())
+                            iterInfo.flags |= TimeLog::Iteration::INCOMPLETE;
                         break;
+                    }
                 }
             }
         }
         S64 tNow = currentTimeMillis();
         {
             double f = rootMoves[0].nodes / (double)totalNodes;
-            double hard;
-            if      (f < 0.20) hard = 3.5;
-            else if (f < 0.40) hard = 3.5 + (1.0 - 3.5) * (f - 0.20) / (0.40 - 0.20);
-            else if (f < 0.60) hard = 1.0;
-            else if (f < 0.85) hard = 1.0 + (0.3 - 1.0) * (f - 0.60) / (0.85 - 0.60);
-            else               hard = 0.3;
-            hardFactor = (hardFactor + hard) / 2;
+            iterInfo.timeMillis = tNow - tStart;
+            iterInfo.bestMove = bestMove.getCompressedMove();
+            iterInfo.bestMoveNodes = (int)(f * 1000);
+            iterationLog.push_back(iterInfo);
+            hardFactor = (hardFactor + nodeFractionHardFactor(f)) / 2;
         }
         if (maxTimeMillis >= 0) {
             if (tNow - tStart > minTimeMillis * 0.01 * earlyStopPercentage * hardFactor)
@@ -295,8 +339,15 @@ Search::iterativeDeepening(const MoveList& scMovesIn,
     }
     } catch (const StopSearch&) {
         pos = origPos;
+        TimeLog::Iteration iterInfo;
+        iterInfo.depth = iterationLog.empty() ? 1 : iterationLog.back().depth + 1;
+        iterInfo.timeMillis = currentTimeMillis() - tStart;
+        iterInfo.bestMove = bestMove.getCompressedMove();
+        iterInfo.flags = TimeLog::Iteration::INCOMPLETE;
+        iterationLog.push_back(iterInfo);
     }
     notifyStats();
+    timeUsed = currentTimeMillis() - tStart;
 
     logFile.close();
     return onlyExact ? bestExactMove : bestMove;
@@ -315,6 +366,7 @@ Search::negaScoutRoot(bool tb, int alpha, int beta, int ply, int depth,
                       const bool inCheck) {
     SearchTreeInfo sti = searchTreeInfo[ply-1];
     jobId++;
+    nHelperJobs++;
     comm.sendStartSearch(jobId, sti, alpha, beta, depth);
     U64 nodeIdx = logFile.peekNextNodeIdx();
     Position pos0(pos);
@@ -427,15 +479,18 @@ bool
 Search::shouldStop() {
     class Handler : public Communicator::CommandHandler {
     public:
-        explicit Handler(int jobId) : jobId(jobId) {}
+        explicit Handler(Search& sc) : sc(sc) {}
         void reportResult(int jobId, int score) override {
-            if (jobId == this->jobId)
+            sc.nHelperResults++;
+            if (jobId == sc.jobId) {
+                sc.nHelperResultsUsed++;
                 throw HelperThreadResult(score);
+            }
         }
     private:
-        int jobId;
+        Search& sc;
     };
-    Handler handler(jobId);
+    Handler handler(*this);
     comm.poll(handler);
 
     S64 tNow = currentTimeMillis();
@@ -461,6 +516,34 @@ Search::shouldStop() {
     return false;
 }
 
+inline void
+Search::prefetchMove(const Move& m) {
+    U64 nextHash = pos.hashAfterMove(m);
+    tt.prefetch(nextHash);
+    eval.prefetch(nextHash);
+}
+
+int
+Search::prefetchBest(const MoveList& moves, int startIdx) {
+    const int N = SearchConst::PREFETCH_DISTANCE;
+    int best[N]; // Indices of the best moves, in selectBest() order
+    int nBest = 0;
+    for (int i = startIdx; i < moves.size; i++) {
+        const int score = moves[i].score();
+        if ((nBest == N) && (score <= moves[best[N-1]].score()))
+            continue;
+        int j = (nBest < N) ? nBest++ : N - 1;
+        while ((j > 0) && (moves[best[j-1]].score() < score)) {
+            best[j] = best[j-1];
+            j--;
+        }
+        best[j] = i;
+    }
+    for (int i = 0; i < nBest; i++)
+        prefetchMove(moves[best[i]]);
+    return nBest;
+}
+
 template <bool tb>
 int
 Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
@@ -490,8 +573,7 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
     if (canClaimDraw50(pos)) {
         if (inCheck) {
             MoveList moves;
-            MoveGen::pseudoLegalMoves(pos, moves);
-            MoveGen::removeIllegal(pos, moves);
+            MoveGen::legalMoves(pos, moves);
             if (moves.size == 0) {            // Can't claim draw if already check mated.
                 int score = -(MATE0-(ply+1));
                 logFile.logNodeEnd(searchTreeInfo[ply].nodeIdx, score, TType::T_EXACT, UNKNOWN_SCORE, hKey);
@@ -512,9 +594,13 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
     TranspositionTable::TTEntry ent;
     const bool singularSearch = !sti.singularMove.isEmpty();
     const bool useTT = !singularSearch;
-    if (useTT) tt.probe(hKey, ent);
+    if (useTT) {
+        tt.probe(hKey, ent);
+        stats.addDepth(SearchStats::TT_PROBES, depth);
+    }
     Move hashMove;
     if (ent.getType() != TType::T_EMPTY) {
+        stats.addDepth(SearchStats::TT_HITS, depth);
         int score = ent.getScore(ply);
         evalScore = ent.getEvalScore();
         ent.getMove(hashMove);
@@ -525,6 +611,7 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
                         kt.addKiller(ply, hashMove);
             }
             sti.bestMove = hashMove;
+            stats.addDepth(SearchStats::TT_CUTS, depth);
             logFile.logNodeEnd(sti.nodeIdx, score, ent.getType(), evalScore, hKey);
             return score;
         }
@@ -626,6 +713,7 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
             q0Eval = evalScore;
             int score = quiesce(alpha-razorMargin, beta-razorMargin, ply, 0, inCheck);
             if (score <= alpha-razorMargin) {
+                stats.add(SearchStats::RAZOR_CUTS);
                 emptyMove.setScore(score);
                 if (useTT) tt.insert(hKey, emptyMove, TType::T_LE, ply, depth, q0Eval);
                 logFile.logNodeEnd(sti.nodeIdx, score, TType::T_LE, q0Eval, hKey);
@@ -651,6 +739,7 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
             if (evalScore == UNKNOWN_SCORE)
                 evalScore = eval.evalPos(pos);
             if (evalScore - margin >= beta) {
+                stats.add(SearchStats::REV_FUTILITY_CUTS);
                 emptyMove.setScore(evalScore - margin);
                 if (useTT) tt.insert(hKey, emptyMove, TType::T_GE, ply, depth, evalScore);
                 logFile.logNodeEnd(sti.nodeIdx, evalScore - margin, TType::T_GE, evalScore, hKey);
@@ -681,8 +770,12 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
                 nullOk = false;
         }
         if (nullOk) {
+            stats.add(SearchStats::NULL_MOVE_TRIES);
             int score;
             {
+#ifdef HAS_NNUE
+                nnueStack.pushNull(pos);
+#endif
                 pos.setWhiteMove(!pos.isWhiteMove());
                 const int epSquare = pos.getEpSquare();
                 pos.setEpSquare(-1);
@@ -690,10 +783,16 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
                 searchTreeInfo[ply+1].bestMove.setMove(A1,A1,0,0);
                 const int hmc = pos.getHalfMoveClock();
                 pos.setHalfMoveClock(0);
+#ifdef HAS_NNUE
+                nnueStack.setKey(pos.zobristHash());
+#endif
                 score = -negaScout(tb, -beta, -(beta - 1), ply + 1, depth - R, -1, false);
                 pos.setEpSquare(epSquare);
                 pos.setWhiteMove(!pos.isWhiteMove());
                 pos.setHalfMoveClock(hmc);
+#ifdef HAS_NNUE
+                nnueStack.pop();
+#endif
                 searchTreeInfo[ply+1].allowNullMove = true;
             }
             if ((score >= beta) && (depth >= 10)) {
@@ -717,6 +816,7 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
                 sti3.bestMove.setMove(A1,A1,0,0);
             }
             if (score >= beta) {
+                stats.add(SearchStats::NULL_MOVE_CUTS);
                 if (isWinScore(score))
                     score = beta;
                 emptyMove.setScore(score);
@@ -766,21 +866,16 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
         }
     }
 
-    // Generate move list
+    // Set up move generation
     MoveList moves;
-    if (inCheck)
-        MoveGen::checkEvasions(pos, moves);
-    else
-        MoveGen::pseudoLegalMoves(pos, moves);
-    bool seeDone = false;
-    bool hashMoveSelected = true;
-    if (hashMove.isEmpty() || !selectHashMove(moves, hashMove)) {
-        scoreMoveList(moves, ply);
-        seeDone = true;
-        hashMoveSelected = false;
-    }
+    MovePicker picker(*this, moves, hashMove, ply, inCheck);
+#ifdef PREFETCH_PIPELINE
+    picker.setPrefetch(!futilityPrune); // Most moves are pruned without a hash probe otherwise
+#endif
+    const bool hashMoveSelected = picker.hashMoveSelected();
 
     // Handle singular extension
+    AttackInfo& ai = attackInfo[ply];
     bool singularExtend = false;
     if ((depth > 6) &&
             hashMoveSelected && !singularSearch &&
@@ -789,7 +884,7 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
             (!isWinScore(std::abs(ent.getScore(ply))) || !normalBound) &&
             (getMoveExtend(hashMove, recaptureSquare) <= 0) &&
             (ply + depth < MAX_SEARCH_DEPTH) &&
-            MoveGen::isLegal(pos, hashMove, inCheck)) {
+            MoveGen::isLegal(pos, hashMove, ai)) {
         SearchTreeInfo& sti2 = searchTreeInfo[ply-1];
         const Move savedMove = sti2.currentMove;
         const int savedMoveNo = sti2.currentMoveNo;
@@ -854,33 +949,35 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
     bool allDone = false;
     for (int pass = 0; pass < 2 && !allDone; pass++) {
         allDone = true;
-        for (int mi = 0; mi < moves.size; mi++) {
-            if (pass > 0 && moves[mi].score() > BUSY)
-                continue;
+        for (int mi = 0; ; mi++) {
             if (pass == 0) {
-                if ((mi == 1) && !seeDone) {
-                    scoreMoveList(moves, ply, 1);
-                    seeDone = true;
-                }
-                if ((mi < lmpMoveCountLimit) || (depth >= 2 && lmrCount <= lmrMoveCountLimit1))
-                    if ((mi > 0) || !hashMoveSelected)
-                        selectBest(moves, mi);
+                bool sort = (mi < lmpMoveCountLimit) || (depth >= 2 && lmrCount <= lmrMoveCountLimit1);
+                if (!picker.next(mi, sort))
+                    break;
+            } else {
+                if (mi >= moves.size)
+                    break;
+                if (moves[mi].score() > BUSY)
+                    continue;
             }
             Move& m = moves[mi];
             bool isCapture = (pos.getPiece(m.to()) != Piece::EMPTY);
             bool isPromotion = (m.promoteTo() != Piece::EMPTY);
             int sVal = std::numeric_limits<int>::min();
             bool mayReduce = (m.score() < 30) && (!isCapture || m.score() < 0) && !isPromotion;
-            bool givesCheck = MoveGen::givesCheck(pos, m);
+            bool givesCheck = MoveGen::givesCheck(pos, m, ai);
             bool doFutility = false;
             if ((pass == 0) && mayReduce && haveLegalMoves && !givesCheck && !passedPawnPush(pos, m)) {
-                if (normalBound && !isLoseScore(bestScore) && (mi >= lmpMoveCountLimit))
+                if (normalBound && !isLoseScore(bestScore) && (mi >= lmpMoveCountLimit)) {
+                    stats.add(SearchStats::LMP_PRUNES);
                     continue; // Late move pruning
+                }
                 if (futilityPrune)
                     doFutility = true;
             }
             int score = illegalScore;
             if (doFutility) {
+                stats.add(SearchStats::FUTILITY_PRUNES);
                 score = futilityScore;
             } else {
 #ifdef HAS_PREFETCH
@@ -891,8 +988,8 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
                 if (pass == 0) {
                     if ((mi == 0) && m == sti.singularMove)
                         continue;
-                    if (!MoveGen::isLegal(pos, m, inCheck))
-                        continue;
+                    if (!inCheck && !MoveGen::isLegal(pos, m, ai))
+                        continue; // Check evasions are generated by MoveGen::legalMoves()
                 }
                 int extend = givesCheck && ((depth <= 2) || !negSEE(m)) ? 1 : getMoveExtend(m, recaptureSquare);
                 if (singularExtend && (mi == 0))
@@ -942,9 +1039,12 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
                     }
                 }
                 posHashList[posHashListSize++] = pos.zobristHash();
-                pos.makeMove(m, ui);
+                makeMove(m, ui, ply);
                 totalNodes++;
                 nodesToGo--;
+                stats.add(SearchStats::NODES);
+                if (pass == 0 && lmr > 0)
+                    stats.add(SearchStats::LMR_SEARCHES);
                 sti.currentMove = m;
                 sti.currentMoveNo = mi;
 
@@ -956,17 +1056,19 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
                     m.setScore(BUSY - lmr);
                     allDone = false;
                     posHashListSize--;
-                    pos.unMakeMove(m, ui);
+                    unMakeMove(m, ui, ply);
                     continue;
                 }
                 if (((lmr > 0) && (score > alpha)) ||
                         ((score > alpha) && (score < beta) && (b != beta))) {
+                    if (pass == 0 && lmr > 0)
+                        stats.add(SearchStats::LMR_RESEARCHES);
                     newDepth += lmr;
                     score = -negaScout(tb, -beta, -alpha, ply + 1, newDepth, newCaptureSquare, givesCheck);
                 }
 
                 posHashListSize--;
-                pos.unMakeMove(m, ui);
+                unMakeMove(m, ui, ply);
             }
 
             if (weak && haveLegalMoves)
@@ -983,6 +1085,9 @@ Search::negaScout(int alpha, int beta, int ply, int depth, int recaptureSquare,
                 sti.bestMove.setMove(m.from(), m.to(), m.promoteTo(), sti.bestMove.score());
             }
             if (alpha >= beta) {
+                stats.add(SearchStats::CUT_NODES);
+                if (mi == 0)
+                    stats.add(SearchStats::CUT_FIRST_MOVE);
                 if (pos.getPiece(m.to()) == Piece::EMPTY) {
                     kt.addKiller(ply, m);
                     ht.addSuccess(pos, m, depth);
@@ -1075,8 +1180,7 @@ Search::getRootMoves(const MoveList& rootMovesIn,
     MoveList rootMoves(rootMovesIn);
     if ((maxTimeMillis >= 0) || (maxNodes >= 0) || (maxDepth >= 0)) {
         MoveList legalMoves;
-        MoveGen::pseudoLegalMoves(pos, legalMoves);
-        MoveGen::removeIllegal(pos, legalMoves);
+        MoveGen::legalMoves(pos, legalMoves);
         if (rootMoves.size == legalMoves.size) {
             // Game mode, handle missing TBs
             std::vector<Move> movesToSearch;
@@ -1179,6 +1283,21 @@ Search::defenseMove(const Position& pos, const Move& m) {
     }
 }
 
+void
+Search::quiesceBatch(const Position::SerializeData* data, int n, int* out) {
+    std::vector<int> order;
+    Evaluate::batchOrder(data, n, order);
+    const bool oldUseEvalHash = eval.getUseEvalHash();
+    eval.setUseEvalHash(false);
+    for (int idx : order) {
+        pos.deSerialize(data[idx]);
+        q0Eval = UNKNOWN_SCORE;
+        int score = quiesce(-MATE0, MATE0, 0, 0, MoveGen::inCheck(pos));
+        out[idx] = pos.isWhiteMove() ? score : -score;
+    }
+    eval.setUseEvalHash(oldUseEvalHash);
+}
+
 int
 Search::quiesce(int alpha, int beta, int ply, int depth, const bool inCheck) {
     int score;
@@ -1187,10 +1306,13 @@ Search::quiesce(int alpha, int beta, int ply, int depth, const bool inCheck) {
     } else {
         if ((depth == 0) && (q0Eval != UNKNOWN_SCORE)) {
             score = q0Eval;
-        } else {
+        } else if (depth == 0) {
             score = eval.evalPos(pos);
-            if (depth == 0)
-                q0Eval = score;
+            q0Eval = score;
+        } else {
+            // A lower bound is enough for a stand pat cutoff. Delta pruning
+            // needs the exact score when it is below beta.
+            score = eval.evalPos(pos, -MATE0, beta);
         }
     }
     if (score >= beta)
@@ -1201,28 +1323,13 @@ Search::quiesce(int alpha, int beta, int ply, int depth, const bool inCheck) {
     int bestScore = score;
     const bool tryChecks = (depth > -1);
     MoveList moves;
-    if (inCheck) {
-        MoveGen::checkEvasions(pos, moves);
-    } else if (tryChecks) {
-        MoveGen::pseudoLegalCapturesAndChecks(pos, moves);
-    } else {
-        MoveGen::pseudoLegalCaptures(pos, moves);
-    }
+    MovePicker picker(*this, moves, inCheck, tryChecks);
 
-    bool realInCheckComputed = false;
-    bool realInCheck = false;
-    if (depth > -2) {
-        realInCheckComputed = true;
-        realInCheck = inCheck;
-    }
-    scoreMoveListMvvLva(moves);
+    AttackInfo& ai = attackInfo[ply];
     UndoInfo ui;
-    for (int mi = 0; mi < moves.size; mi++) {
-        if (mi < quiesceMaxSortMoves) {
-            // If the first N moves didn't fail high this is probably an ALL-node,
-            // so spending more effort on move ordering is probably wasted time.
-            selectBest(moves, mi);
-        }
+    // If the first N moves didn't fail high this is probably an ALL-node,
+    // so spending more effort on move ordering is probably wasted time.
+    for (int mi = 0; picker.next(mi, mi < quiesceMaxSortMoves); mi++) {
         const Move& m = moves[mi];
         bool givesCheck = false;
         bool givesCheckComputed = false;
@@ -1233,7 +1340,7 @@ Search::quiesce(int alpha, int beta, int ply, int depth, const bool inCheck) {
                 // Non-capture
                 if (!tryChecks)
                     continue;
-                givesCheck = MoveGen::givesCheck(pos, m);
+                givesCheck = MoveGen::givesCheck(pos, m, ai);
                 givesCheckComputed = true;
                 if (!givesCheck)
                     continue;
@@ -1249,7 +1356,7 @@ Search::quiesce(int alpha, int beta, int ply, int depth, const bool inCheck) {
                     if ((pos.wMtrlPawns() > 0) && (pos.wMtrl() > capt + pos.wMtrlPawns()) &&
                         (pos.bMtrlPawns() > 0) && (pos.bMtrl() > capt + pos.bMtrlPawns())) {
                         if (depth -1 > -2) {
-                            givesCheck = MoveGen::givesCheck(pos, m);
+                            givesCheck = MoveGen::givesCheck(pos, m, ai);
                             givesCheckComputed = true;
                         }
                         if (!givesCheck) {
@@ -1263,22 +1370,21 @@ Search::quiesce(int alpha, int beta, int ply, int depth, const bool inCheck) {
         }
         if (depth < -6 && mi >= 2)
             continue;
-        if (!realInCheckComputed) {
-            realInCheck = MoveGen::inCheck(pos);
-            realInCheckComputed = true;
+        if (!inCheck) { // Check evasions are generated by MoveGen::legalMoves()
+            if (!MoveGen::isLegal(pos, m, ai))
+                continue;
         }
-        if (!MoveGen::isLegal(pos, m, realInCheck))
-            continue;
 
         if (!givesCheckComputed && (depth - 1 > -2))
-            givesCheck = MoveGen::givesCheck(pos, m);
+            givesCheck = MoveGen::givesCheck(pos, m, ai);
         const bool nextInCheck = (depth - 1) > -2 ? givesCheck : false;
 
-        pos.makeMove(m, ui);
+        makeMove(m, ui, ply);
         totalNodes++;
         nodesToGo--;
+        stats.add(SearchStats::QNODES);
         score = -quiesce(-beta, -alpha, ply + 1, depth - 1, nextInCheck);
-        pos.unMakeMove(m, ui);
+        unMakeMove(m, ui, ply);
         if (score > bestScore) {
             bestScore = score;
             if (score > alpha) {
@@ -1295,8 +1401,61 @@ Search::quiesce(int alpha, int beta, int ply, int depth, const bool inCheck) {
     return bestScore;
 }
 
+U64
+Search::seeAttackers(const Position& pos, int square, U64 occupied) {
+    U64 atk = BitBoard::bPawnAttacks(square) & pos.pieceTypeBB(Piece::WPAWN);
+    atk |= BitBoard::wPawnAttacks(square) & pos.pieceTypeBB(Piece::BPAWN);
+    atk |= BitBoard::knightAttacks(square) & pos.pieceTypeBB(Piece::WKNIGHT, Piece::BKNIGHT);
+    atk |= BitBoard::kingAttacks(square) & pos.pieceTypeBB(Piece::WKING, Piece::BKING);
+    atk |= BitBoard::bishopAttacks(square, occupied) &
+           pos.pieceTypeBB(Piece::WBISHOP, Piece::BBISHOP, Piece::WQUEEN, Piece::BQUEEN);
+    atk |= BitBoard::rookAttacks(square, occupied) &
+           pos.pieceTypeBB(Piece::WROOK, Piece::BROOK, Piece::WQUEEN, Piece::BQUEEN);
+    return atk & occupied;
+}
+
+U64
+Search::seeXRays(const Position& pos, int square, U64 occupied, int removedPiece) {
+    U64 atk = 0;
+    switch (Piece::makeWhite(removedPiece)) {
+    case Piece::WKNIGHT:
+        break;
+    case Piece::WPAWN:
+    case Piece::WBISHOP:
+        atk = BitBoard::bishopAttacks(square, occupied) &
+              pos.pieceTypeBB(Piece::WBISHOP, Piece::BBISHOP, Piece::WQUEEN, Piece::BQUEEN);
+        break;
+    case Piece::WROOK:
+        atk = BitBoard::rookAttacks(square, occupied) &
+              pos.pieceTypeBB(Piece::WROOK, Piece::BROOK, Piece::WQUEEN, Piece::BQUEEN);
+        break;
+    default:
+        atk = (BitBoard::bishopAttacks(square, occupied) &
+               pos.pieceTypeBB(Piece::WBISHOP, Piece::BBISHOP, Piece::WQUEEN, Piece::BQUEEN)) |
+              (BitBoard::rookAttacks(square, occupied) &
+               pos.pieceTypeBB(Piece::WROOK, Piece::BROOK, Piece::WQUEEN, Piece::BQUEEN));
+        break;
+    }
+    return atk & occupied;
+}
+
 int
-Search::SEE(Position& pos, const Move& m, int alpha, int beta) {
+Search::SEE(const Position& pos, const Move& m, int alpha, int beta) {
+    const int square = m.to();
+    const int p = pos.getPiece(m.from());
+    U64 occupied = pos.occupiedBB() & ~(1ULL << m.from());
+    if (square == pos.getEpSquare()) {
+        if (p == Piece::WPAWN)
+            occupied &= ~(1ULL << (square - 8));
+        else if (p == Piece::BPAWN)
+            occupied &= ~(1ULL << (square + 8));
+    }
+    return SEE(pos, m, alpha, beta, occupied, seeAttackers(pos, square, occupied));
+}
+
+int
+Search::SEE(const Position& pos, const Move& m, int alpha, int beta,
+            U64 occupied, U64 attackers) {
     int captures[64];   // Value of captured pieces
     const int kV = ::kV;
 
@@ -1308,98 +1467,37 @@ Search::SEE(Position& pos, const Move& m, int alpha, int beta) {
     }
     int nCapt = 1;                  // Number of entries in captures[]
 
-    UndoInfo ui;
-    pos.makeSEEMove(m, ui);
-    bool white = pos.isWhiteMove();
-    int valOnSquare = ::pieceValue[pos.getPiece(square)];
-    U64 occupied = pos.occupiedBB();
+    bool white = !pos.isWhiteMove();
+    int valOnSquare = ::pieceValue[pos.getPiece(m.from())];
     int currScore = -captures[0];
     int tmp = alpha; alpha = -beta; beta = -tmp;
     while (true) {
         if ((currScore + valOnSquare <= alpha) || (currScore >= beta))
             break;
         alpha = std::max(alpha, currScore);
-        int bestValue = std::numeric_limits<int>::max();
-        U64 atk;
-        if (white) {
-            atk = BitBoard::bPawnAttacks(square) & pos.pieceTypeBB(Piece::WPAWN) & occupied;
-            if (atk != 0) {
-                bestValue = ::pV;
-            } else {
-                atk = BitBoard::knightAttacks(square) & pos.pieceTypeBB(Piece::WKNIGHT) & occupied;
-                if (atk != 0) {
-                    bestValue = ::nV;
-                } else {
-                    U64 bAtk = BitBoard::bishopAttacks(square, occupied) & occupied;
-                    atk = bAtk & pos.pieceTypeBB(Piece::WBISHOP);
-                    if (atk != 0) {
-                        bestValue = ::bV;
-                    } else {
-                        U64 rAtk = BitBoard::rookAttacks(square, occupied) & occupied;
-                        atk = rAtk & pos.pieceTypeBB(Piece::WROOK);
-                        if (atk != 0) {
-                            bestValue = ::rV;
-                        } else {
-                            atk = (bAtk | rAtk) & pos.pieceTypeBB(Piece::WQUEEN);
-                            if (atk != 0) {
-                                bestValue = ::qV;
-                            } else {
-                                atk = BitBoard::kingAttacks(square) & pos.pieceTypeBB(Piece::WKING) & occupied;
-                                if (atk != 0) {
-                                    bestValue = kV;
-                                } else {
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        } else {
-            atk = BitBoard::wPawnAttacks(square) & pos.pieceTypeBB(Piece::BPAWN) & occupied;
-            if (atk != 0) {
-                bestValue = ::pV;
-            } else {
-                atk = BitBoard::knightAttacks(square) & pos.pieceTypeBB(Piece::BKNIGHT) & occupied;
-                if (atk != 0) {
-                    bestValue = ::nV;
-                } else {
-                    U64 bAtk = BitBoard::bishopAttacks(square, occupied) & occupied;
-                    atk = bAtk & pos.pieceTypeBB(Piece::BBISHOP);
-                    if (atk != 0) {
-                        bestValue = ::bV;
-                    } else {
-                        U64 rAtk = BitBoard::rookAttacks(square, occupied) & occupied;
-                        atk = rAtk & pos.pieceTypeBB(Piece::BROOK);
-                        if (atk != 0) {
-                            bestValue = ::rV;
-                        } else {
-                            atk = (bAtk | rAtk) & pos.pieceTypeBB(Piece::BQUEEN);
-                            if (atk != 0) {
-                                bestValue = ::qV;
-                            } else {
-                                atk = BitBoard::kingAttacks(square) & pos.pieceTypeBB(Piece::BKING) & occupied;
-                                if (atk != 0) {
-                                    bestValue = kV;
-                                } else {
-                                    break;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+
+        // Find least valuable attacker. Piece types are ordered from king to pawn.
+        const int pOffs = white ? 0 : Piece::BKING - Piece::WKING;
+        int p = Piece::WPAWN + pOffs;
+        U64 atk = attackers & pos.pieceTypeBB((Piece::Type)p);
+        while (!atk && p > Piece::WKING + pOffs) {
+            p--;
+            atk = attackers & pos.pieceTypeBB((Piece::Type)p);
         }
+        if (!atk)
+            break;
+
         captures[nCapt++] = valOnSquare;
         if (valOnSquare == kV)
             break;
         currScore = -(currScore + valOnSquare);
         int tmp = alpha; alpha = -beta; beta = -tmp;
-        valOnSquare = bestValue;
-        occupied &= ~(atk & -atk);
+        valOnSquare = ::pieceValue[p];
+        U64 fromBB = atk & -atk;
+        occupied &= ~fromBB;
+        attackers = (attackers & ~fromBB) | seeXRays(pos, square, occupied, p);
         white = !white;
     }
-    pos.unMakeSEEMove(m, ui);
 
     int score = 0;
     for (int i = nCapt - 1; i > 0; i--)
@@ -1407,35 +1505,84 @@ Search::SEE(Position& pos, const Move& m, int alpha, int beta) {
     return captures[0] - score;
 }
 
+void
+Search::signSEE(const Position& pos, const MoveList& moves, int startIdx, int signs[]) {
+    U64 attackers[64];      // Attackers of each target square, using full board occupancy
+    U64 computed = 0;       // Target squares for which attackers[] is valid
+    const U64 occupied = pos.occupiedBB();
+    for (int i = startIdx; i < moves.size; i++) {
+        const Move& m = moves[i];
+        const int square = m.to();
+        const int victim = pos.getPiece(square);
+        if ((victim == Piece::EMPTY) && (m.promoteTo() == Piece::EMPTY)) {
+            signs[i] = 0;
+            continue;
+        }
+        const int p = pos.getPiece(m.from());
+        if (::pieceValue[p] < ::pieceValue[victim]) {
+            signs[i] = 1;
+            continue;
+        }
+        const U64 toMask = 1ULL << square;
+        if (!(computed & toMask)) {
+            attackers[square] = seeAttackers(pos, square, occupied);
+            computed |= toMask;
+        }
+        const U64 fromMask = 1ULL << m.from();
+        const U64 occ = occupied & ~fromMask;
+        U64 atk;
+        if (Square::getX(m.from()) == Square::getX(square)) {
+            // Non-capturing pawn promotion, may uncover rook/queen x-rays
+            atk = seeAttackers(pos, square, occ);
+        } else {
+            atk = (attackers[square] & ~fromMask) | seeXRays(pos, square, occ, p);
+        }
+        const int see = SEE(pos, m, -1, 1, occ, atk);
+        signs[i] = (see > 0) ? 1 : (see < 0) ? -1 : 0;
+    }
+}
+
 void
 Search::scoreMoveList(MoveList& moves, int ply, int startIdx) {
+    int seeSigns[MoveList::MAX_MOVES];
+    signSEE(pos, moves, startIdx, seeSigns);
     for (int i = startIdx; i < moves.size; i++) {
         Move& m = moves[i];
-        bool isCapture = (pos.getPiece(m.to()) != Piece::EMPTY) || (m.promoteTo() != Piece::EMPTY);
-        int score = 0;
-        if (isCapture) {
-            int seeScore = signSEE(m);
-            int v = pos.getPiece(m.to());
-            int a = pos.getPiece(m.from());
-            score = Evaluate::pieceValueOrder[v] * 8 - Evaluate::pieceValueOrder[a];
-            if (seeScore > 0)
-                score += 100;
-            else if (seeScore == 0)
-                score += 50;
-            else
-                score -= 50;
-            score *= 100;
+        m.setScore(scoreMove(m, ply, seeSigns[i]));
+    }
+}
+
+int
+Search::scoreMove(const Move& m, int ply) {
+    bool isCapture = (pos.getPiece(m.to()) != Piece::EMPTY) || (m.promoteTo() != Piece::EMPTY);
+    return scoreMove(m, ply, isCapture ? signSEE(m) : 0);
+}
+
+int
+Search::scoreMove(const Move& m, int ply, int seeScore) {
+    bool isCapture = (pos.getPiece(m.to()) != Piece::EMPTY) || (m.promoteTo() != Piece::EMPTY);
+    int score = 0;
+    if (isCapture) {
+        int v = pos.getPiece(m.to());
+        int a = pos.getPiece(m.from());
+        score = Evaluate::pieceValueOrder[v] * 8 - Evaluate::pieceValueOrder[a];
+        if (seeScore > 0)
+            score += 100;
+        else if (seeScore == 0)
+            score += 50;
+        else
+            score -= 50;
+        score *= 100;
+    } else {
+        int ks = kt.getKillerScore(ply, m);
+        if (ks > 0) {
+            score += ks + 50;
         } else {
-            int ks = kt.getKillerScore(ply, m);
-            if (ks > 0) {
-                score += ks + 50;
-            } else {
-                int hs = ht.getHistScore(pos, m);
-                score += hs;
-            }
+            int hs = ht.getHistScore(pos, m);
+            score += hs;
         }
-        m.setScore(score);
     }
+    return score;
 }
 
 bool
@@ -1451,6 +1598,199 @@ Search::selectHashMove(MoveList& moves, const Move& hashMove) {
     return false;
 }
 
+Search::MovePicker::MovePicker(Search& sc, MoveList& moves, const Move& hashMove,
+                               int ply, bool inCheck)
+    : sc(sc), moves(moves), ply(ply), nKillers(0), nKillerMoves(0) {
+    moves.clear();
+    if (inCheck) {
+        MoveGen::legalMoves(sc.pos, moves);
+        hashSelected = !hashMove.isEmpty() && selectHashMove(moves, hashMove);
+        if (hashSelected) {
+            stage = HASH_MOVE;
+            afterHash = SCORE_EVASIONS;
+        } else {
+            sc.scoreMoveList(moves, ply);
+#ifdef PREFETCH_PIPELINE
+            newScores = true;
+#endif
+            stage = REMAINING;
+        }
+    } else {
+        hashSelected = !hashMove.isEmpty() && MoveGen::isPseudoLegal(sc.pos, hashMove);
+        if (hashSelected) {
+            moves[moves.size++] = hashMove;
+            moves[0].setScore(10000);
+            stage = HASH_MOVE;
+            afterHash = GEN_CAPTURES;
+        } else {
+            stage = GEN_CAPTURES;
+        }
+    }
+}
+
+Search::MovePicker::MovePicker(Search& sc, MoveList& moves, bool inCheck, bool tryChecks)
+    : sc(sc), moves(moves), ply(0), stage(REMAINING), afterHash(REMAINING),
+      hashSelected(false), nKillers(0), nKillerMoves(0) {
+    moves.clear();
+    if (inCheck) {
+        MoveGen::legalMoves(sc.pos, moves);
+    } else if (tryChecks) {
+        MoveGen::pseudoLegalCapturesAndChecks(sc.pos, moves);
+    } else {
+        MoveGen::pseudoLegalCaptures(sc.pos, moves);
+    }
+    sc.scoreMoveListMvvLva(moves);
+}
+
+bool
+Search::MovePicker::isCaptureStageMove(const Move& m) const {
+    const Position& pos = sc.pos;
+    switch (m.promoteTo()) {
+    case Piece::EMPTY:
+        break;
+    case Piece::WQUEEN: case Piece::WKNIGHT:
+    case Piece::BQUEEN: case Piece::BKNIGHT:
+        return true;
+    default:
+        return false;
+    }
+    if (pos.getPiece(m.to()) != Piece::EMPTY)
+        return true;
+    return (m.to() == pos.getEpSquare()) &&
+           (Piece::makeWhite(pos.getPiece(m.from())) == Piece::WPAWN);
+}
+
+bool
+Search::MovePicker::alreadyReturned(const Move& m) const {
+    if (hashSelected && (m == moves[0]))
+        return true;
+    for (int i = 0; i < nKillerMoves; i++)
+        if (m == killerMoves[i])
+            return true;
+    return false;
+}
+
+bool
+Search::MovePicker::next(int mi, bool sort) {
+    while (true) {
+        switch (stage) {
+        case HASH_MOVE:
+            stage = afterHash;
+            return true;
+        case SCORE_EVASIONS:
+            sc.scoreMoveList(moves, ply, mi);
+#ifdef PREFETCH_PIPELINE
+            newScores = true;
+#endif
+            stage = REMAINING;
+            break;
+        case GEN_CAPTURES: {
+            const int first = moves.size;
+            MoveGen::pseudoLegalCaptures(sc.pos, moves);
+            for (int i = first; i < moves.size; ) {
+                if (alreadyReturned(moves[i])) {
+                    moves[i] = moves[--moves.size];
+                    continue;
+                }
+                i++;
+            }
+            sc.scoreMoveList(moves, ply, first);
+#ifdef PREFETCH_PIPELINE
+            newScores = true;
+#endif
+            stage = GOOD_CAPTURES;
+            break;
+        }
+        case GOOD_CAPTURES:
+            if (mi < moves.size) {
+                selectBest(moves, mi);
+                if (moves[mi].score() > 0) {
+#ifdef PREFETCH_PIPELINE
+                    prefetchNext(mi, true);
+#endif
+                    return true;
+                }
+            }
+            stage = KILLERS;
+            break;
+        case KILLERS:
+            while (nKillers < 2) {
+                Move m = sc.kt.getKiller(ply, nKillers++);
+                if ((m.promoteTo() != Piece::EMPTY) || isCaptureStageMove(m) ||
+                    alreadyReturned(m) || !MoveGen::isPseudoLegal(sc.pos, m))
+                    continue;
+                m.setScore(sc.kt.getKillerScore(ply, m) + 50);
+                killerMoves[nKillerMoves++] = m;
+                if (mi < moves.size)
+                    moves[moves.size] = moves[mi]; // Losing capture, keep it for later
+                moves.size++;
+                moves[mi] = m;
+                return true;
+            }
+            stage = GEN_QUIETS;
+            break;
+        case GEN_QUIETS: {
+            MoveList quiets;
+            MoveGen::pseudoLegalMoves(sc.pos, quiets);
+            for (int i = 0; i < quiets.size; i++) {
+                Move& m = quiets[i];
+                if (isCaptureStageMove(m) || alreadyReturned(m))
+                    continue;
+                m.setScore(sc.scoreMove(m, ply));
+                moves[moves.size++] = m;
+            }
+#ifdef PREFETCH_PIPELINE
+            newScores = true;
+#endif
+            stage = REMAINING;
+            break;
+        }
+        case REMAINING:
+            if (mi >= moves.size)
+                return false;
+            if (sort)
+                selectBest(moves, mi);
+#ifdef PREFETCH_PIPELINE
+            prefetchNext(mi, sort);
+#endif
+            return true;
+        }
+    }
+}
+
+#ifdef PREFETCH_PIPELINE
+void
+Search::MovePicker::setPrefetch(bool enable) {
+    prefetch = enable;
+}
+
+inline void
+Search::MovePicker::prefetchNext(int mi, bool sorted) {
+    if (!prefetch)
+        return;
+    if (sorted != prefetchSorted) {
+        prefetchSorted = sorted;
+        prefetchEnd = mi + 1;
+    }
+    if (sorted) {
+        if (newScores || (mi + 1 >= prefetchEnd)) {
+            prefetchEnd = mi + 1 + sc.prefetchBest(moves, mi + 1);
+            newScores = false;
+        }
+    } else {
+        const int end = std::min(moves.size, mi + 1 + SearchConst::PREFETCH_DISTANCE);
+        for (int i = std::max(prefetchEnd, mi + 1); i < end; i++)
+            sc.prefetchMove(moves[i]);
+        prefetchEnd = end;
+    }
+}
+#endif
+
+bool
+Search::MovePicker::hashMoveSelected() const {
+    return hashSelected;
+}
+
 void
 Search::setThreadNo(int tNo) {
     threadNo = tNo;
@@ -31,8 +31,10 @@
 #include "evaluate.hpp"
 #include "moveGen.hpp"
 #include "searchUtil.hpp"
+#include "searchStats.hpp"
 #include "parallel.hpp"
 #include "parameters.hpp"
+#include "timeLog.hpp"
 #include "util/util.hpp"
 
 #include <limits>
@@ -131,6 +133,13 @@ public:
     /** Compute extension depth for a move. */
     int getMoveExtend(const Move& m, int recaptureSquare);
 
+    /**
+     * Quiescence search score for many positions, for use by tuning tools.
+     * Uses the same evaluation order and hash table policy as Evaluate::evalBatch().
+     * @param out Search scores. Positive values are good for white.
+     */
+    void quiesceBatch(const Position::SerializeData* data, int n, int* out);
+
     static bool canClaimDraw50(const Position& pos);
 
     static bool canClaimDrawRep(const Position& pos, const std::vector<U64>& posHashList,
@@ -151,11 +160,43 @@ public:
     /** Get number of TB hits for this thread. */
     S64 getTbHitsThisThread() const;
 
+    /** Get search and evaluation hash statistics for this thread. */
+    SearchStats getSearchStatsThisThread() const;
+
+    /** Get number of jobs sent to helper threads by this thread. */
+    S64 getNumHelperJobs() const;
+    /** Get number of job results received from helper threads. */
+    S64 getNumHelperResults() const;
+    /** Get number of helper thread results used to finish a job. */
+    S64 getNumHelperResultsUsed() const;
+
+    /** Get time usage and per iteration information for the last
+     *  iterativeDeepening() call. */
+    void getTimeLogEntry(TimeLog::Entry& entry) const;
+
+    /** Return how hard it seems to be to determine the best move, given the
+     *  fraction of all nodes spent on the best move. 1.0 is normal difficulty. */
+    static double nodeFractionHardFactor(double f);
+
+    /** Get search statistics for all threads. Helper thread statistics are
+     *  only complete after the helper threads have acknowledged the stop command. */
+    SearchStats getSearchStats() const;
+
     /**
      * Static exchange evaluation function.
+     * Pure bitboard implementation that does not modify pos.
      * @return SEE score for m. Positive value is good for the side that makes the first move.
      */
-    static int SEE(Position& pos, const Move& m, int alpha, int beta);
+    static int SEE(const Position& pos, const Move& m, int alpha, int beta);
+
+    /**
+     * Compute the sign of SEE for moves[startIdx] ... moves[moves.size-1] and store
+     * the result (-1, 0 or 1) in signs[]. The result matches signSEE(). Moves that
+     * neither capture a piece on the target square nor promote get sign 0.
+     * The attackers of a target square are computed only once, even if several
+     * moves capture on the same square.
+     */
+    static void signSEE(const Position& pos, const MoveList& moves, int startIdx, int signs[]);
 
 private:
     void init(const Position& pos0, const std::vector<U64>& posHashList0,
@@ -211,6 +252,24 @@ private:
                       std::vector<MoveInfo>& rootMovesOut,
                       int maxDepth);
 
+    /** Make a move in the search position. If COPY_MAKE is defined, the
+     *  position is first saved in posStack[ply]. If HAS_NNUE is defined, the
+     *  move is recorded in nnueStack so the accumulator can be updated lazily. */
+    void makeMove(const Move& m, UndoInfo& ui, int ply);
+    /** Undo a move made by makeMove(). If COPY_MAKE is defined, the saved
+     *  position is copied back instead of calling Position::unMakeMove().
+     *  The NNUE accumulator for the position is popped from nnueStack. */
+    void unMakeMove(const Move& m, const UndoInfo& ui, int ply);
+
+    /** Prefetch transposition table and evaluation hash entries for the position
+     *  after move m. */
+    void prefetchMove(const Move& m);
+    /** Prefetch hash entries for the PREFETCH_DISTANCE moves with the highest
+     *  scores in moves[startIdx] ... moves[moves.size-1]. These are the moves
+     *  that selectBest() returns next. The move list is not modified.
+     *  @return The number of prefetched moves. */
+    int prefetchBest(const MoveList& moves, int startIdx);
+
     /** Return true if move should be skipped in order to make engine play weaker. */
     bool weakPlaySkipMove(const Position& pos, const Move& m, int ply) const;
 
@@ -246,6 +305,105 @@ private:
     /** If hashMove exists in the move list, move the hash move to the front of the list. */
     static bool selectHashMove(MoveList& moves, const Move& hashMove);
 
+    /** Compute the move ordering score for one move. See scoreMoveList(). */
+    int scoreMove(const Move& m, int ply);
+    /** Like scoreMove(m, ply), but use seeScore as the SEE sign for capture moves. */
+    int scoreMove(const Move& m, int ply, int seeScore);
+
+    /** Return all pieces of both colors that attack square, considering only
+     *  pieces in occupied and slider rays blocked by occupied. */
+    static U64 seeAttackers(const Position& pos, int square, U64 occupied);
+
+    /** Return slider attackers of square that may have been uncovered when a
+     *  piece of type removedPiece was removed from the occupied set. */
+    static U64 seeXRays(const Position& pos, int square, U64 occupied, int removedPiece);
+
+    /** Swap-list SEE computation. occupied is the board occupancy after the moving
+     *  piece has left its square and attackers is seeAttackers() for that occupancy. */
+    static int SEE(const Position& pos, const Move& m, int alpha, int beta,
+                   U64 occupied, U64 attackers);
+
+    /**
+     * Staged move generator used by negaScout() and quiesce().
+     * When not in check, negaScout() moves are produced in the order: hash move,
+     * winning and equal captures, killer moves, other moves. The other moves are
+     * quiet moves ordered by history score, followed by losing captures. A stage
+     * is only generated and scored when it is reached, so no time is spent on
+     * later stages if an earlier move causes a beta cutoff.
+     * When in check, all legal moves are generated up front, so no legality
+     * test is needed for the returned moves.
+     * The moves are stored in a MoveList owned by the caller. When next() has
+     * returned false, the list contains all moves in the order they were returned.
+     */
+    class MovePicker {
+    public:
+        /** Create a move picker for a negaScout() node. */
+        MovePicker(Search& sc, MoveList& moves, const Move& hashMove, int ply, bool inCheck);
+
+        /** Create a move picker for a quiesce() node. Moves are ordered by MVV/LVA. */
+        MovePicker(Search& sc, MoveList& moves, bool inCheck, bool tryChecks);
+
+        /** Return true if the hash move is pseudo-legal and is returned first. */
+        bool hashMoveSelected() const;
+
+        /**
+         * Store the next move in moves[mi]. mi must be 0 for the first call and
+         * be incremented by one for each following call.
+         * @param sort  If false, the best move in the current stage is not searched
+         *              for. Used when move ordering is not expected to pay off.
+         * @return False if there are no more moves.
+         */
+        bool next(int mi, bool sort);
+
+#ifdef PREFETCH_PIPELINE
+        /** Enable prefetching of hash entries for the moves expected to be
+         *  returned after the current move. */
+        void setPrefetch(bool enable);
+#endif
+
+    private:
+        /** Return true if m is generated by MoveGen::pseudoLegalCaptures(). */
+        bool isCaptureStageMove(const Move& m) const;
+
+        /** Return true if m has already been returned in the hash or killer stages. */
+        bool alreadyReturned(const Move& m) const;
+
+#ifdef PREFETCH_PIPELINE
+        /** Called when moves[mi] is returned. If sorted, the following moves are
+         *  returned in score order, so the best scored remaining moves are
+         *  prefetched when new scores have been computed or when the previously
+         *  prefetched moves have been used up. Otherwise the following moves are
+         *  returned in list order and are prefetched by index. */
+        void prefetchNext(int mi, bool sorted);
+#endif
+
+        enum Stage {
+            HASH_MOVE,      // Hash move in moves[0]
+            SCORE_EVASIONS, // All legal check evasions generated, not yet scored
+            GEN_CAPTURES,   // Generate captures and queen/knight promotions
+            GOOD_CAPTURES,  // Captures with SEE >= 0
+            KILLERS,        // Killer moves that are pseudo-legal quiet moves
+            GEN_QUIETS,     // Generate remaining moves
+            REMAINING,      // All moves generated and scored
+        };
+
+        Search& sc;
+        MoveList& moves;
+        const int ply;
+        Stage stage;
+        Stage afterHash;    // Stage following HASH_MOVE
+        bool hashSelected;
+        int nKillers;       // Number of killer table entries examined
+        int nKillerMoves;   // Number of killer moves returned
+        Move killerMoves[2];
+#ifdef PREFETCH_PIPELINE
+        bool prefetch = false;
+        bool newScores = false;      // True if moves have been scored since the last prefetch
+        bool prefetchSorted = false; // True if the last prefetch was in score order
+        int prefetchEnd = 0;         // Moves before this index have been prefetched
+#endif
+    };
+
     class DefaultStopHandler : public StopHandler {
     public:
         explicit DefaultStopHandler(Search& sc0) : sc(sc0) { }
@@ -276,6 +434,13 @@ private:
     Move emptyMove;
 
     SearchTreeInfo searchTreeInfo[SearchConst::MAX_SEARCH_DEPTH * 2];
+    AttackInfo attackInfo[SearchConst::MAX_SEARCH_DEPTH * 2]; // Cached check and pin information for each ply
+#ifdef COPY_MAKE
+    std::vector<Position> posStack; // Position before the move made at each ply
+#endif
+#ifdef HAS_NNUE
+    NNUE::AccumulatorStack nnueStack; // Network accumulators for positions in the search tree
+#endif
 
     // Time management
     S64 tStart;                // Time when search started
@@ -284,6 +449,8 @@ private:
     int earlyStopPercentage;   // Can stop searching after this many percent of minTimeMillis
     bool searchNeedMoreTime;   // True if negaScout should use up to maxTimeMillis time.
     double hardFactor;         // How hard it seems to be to determine the best move.
+    S64 timeUsed;              // Time used by last completed search
+    std::vector<TimeLog::Iteration> iterationLog; // Information about completed iterations
     S64 maxNodes;              // Maximum number of nodes to search (approximately)
     int minProbeDepth;         // Minimum depth to probe endgame tablebases.
     int nodesToGo;             // Number of nodes until next time check
@@ -299,6 +466,10 @@ private:
     S64 totalNodes;
     S64 tbHits;
     S64 tLastStats;        // Time when notifyStats was last called
+    SearchStats stats;     // Only updated if SEARCH_STATS is defined
+    S64 nHelperJobs;       // Number of jobs sent to helper threads
+    S64 nHelperResults;    // Number of job results received from helper threads
+    S64 nHelperResultsUsed;// Number of helper results that finished the current job
 
     int q0Eval; // Static eval score at first level of quiescence search
 };
@@ -413,6 +584,32 @@ Search::selectBest(MoveList& moves, int startIdx) {
     std::swap(moves[bestIdx], moves[startIdx]);
 }
 
+inline void
+Search::makeMove(const Move& m, UndoInfo& ui, int ply) {
+#ifdef COPY_MAKE
+    posStack[ply] = pos;
+#endif
+#ifdef HAS_NNUE
+    nnueStack.push(pos, m);
+#endif
+    pos.makeMove(m, ui);
+#ifdef HAS_NNUE
+    nnueStack.setKey(pos.zobristHash());
+#endif
+}
+
+inline void
+Search::unMakeMove(const Move& m, const UndoInfo& ui, int ply) {
+#ifdef COPY_MAKE
+    pos = posStack[ply];
+#else
+    pos.unMakeMove(m, ui);
+#endif
+#ifdef HAS_NNUE
+    nnueStack.pop();
+#endif
+}
+
 inline void
 Search::setSearchTreeInfo(int ply, const SearchTreeInfo& sti,
                           U64 rootNodeIdx) {
@@ -456,6 +653,35 @@ Search::getTbHitsThisThread() const {
     return tbHits;
 }
 
+inline SearchStats
+Search::getSearchStatsThisThread() const {
+    SearchStats ret(stats);
+    ret += eval.getHashStats();
+    return ret;
+}
+
+inline S64
+Search::getNumHelperJobs() const {
+    return nHelperJobs;
+}
+
+inline S64
+Search::getNumHelperResults() const {
+    return nHelperResults;
+}
+
+inline S64
+Search::getNumHelperResultsUsed() const {
+    return nHelperResultsUsed;
+}
+
+inline SearchStats
+Search::getSearchStats() const {
+    SearchStats ret = comm.getSearchStats();
+    ret += getSearchStatsThisThread();
+    return ret;
+}
+
 inline void
 Search::setMinProbeDepth(int depth) {
     minProbeDepth = depth;
@@ -0,0 +1,134 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * searchStats.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "searchStats.hpp"
+#include "parameters.hpp"
+#include "treeLogger.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+
+/** Return a/b as a percentage string with one decimal. */
+static std::string
+pct(S64 a, S64 b) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1) << (b > 0 ? a * 100.0 / b : 0.0) << '%';
+    return ss.str();
+}
+
+void
+SearchStats::print(std::ostream& os) const {
+    if (!enabled) {
+        os << "info string search statistics not available, "
+              "compile with USE_SEARCH_STATS" << std::endl;
+        return;
+    }
+
+    const S64 nodes = get(NODES);
+    const S64 qNodes = get(QNODES);
+    os << "info string stats nodes " << nodes << " qnodes " << qNodes
+       << " qnodes% " << pct(qNodes, nodes + qNodes) << std::endl;
+
+    S64 probes = 0, hits = 0, cuts = 0;
+    for (int d = 0; d < MAX_DEPTH; d++) {
+        probes += getDepth(TT_PROBES, d);
+        hits += getDepth(TT_HITS, d);
+        cuts += getDepth(TT_CUTS, d);
+    }
+    os << "info string stats tt probes " << probes
+       << " hits " << hits << " (" << pct(hits, probes) << ")"
+       << " cuts " << cuts << " (" << pct(cuts, probes) << ")" << std::endl;
+    for (int d = 0; d < MAX_DEPTH; d++) {
+        const S64 p = getDepth(TT_PROBES, d);
+        if (p == 0)
+            continue;
+        os << "info string stats tt depth " << d << (d == MAX_DEPTH - 1 ? "+" : "")
+           << " probes " << p
+           << " hits " << pct(getDepth(TT_HITS, d), p)
+           << " cuts " << pct(getDepth(TT_CUTS, d), p) << std::endl;
+    }
+
+    const S64 nullTries = get(NULL_MOVE_TRIES);
+    os << "info string stats nullmove tries " << nullTries
+       << " cuts " << get(NULL_MOVE_CUTS) << " (" << pct(get(NULL_MOVE_CUTS), nullTries) << ")"
+       << std::endl;
+    os << "info string stats prune razor " << get(RAZOR_CUTS)
+       << " revfutility " << get(REV_FUTILITY_CUTS)
+       << " futility " << get(FUTILITY_PRUNES)
+       << " lmp " << get(LMP_PRUNES) << std::endl;
+
+    const S64 lmr = get(LMR_SEARCHES);
+    os << "info string stats lmr searches " << lmr
+       << " researches " << get(LMR_RESEARCHES) << " (" << pct(get(LMR_RESEARCHES), lmr) << ")"
+       << std::endl;
+
+    const S64 cutNodes = get(CUT_NODES);
+    os << "info string stats cutnodes " << cutNodes
+       << " firstmove " << get(CUT_FIRST_MOVE) << " (" << pct(get(CUT_FIRST_MOVE), cutNodes) << ")"
+       << std::endl;
+
+    static const char* hashNames[] = { "pawn", "kingsafety", "material", "eval" };
+    for (int i = 0; i < 4; i++) {
+        Counter hitC = (Counter)(PAWN_HASH_HITS + i * 3);
+        const S64 hits = get(hitC);
+        const S64 misses = get((Counter)(hitC + 1));
+        os << "info string stats hash " << hashNames[i]
+           << " hits " << hits << " (" << pct(hits, hits + misses) << ")"
+           << " misses " << misses
+           << " overwrites " << get((Counter)(hitC + 2)) << std::endl;
+    }
+    if (UciParams::sharedEvalHash->getBoolPar()) {
+        os << "info string stats hash shared pawn hits " << get(SHARED_PAWN_HASH_HITS)
+           << " (" << pct(get(SHARED_PAWN_HASH_HITS), get(PAWN_HASH_MISSES)) << ")"
+           << " kingsafety hits " << get(SHARED_KS_HASH_HITS)
+           << " (" << pct(get(SHARED_KS_HASH_HITS), get(KS_HASH_MISSES)) << ")" << std::endl;
+    }
+}
+
+U8*
+SearchStats::toByteBuf(U8* buffer) const {
+#ifdef SEARCH_STATS
+    for (int i = 0; i < N_COUNTERS; i++)
+        buffer = Serializer::putBytes(buffer, counters[i]);
+    for (int c = 0; c < N_DEPTH_COUNTERS; c++)
+        for (int d = 0; d < MAX_DEPTH; d++)
+            buffer = Serializer::putBytes(buffer, depthCounters[c][d]);
+#endif
+    return buffer;
+}
+
+const U8*
+SearchStats::fromByteBuf(const U8* buffer) {
+#ifdef SEARCH_STATS
+    for (int i = 0; i < N_COUNTERS; i++)
+        buffer = Serializer::getBytes(buffer, counters[i]);
+    for (int c = 0; c < N_DEPTH_COUNTERS; c++)
+        for (int d = 0; d < MAX_DEPTH; d++)
+            buffer = Serializer::getBytes(buffer, depthCounters[c][d]);
+#endif
+    return buffer;
+}
@@ -0,0 +1,197 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * searchStats.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SEARCHSTATS_HPP_
+#define SEARCHSTATS_HPP_
+
+#include "util/util.hpp"
+
+#include <iosfwd>
+
+/**
+ * Counters describing what the search did, such as the number of TT hits
+ * and the number of times different pruning methods were applied.
+ * The counters are only updated if the program is compiled with SEARCH_STATS
+ * defined. Otherwise all update operations are no-ops.
+ */
+class SearchStats {
+public:
+    /** Scalar counters. */
+    enum Counter {
+        NODES,              // Moves made in negaScout
+        QNODES,             // Moves made in quiesce
+        NULL_MOVE_TRIES,    // Null move searches
+        NULL_MOVE_CUTS,     // Null move searches causing a cutoff
+        RAZOR_CUTS,         // Nodes pruned by razoring
+        REV_FUTILITY_CUTS,  // Nodes pruned by reverse futility pruning
+        FUTILITY_PRUNES,    // Moves pruned by futility pruning
+        LMP_PRUNES,         // Moves pruned by late move pruning
+        LMR_SEARCHES,       // Reduced searches
+        LMR_RESEARCHES,     // Reduced searches that had to be re-searched
+        CUT_NODES,          // Nodes where a move caused a beta cutoff
+        CUT_FIRST_MOVE,     // Cut nodes where the first move caused the cutoff
+
+        // Evaluation hash tables. An overwrite is a miss replacing a valid entry.
+        PAWN_HASH_HITS, PAWN_HASH_MISSES, PAWN_HASH_OVERWRITES,
+        KS_HASH_HITS,   KS_HASH_MISSES,   KS_HASH_OVERWRITES,
+        MTRL_HASH_HITS, MTRL_HASH_MISSES, MTRL_HASH_OVERWRITES,
+        EVAL_HASH_HITS, EVAL_HASH_MISSES, EVAL_HASH_OVERWRITES,
+        SHARED_PAWN_HASH_HITS, // Per-thread pawn hash misses found in the shared table
+        SHARED_KS_HASH_HITS,   // Per-thread king safety hash misses found in the shared table
+        N_COUNTERS
+    };
+
+    /** Counters that are also bucketed by remaining search depth. */
+    enum DepthCounter {
+        TT_PROBES,
+        TT_HITS,
+        TT_CUTS,
+        N_DEPTH_COUNTERS
+    };
+
+    /** Number of depth buckets. Larger depths are counted in the last bucket. */
+    static const int MAX_DEPTH = 32;
+
+#ifdef SEARCH_STATS
+    static const bool enabled = true;
+#else
+    static const bool enabled = false;
+#endif
+
+    /** Create object with all counters set to 0. */
+    SearchStats();
+
+    /** Set all counters to 0. */
+    void clear();
+
+    /** Increment a counter. */
+    void add(Counter c, S64 n = 1);
+    /** Increment a depth bucketed counter. */
+    void addDepth(DepthCounter c, int depth);
+
+    /** Get counter value. */
+    S64 get(Counter c) const;
+    /** Get depth bucketed counter value. */
+    S64 getDepth(DepthCounter c, int depth) const;
+
+    SearchStats& operator+=(const SearchStats& other);
+    SearchStats& operator-=(const SearchStats& other);
+
+    /** Print statistics as UCI "info string" lines. */
+    void print(std::ostream& os) const;
+
+    /** Serialize to/from a byte buffer. Nothing is stored if statistics
+     *  collection is disabled. */
+    U8* toByteBuf(U8* buffer) const;
+    const U8* fromByteBuf(const U8* buffer);
+
+private:
+    static int depthIdx(int depth);
+
+#ifdef SEARCH_STATS
+    S64 counters[N_COUNTERS];
+    S64 depthCounters[N_DEPTH_COUNTERS][MAX_DEPTH];
+#endif
+};
+
+
+inline
+SearchStats::SearchStats() {
+    clear();
+}
+
+inline void
+SearchStats::clear() {
+#ifdef SEARCH_STATS
+    for (int i = 0; i < N_COUNTERS; i++)
+        counters[i] = 0;
+    for (int c = 0; c < N_DEPTH_COUNTERS; c++)
+        for (int d = 0; d < MAX_DEPTH; d++)
+            depthCounters[c][d] = 0;
+#endif
+}
+
+inline int
+SearchStats::depthIdx(int depth) {
+    return clamp(depth, 0, MAX_DEPTH - 1);
+}
+
+inline void
+SearchStats::add(Counter c, S64 n) {
+#ifdef SEARCH_STATS
+    counters[c] += n;
+#endif
+}
+
+inline void
+SearchStats::addDepth(DepthCounter c, int depth) {
+#ifdef SEARCH_STATS
+    depthCounters[c][depthIdx(depth)]++;
+#endif
+}
+
+inline S64
+SearchStats::get(Counter c) const {
+#ifdef SEARCH_STATS
+    return counters[c];
+#else
+    return 0;
+#endif
+}
+
+inline S64
+SearchStats::getDepth(DepthCounter c, int depth) const {
+#ifdef SEARCH_STATS
+    return depthCounters[c][depthIdx(depth)];
+#else
+    return 0;
+#endif
+}
+
+inline SearchStats&
+SearchStats::operator+=(const SearchStats& other) {
+#ifdef SEARCH_STATS
+    for (int i = 0; i < N_COUNTERS; i++)
+        counters[i] += other.counters[i];
+    for (int c = 0; c < N_DEPTH_COUNTERS; c++)
+        for (int d = 0; d < MAX_DEPTH; d++)
+            depthCounters[c][d] += other.depthCounters[c][d];
+#endif
+    return *this;
+}
+
+inline SearchStats&
+SearchStats::operator-=(const SearchStats& other) {
+#ifdef SEARCH_STATS
+    for (int i = 0; i < N_COUNTERS; i++)
+        counters[i] -= other.counters[i];
+    for (int c = 0; c < N_DEPTH_COUNTERS; c++)
+        for (int d = 0; d < MAX_DEPTH; d++)
+            depthCounters[c][d] -= other.depthCounters[c][d];
+#endif
+    return *this;
+}
+
+#endif /* SEARCHSTATS_HPP_ */
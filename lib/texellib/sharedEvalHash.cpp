@@ -0,0 +1,151 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * sharedEvalHash.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "sharedEvalHash.hpp"
+#include "parameters.hpp"
+#include "numa.hpp"
+
+SharedEvalHash::Tables::PawnEntry::PawnEntry() {
+    check.store((U64)-1, std::memory_order_relaxed);
+    for (int i = 0; i < nPawnData; i++)
+        data[i].store(0, std::memory_order_relaxed);
+}
+
+SharedEvalHash::Tables::PawnEntry::PawnEntry(const PawnEntry& a) {
+    check.store(a.check.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    for (int i = 0; i < nPawnData; i++)
+        data[i].store(a.data[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+SharedEvalHash::Tables::KingSafetyEntry::KingSafetyEntry() {
+    check.store((U64)-1, std::memory_order_relaxed);
+    data.store(0, std::memory_order_relaxed);
+}
+
+SharedEvalHash::Tables::KingSafetyEntry::KingSafetyEntry(const KingSafetyEntry& a) {
+    check.store(a.check.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    data.store(a.data.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+SharedEvalHash::Tables::Tables(size_t nPawn, size_t nKingSafety) {
+    pawnHash.resize(nPawn);
+    kingSafetyHash.resize(nKingSafety);
+}
+
+bool
+SharedEvalHash::Tables::probePawn(U64 key, U64 data[nPawnData]) const {
+    const PawnEntry& ent = pawnHash[key & (pawnHash.size() - 1)];
+    U64 check = ent.check.load(std::memory_order_relaxed);
+    for (int i = 0; i < nPawnData; i++) {
+        data[i] = ent.data[i].load(std::memory_order_relaxed);
+        check ^= data[i];
+    }
+    return check == key;
+}
+
+void
+SharedEvalHash::Tables::storePawn(U64 key, const U64 data[nPawnData]) {
+    PawnEntry& ent = pawnHash[key & (pawnHash.size() - 1)];
+    U64 check = key;
+    for (int i = 0; i < nPawnData; i++) {
+        ent.data[i].store(data[i], std::memory_order_relaxed);
+        check ^= data[i];
+    }
+    ent.check.store(check, std::memory_order_relaxed);
+}
+
+bool
+SharedEvalHash::Tables::probeKingSafety(U64 key, int& score) const {
+    const KingSafetyEntry& ent = kingSafetyHash[key & (kingSafetyHash.size() - 1)];
+    U64 check = ent.check.load(std::memory_order_relaxed);
+    U64 data = ent.data.load(std::memory_order_relaxed);
+    if ((check ^ data) != key)
+        return false;
+    score = (S32)(U32)data;
+    return true;
+}
+
+void
+SharedEvalHash::Tables::storeKingSafety(U64 key, int score) {
+    KingSafetyEntry& ent = kingSafetyHash[key & (kingSafetyHash.size() - 1)];
+    U64 data = (U32)score;
+    ent.check.store(key ^ data, std::memory_order_relaxed);
+    ent.data.store(data, std::memory_order_relaxed);
+}
+
+void
+SharedEvalHash::Tables::clear() {
+    for (PawnEntry& ent : pawnHash) {
+        ent.check.store((U64)-1, std::memory_order_relaxed);
+        for (int i = 0; i < nPawnData; i++)
+            ent.data[i].store(0, std::memory_order_relaxed);
+    }
+    for (KingSafetyEntry& ent : kingSafetyHash) {
+        ent.check.store((U64)-1, std::memory_order_relaxed);
+        ent.data.store(0, std::memory_order_relaxed);
+    }
+}
+
+SharedEvalHash&
+SharedEvalHash::instance() {
+    static SharedEvalHash inst;
+    return inst;
+}
+
+/** Return number of hash table entries corresponding to a UCI parameter. */
+static size_t
+hashEntries(const std::shared_ptr<Parameters::SpinParam>& par) {
+    return (size_t)1 << floorLog2(par->getIntPar());
+}
+
+std::shared_ptr<SharedEvalHash::Tables>
+SharedEvalHash::tablesForThread(int threadNo) {
+    // The parameters are null during static initialization
+    if (!UciParams::sharedEvalHash || !UciParams::sharedEvalHash->getBoolPar())
+        return nullptr;
+    int node = -1;
+    if (UciParams::sharedEvalHashPerNode->getBoolPar())
+        node = Numa::instance().nodeForThread(threadNo);
+
+    std::lock_guard<std::mutex> L(mutex);
+    std::shared_ptr<Tables>& t = tables[node];
+    if (!t)
+        t = std::make_shared<Tables>(hashEntries(UciParams::sharedPawnHashEntries),
+                                     hashEntries(UciParams::sharedKingSafetyHashEntries));
+    return t;
+}
+
+void
+SharedEvalHash::reset() {
+    std::lock_guard<std::mutex> L(mutex);
+    tables.clear();
+}
+
+void
+SharedEvalHash::clear() {
+    std::lock_guard<std::mutex> L(mutex);
+    for (auto& e : tables)
+        e.second->clear();
+}
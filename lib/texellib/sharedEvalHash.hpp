@@ -0,0 +1,118 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * sharedEvalHash.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SHAREDEVALHASH_HPP_
+#define SHAREDEVALHASH_HPP_
+
+#include "util/util.hpp"
+#include "util/alignedAlloc.hpp"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+
+/**
+ * Pawn and king safety hash tables shared by all search threads.
+ * The tables are lockless. Each entry stores the key XORed with all data
+ * words, like TranspositionTable::TTEntryStorage, so an entry that is being
+ * modified by another thread while it is read is detected as a miss.
+ * Optionally one copy of the tables is allocated for each NUMA node.
+ */
+class SharedEvalHash {
+public:
+    /** Number of 64 bit data words in a pawn hash entry. */
+    static const int nPawnData = 5;
+
+    /** The tables used by threads running on one NUMA node. */
+    class Tables {
+    public:
+        Tables(size_t nPawn, size_t nKingSafety);
+
+        /** Get pawn hash data for key. Return false if not found. */
+        bool probePawn(U64 key, U64 data[nPawnData]) const;
+        /** Store pawn hash data for key. Always replaces the old entry. */
+        void storePawn(U64 key, const U64 data[nPawnData]);
+
+        /** Get king safety score for key. Return false if not found. */
+        bool probeKingSafety(U64 key, int& score) const;
+        /** Store king safety score for key. Always replaces the old entry. */
+        void storeKingSafety(U64 key, int score);
+
+        /** Remove all entries. */
+        void clear();
+
+        size_t pawnSize() const { return pawnHash.size(); }
+        size_t kingSafetySize() const { return kingSafetyHash.size(); }
+
+    private:
+        /** Empty entries use a check value that corresponds to key -1
+         *  and all data words 0, like Evaluate::PawnHashData(). */
+        struct alignas(64) PawnEntry {
+            std::atomic<U64> check;  // key ^ data[0] ^ ... ^ data[nPawnData-1]
+            std::atomic<U64> data[nPawnData];
+            PawnEntry();
+            PawnEntry(const PawnEntry& a);
+            PawnEntry& operator=(const PawnEntry& a) = delete;
+        };
+        struct KingSafetyEntry {
+            std::atomic<U64> check;  // key ^ data
+            std::atomic<U64> data;
+            KingSafetyEntry();
+            KingSafetyEntry(const KingSafetyEntry& a);
+            KingSafetyEntry& operator=(const KingSafetyEntry& a) = delete;
+        };
+        static_assert(sizeof(PawnEntry) == 64, "PawnEntry size wrong");
+        static_assert(sizeof(KingSafetyEntry) == 16, "KingSafetyEntry size wrong");
+
+        vector_aligned<PawnEntry> pawnHash;
+        vector_aligned<KingSafetyEntry> kingSafetyHash;
+    };
+
+    /** Get singleton instance. */
+    static SharedEvalHash& instance();
+
+    /** Return the tables to use for a search thread, or nullptr if shared
+     *  tables are disabled by the SharedEvalHash UCI parameter. If the tables
+     *  do not exist yet, they are allocated and initialized by the calling
+     *  thread, which places the memory on the NUMA node of that thread. */
+    std::shared_ptr<Tables> tablesForThread(int threadNo);
+
+    /** Release all tables, so that they are re-created using the current UCI
+     *  parameter values. Tables still referenced by a caller of
+     *  tablesForThread() stay valid until the last reference is dropped. */
+    void reset();
+
+    /** Remove all entries from all tables. */
+    void clear();
+
+private:
+    SharedEvalHash() = default;
+
+    std::mutex mutex;
+    std::map<int, std::shared_ptr<Tables>> tables; // NUMA node -> tables
+};
+
+#endif /* SHAREDEVALHASH_HPP_ */
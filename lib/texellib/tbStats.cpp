@@ -0,0 +1,252 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * tbStats.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "tbStats.hpp"
+#include "material.hpp"
+
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+/** Counters for one backend. */
+struct BackendStats {
+    std::atomic<S64> probes;
+    std::atomic<S64> hits;
+    std::atomic<S64> latency[TBStats::N_BUCKETS];
+};
+
+/** Counters for one material configuration. key is matId + 1, or 0 if unused. */
+struct MaterialStats {
+    std::atomic<int> key;
+    std::atomic<S64> probes[TBStats::N_BACKENDS];
+    std::atomic<S64> hits[TBStats::N_BACKENDS];
+};
+
+/** Size of the material hash table. When it is full, new material
+ *  configurations are only included in the backend totals. */
+const int matTableSize = 1024;
+
+BackendStats backendStats[TBStats::N_BACKENDS];
+MaterialStats matStats[matTableSize];
+
+const char* backendNames[TBStats::N_BACKENDS] = {
+    "ondemand", "rtbwdl", "rtbdtz", "gtbwdl", "gtbdtm"
+};
+
+inline void
+inc(std::atomic<S64>& cnt) {
+    cnt.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline S64
+get(const std::atomic<S64>& cnt) {
+    return cnt.load(std::memory_order_relaxed);
+}
+
+/** Find the table entry for a material configuration.
+ *  @param insert If true, create the entry if it does not exist.
+ *  @return The entry, or nullptr if not found. */
+MaterialStats*
+findMaterial(int matId, bool insert) {
+    const int key = matId + 1;
+    int idx = (int)(((U32)matId * 0x9E3779B1U) >> 22) & (matTableSize - 1);
+    for (int i = 0; i < matTableSize; i++) {
+        MaterialStats& ms = matStats[idx];
+        int k = ms.key.load(std::memory_order_relaxed);
+        if (k == key)
+            return &ms;
+        if (k == 0) {
+            if (!insert)
+                return nullptr;
+            if (ms.key.compare_exchange_strong(k, key, std::memory_order_relaxed) || k == key)
+                return &ms;
+        }
+        idx = (idx + 1) & (matTableSize - 1);
+    }
+    return nullptr;
+}
+
+/** Return a/b as a percentage string with one decimal. */
+std::string
+pct(S64 a, S64 b) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1) << (b > 0 ? a * 100.0 / b : 0.0) << '%';
+    return ss.str();
+}
+
+}
+
+void
+TBStats::clear() {
+    for (BackendStats& bs : backendStats) {
+        bs.probes = 0;
+        bs.hits = 0;
+        for (auto& l : bs.latency)
+            l = 0;
+    }
+    for (MaterialStats& ms : matStats) {
+        for (int b = 0; b < N_BACKENDS; b++) {
+            ms.probes[b] = 0;
+            ms.hits[b] = 0;
+        }
+        ms.key = 0;
+    }
+}
+
+int
+TBStats::latencyBucket(double seconds) {
+    double us = seconds * 1e6;
+    int bucket = 0;
+    while ((bucket < N_BUCKETS - 1) && (us >= 1.0)) {
+        us *= 0.5;
+        bucket++;
+    }
+    return bucket;
+}
+
+void
+TBStats::addProbe(Backend b, int matId, bool hit, double seconds) {
+    BackendStats& bs = backendStats[b];
+    inc(bs.probes);
+    if (hit)
+        inc(bs.hits);
+    inc(bs.latency[latencyBucket(seconds)]);
+
+    MaterialStats* ms = findMaterial(matId, true);
+    if (ms) {
+        inc(ms->probes[b]);
+        if (hit)
+            inc(ms->hits[b]);
+    }
+}
+
+S64
+TBStats::getProbes(Backend b) {
+    return get(backendStats[b].probes);
+}
+
+S64
+TBStats::getHits(Backend b) {
+    return get(backendStats[b].hits);
+}
+
+S64
+TBStats::getLatencyCount(Backend b, int bucket) {
+    return get(backendStats[b].latency[bucket]);
+}
+
+S64
+TBStats::getProbes(Backend b, int matId) {
+    MaterialStats* ms = findMaterial(matId, false);
+    return ms ? get(ms->probes[b]) : 0;
+}
+
+S64
+TBStats::getHits(Backend b, int matId) {
+    MaterialStats* ms = findMaterial(matId, false);
+    return ms ? get(ms->hits[b]) : 0;
+}
+
+std::string
+TBStats::materialName(int matId) {
+    auto side = [](int id) {
+        // Decode starting with the largest value, print in the usual order
+        const int q = id / MatId::WQ; id %= MatId::WQ;
+        const int b = id / MatId::WB; id %= MatId::WB;
+        const int n = id / MatId::WN; id %= MatId::WN;
+        const int r = id / MatId::WR; id %= MatId::WR;
+        const int p = id;
+        return "K" + std::string(q, 'Q') + std::string(r, 'R') + std::string(b, 'B') +
+               std::string(n, 'N') + std::string(p, 'P');
+    };
+    return side(matId & 0xffff) + "v" + side(matId >> 16);
+}
+
+void
+TBStats::print(std::ostream& os) {
+    if (!enabled) {
+        os << "info string tablebase statistics not available, "
+              "compile with USE_TB_STATS" << std::endl;
+        return;
+    }
+
+    for (int b = 0; b < N_BACKENDS; b++) {
+        const BackendStats& bs = backendStats[b];
+        const S64 probes = get(bs.probes);
+        const S64 hits = get(bs.hits);
+        os << "info string tbstats " << backendNames[b] << " probes " << probes
+           << " hits " << hits << " (" << pct(hits, probes) << ")"
+           << " misses " << (probes - hits) << std::endl;
+        if (probes == 0)
+            continue;
+        os << "info string tbstats " << backendNames[b] << " latency";
+        for (int i = 0; i < N_BUCKETS; i++) {
+            const S64 cnt = get(bs.latency[i]);
+            if (cnt == 0)
+                continue;
+            if (i == 0)
+                os << " <1us ";
+            else if (i == N_BUCKETS - 1)
+                os << " >=" << (1 << (i - 1)) << "us ";
+            else
+                os << ' ' << (1 << (i - 1)) << '-' << (1 << i) << "us ";
+            os << cnt;
+        }
+        os << std::endl;
+    }
+
+    // Material configurations, most probed first
+    std::vector<std::pair<S64,const MaterialStats*>> mats;
+    for (const MaterialStats& ms : matStats) {
+        if (ms.key.load(std::memory_order_relaxed) == 0)
+            continue;
+        S64 probes = 0;
+        for (int b = 0; b < N_BACKENDS; b++)
+            probes += get(ms.probes[b]);
+        mats.push_back(std::make_pair(probes, &ms));
+    }
+    std::sort(mats.begin(), mats.end(),
+              [](const std::pair<S64,const MaterialStats*>& a,
+                 const std::pair<S64,const MaterialStats*>& b) {
+        return a.first > b.first;
+    });
+    for (const auto& p : mats) {
+        const MaterialStats& ms = *p.second;
+        os << "info string tbstats material "
+           << materialName(ms.key.load(std::memory_order_relaxed) - 1);
+        for (int b = 0; b < N_BACKENDS; b++) {
+            const S64 probes = get(ms.probes[b]);
+            if (probes > 0)
+                os << ' ' << backendNames[b] << ' ' << probes
+                   << " hits " << pct(get(ms.hits[b]), probes);
+        }
+        os << std::endl;
+    }
+}
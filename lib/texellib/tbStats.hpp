@@ -0,0 +1,121 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * tbStats.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef TBSTATS_HPP_
+#define TBSTATS_HPP_
+
+#include "util/util.hpp"
+#include "util/timeUtil.hpp"
+
+#include <iosfwd>
+#include <string>
+
+/**
+ * Process wide tablebase probe statistics. For each tablebase backend the
+ * number of probes and hits and a probe latency histogram are collected.
+ * Probe and hit counts are also collected for each material configuration.
+ * The statistics are shared by all search threads and are only collected if
+ * the program is compiled with TBPROBE_STATS defined. Otherwise all update
+ * operations are no-ops.
+ */
+class TBStats {
+public:
+    /** Tablebase backends. */
+    enum Backend {
+        ON_DEMAND,     // On-demand DTM tables in the transposition table
+        RTB_WDL,       // Syzygy WDL
+        RTB_DTZ,       // Syzygy DTZ
+        GTB_WDL,       // Gaviota WDL
+        GTB_DTM,       // Gaviota DTM
+        N_BACKENDS
+    };
+
+    /** Number of latency histogram buckets. Bucket 0 counts probes faster
+     *  than 1us, bucket i > 0 counts probes taking [2^(i-1),2^i[ us. The last
+     *  bucket also counts all slower probes. */
+    static const int N_BUCKETS = 16;
+
+#ifdef TBPROBE_STATS
+    static const bool enabled = true;
+#else
+    static const bool enabled = false;
+#endif
+
+    /** Set all statistics to 0. */
+    static void clear();
+
+    /** Record a probe. Normally called by Probe::done(). */
+    static void addProbe(Backend b, int matId, bool hit, double seconds);
+
+    /** Get total number of probes/hits for a backend. */
+    static S64 getProbes(Backend b);
+    static S64 getHits(Backend b);
+    /** Get number of probes for a backend in a latency bucket. */
+    static S64 getLatencyCount(Backend b, int bucket);
+    /** Get number of probes/hits for a backend and material configuration. */
+    static S64 getProbes(Backend b, int matId);
+    static S64 getHits(Backend b, int matId);
+
+    /** Return the latency bucket corresponding to a probe time. */
+    static int latencyBucket(double seconds);
+
+    /** Return material configuration name, such as "KRPvKR". */
+    static std::string materialName(int matId);
+
+    /** Print statistics as UCI "info string" lines. */
+    static void print(std::ostream& os);
+
+    /** Measures the time for one probe and records the result. Does nothing
+     *  if TBPROBE_STATS is not defined. */
+    class Probe {
+    public:
+        Probe(Backend b, int matId);
+        /** Record the probe result. Must be called exactly once. */
+        void done(bool hit);
+    private:
+#ifdef TBPROBE_STATS
+        Backend backend;
+        int matId;
+        double t0;
+#endif
+    };
+};
+
+inline
+TBStats::Probe::Probe(Backend b, int matId)
+#ifdef TBPROBE_STATS
+    : backend(b), matId(matId), t0(currentTime())
+#endif
+{
+}
+
+inline void
+TBStats::Probe::done(bool hit) {
+#ifdef TBPROBE_STATS
+    addProbe(backend, matId, hit, currentTime() - t0);
+#endif
+}
+
+#endif /* TBSTATS_HPP_ */
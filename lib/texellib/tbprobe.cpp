@@ -24,6 +24,7 @@
  */
 
 #include "tbprobe.hpp"
+#include "tbStats.hpp"
 #include "gtb/gtb-probe.h"
 #include "syzygy/rtb-probe.hpp"
 #include "bitBoard.hpp"
@@ -32,6 +33,7 @@
 #include "constants.hpp"
 #include <unordered_map>
 #include <cassert>
+#include <limits>
 
 #include "util/timeUtil.hpp"
 
@@ -90,6 +92,15 @@ TBProbe::tbEnabled() {
 
 const int maxFrustratedDist = 1000;
 
+/** Probe the on-demand tablebases in the transposition table. */
+static inline bool probeOnDemand(const TranspositionTable& tt, const Position& pos,
+                                 int ply, int& score) {
+    TBStats::Probe tbs(TBStats::ON_DEMAND, pos.materialId());
+    bool ret = tt.probeDTM(pos, ply, score);
+    tbs.done(ret);
+    return ret;
+}
+
 static inline void updateEvScore(TranspositionTable::TTEntry& ent,
                                  int newScore) {
     int oldScore = ent.getEvalScore();
@@ -119,7 +130,7 @@ TBProbe::tbProbe(Position& pos, int ply, int alpha, int beta,
     const int hmc = pos.getHalfMoveClock();
     bool hasDtm = false;
     int dtmScore;
-    if (nPieces <= 4 && tt.probeDTM(pos, ply, dtmScore)) {
+    if (nPieces <= 4 && probeOnDemand(tt, pos, ply, dtmScore)) {
         if ((dtmScore == 0) || (rule50Margin(dtmScore, ply, hmc, ent) >= 0)) {
             ent.setScore(dtmScore, ply);
             ent.setType(TType::T_EXACT);
@@ -281,7 +292,7 @@ TBProbe::getSearchMoves(Position& pos, const MoveList& legalMoves,
 bool
 TBProbe::dtmProbe(Position& pos, int ply, const TranspositionTable& tt, int& score) {
     const int nPieces = BitBoard::bitCount(pos.occupiedBB());
-    if (nPieces <= 4 && tt.probeDTM(pos, ply, score))
+    if (nPieces <= 4 && probeOnDemand(tt, pos, ply, score))
         return true;
     if (TBProbe::gtbProbeDTM(pos, ply, score))
         return true;
@@ -312,8 +323,7 @@ TBProbe::extendPV(const Position& rootPos, std::vector<Move>& pv, const Transpos
         score = -score;
     while (true) {
         MoveList moveList;
-        MoveGen::pseudoLegalMoves(pos, moveList);
-        MoveGen::removeIllegal(pos, moveList);
+        MoveGen::legalMoves(pos, moveList);
         bool extended = false;
         for (int mi = 0; mi < moveList.size; mi++) {
             const Move& m = moveList[mi];
@@ -406,7 +416,9 @@ TBProbe::rtbProbeDTZ(Position& pos, int ply, int& score,
         return false;
 
     int success;
+    TBStats::Probe tbs(TBStats::RTB_DTZ, pos.materialId());
     const int dtz = Syzygy::probe_dtz(pos, &success);
+    tbs.done(success);
     if (!success)
         return false;
     if (dtz == 0) {
@@ -454,7 +466,9 @@ TBProbe::rtbProbeWDL(Position& pos, int ply, int& score,
         return false;
 
     int success;
+    TBStats::Probe tbs(TBStats::RTB_WDL, pos.materialId());
     int wdl = Syzygy::probe_wdl(pos, &success);
+    tbs.done(success);
     if (!success)
         return false;
     int plyToMate;
@@ -579,10 +593,13 @@ bool
 TBProbe::gtbProbeDTM(const GtbProbeData& gtbData, int ply, int& score) {
     unsigned int tbInfo;
     unsigned int plies;
-    if (!tb_probe_hard(gtbData.stm, gtbData.epsq, gtbData.castles,
-                       gtbData.wSq, gtbData.bSq,
-                       gtbData.wP, gtbData.bP,
-                       &tbInfo, &plies))
+    TBStats::Probe tbs(TBStats::GTB_DTM, gtbData.materialId);
+    bool found = tb_probe_hard(gtbData.stm, gtbData.epsq, gtbData.castles,
+                               gtbData.wSq, gtbData.bSq,
+                               gtbData.wP, gtbData.bP,
+                               &tbInfo, &plies);
+    tbs.done(found);
+    if (!found)
         return false;
 
     switch (tbInfo) {
@@ -608,10 +625,13 @@ TBProbe::gtbProbeDTM(const GtbProbeData& gtbData, int ply, int& score) {
 bool
 TBProbe::gtbProbeWDL(const GtbProbeData& gtbData, int ply, int& score) {
     unsigned int tbInfo;
-    if (!tb_probe_WDL_hard(gtbData.stm, gtbData.epsq, gtbData.castles,
-                           gtbData.wSq, gtbData.bSq,
-                           gtbData.wP, gtbData.bP,
-                           &tbInfo))
+    TBStats::Probe tbs(TBStats::GTB_WDL, gtbData.materialId);
+    bool found = tb_probe_WDL_hard(gtbData.stm, gtbData.epsq, gtbData.castles,
+                                   gtbData.wSq, gtbData.bSq,
+                                   gtbData.wP, gtbData.bP,
+                                   &tbInfo);
+    tbs.done(found);
+    if (!found)
         return false;
 
     switch (tbInfo) {
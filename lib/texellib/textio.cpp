@@ -33,12 +33,41 @@ const std::string TextIO::startPosFEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQ
 Position
 TextIO::readFEN(const std::string& fen) {
     Position pos;
+    parseFEN(fen.data(), fen.length(), pos);
+    return pos;
+}
 
+void
+TextIO::readFEN(const char* fen, int len, Position& pos) {
+    pos = Position();
+    parseFEN(fen, len, pos);
+}
+
+/** Parse an integer with optional sign from s[i0 ... i1-1]. Any characters
+ *  after the digits are ignored. @return False if there are no digits. */
+static bool
+parseInt(const char* s, int i0, int i1, int& result) {
+    bool neg = false;
+    if ((i0 < i1) && ((s[i0] == '-') || (s[i0] == '+'))) {
+        neg = s[i0] == '-';
+        i0++;
+    }
+    if ((i0 >= i1) || (s[i0] < '0') || (s[i0] > '9'))
+        return false;
+    int ret = 0;
+    for ( ; (i0 < i1) && (s[i0] >= '0') && (s[i0] <= '9'); i0++)
+        ret = ret * 10 + (s[i0] - '0');
+    result = neg ? -ret : ret;
+    return true;
+}
+
+void
+TextIO::parseFEN(const char* fen, int len, Position& pos) {
     // Piece placement
     int row = 7;
     int col = 0;
-    size_t i;
-    for (i = 0; i < fen.length(); i++) {
+    int i;
+    for (i = 0; i < len; i++) {
         char c = fen[i];
         if (c == ' ')
             break;
@@ -70,17 +99,17 @@ TextIO::readFEN(const std::string& fen) {
             default: throw ChessParseError("Invalid piece");
         }
     }
-    while (i < fen.length() && fen[i] == ' ')
+    while (i < len && fen[i] == ' ')
         i++;
-    if (i >= fen.length())
+    if (i >= len)
         throw ChessParseError("Invalid side");
     pos.setWhiteMove(fen[i++] == 'w');
 
     // Castling rights
     int castleMask = 0;
-    while (i < fen.length() && fen[i] == ' ')
+    while (i < len && fen[i] == ' ')
         i++;
-    for ( ; i < fen.length(); i++) {
+    for ( ; i < len; i++) {
         char c = fen[i];
         if (c == ' ')
             break;
@@ -95,15 +124,15 @@ TextIO::readFEN(const std::string& fen) {
     }
     pos.setCastleMask(castleMask);
 
-    while (i < fen.length() && fen[i] == ' ')
+    while (i < len && fen[i] == ' ')
         i++;
 
-    if (i < fen.length()) {
+    if (i < len) {
         // En passant target square
         if (fen[i] != '-') {
-            if (i >= fen.length() - 1)
+            if (i >= len - 1)
                 throw ChessParseError("Invalid en passant square");
-            int epSq = getSquare(fen.substr(i, 2));
+            int epSq = getSquare(fen[i], fen[i+1]);
             if (epSq != -1) {
                 if (pos.isWhiteMove()) {
                     if ((Square::getY(epSq) != 5) || (pos.getPiece(epSq) != Piece::EMPTY) ||
@@ -117,66 +146,54 @@ TextIO::readFEN(const std::string& fen) {
                 pos.setEpSquare(epSq);
             }
         }
-        while (i < fen.length() && fen[i] != ' ')
+        while (i < len && fen[i] != ' ')
             i++;
     }
 
-    while (i < fen.length() && fen[i] == ' ')
+    while (i < len && fen[i] == ' ')
         i++;
-    if (i < fen.length()) {
+    if (i < len) {
         int i0 = i;
-        while (i < fen.length() && fen[i] != ' ')
+        while (i < len && fen[i] != ' ')
             i++;
         int halfMoveClock;
-        if (str2Num(fen.substr(i0, i - i0), halfMoveClock))
+        if (parseInt(fen, i0, i, halfMoveClock))
             pos.setHalfMoveClock(halfMoveClock);
     }
-    while (i < fen.length() && fen[i] == ' ')
+    while (i < len && fen[i] == ' ')
         i++;
-    if (i < fen.length()) {
+    if (i < len) {
         int i0 = i;
-        while (i < fen.length() && fen[i] != ' ')
+        while (i < len && fen[i] != ' ')
             i++;
         int fullMoveCounter;
-        if (str2Num(fen.substr(i0, i - i0), fullMoveCounter))
+        if (parseInt(fen, i0, i, fullMoveCounter))
             pos.setFullMoveCounter(fullMoveCounter);
     }
 
     // Each side must have exactly one king
-    int wKings = 0;
-    int bKings = 0;
-    for (int x = 0; x < 8; x++) {
-        for (int y = 0; y < 8; y++) {
-            int p = pos.getPiece(Square::getSquare(x, y));
-            if (p == Piece::WKING)
-                wKings++;
-            else if (p == Piece::BKING)
-                bKings++;
-        }
-    }
-    if (wKings != 1)
+    if (BitBoard::bitCount(pos.pieceTypeBB(Piece::WKING)) != 1)
         throw ChessParseError("White must have exactly one king");
-    if (bKings != 1)
+    if (BitBoard::bitCount(pos.pieceTypeBB(Piece::BKING)) != 1)
         throw ChessParseError("Black must have exactly one king");
 
     // Make sure king can not be captured
-    Position pos2(pos);
-    pos2.setWhiteMove(!pos.isWhiteMove());
-    if (MoveGen::inCheck(pos2))
+    const U64 occupied = pos.occupiedBB();
+    bool kingCapture = pos.isWhiteMove() ?
+                       MoveGen::sqAttacked<false>(pos, pos.getKingSq(false), occupied) :
+                       MoveGen::sqAttacked<true>(pos, pos.getKingSq(true), occupied);
+    if (kingCapture)
         throw ChessParseError("King capture possible");
 
     fixupEPSquare(pos);
-    return pos;
 }
 
-
 void
 TextIO::fixupEPSquare(Position& pos) {
     int epSquare = pos.getEpSquare();
     if (epSquare >= 0) {
         MoveList moves;
-        MoveGen::pseudoLegalMoves(pos, moves);
-        MoveGen::removeIllegal(pos, moves);
+        MoveGen::legalMoves(pos, moves);
         bool epValid = false;
         for (int mi = 0; mi < moves.size; mi++) {
             const Move& m = moves[mi];
@@ -195,7 +212,34 @@ TextIO::fixupEPSquare(Position& pos) {
 
 std::string
 TextIO::toFEN(const Position& pos) {
-    std::string ret;
+    char buf[MAX_FEN_LEN];
+    int len = toFEN(pos, buf);
+    return std::string(buf, len);
+}
+
+/** Write the decimal representation of a number to buf.
+ *  @return The number of characters written. */
+static int
+writeNum(char* buf, int num) {
+    if (num < 0) {
+        buf[0] = '-';
+        return 1 + writeNum(buf + 1, -num);
+    }
+    char tmp[16];
+    int n = 0;
+    do {
+        tmp[n++] = (char)('0' + num % 10);
+        num /= 10;
+    } while (num > 0);
+    for (int i = 0; i < n; i++)
+        buf[i] = tmp[n - 1 - i];
+    return n;
+}
+
+int
+TextIO::toFEN(const Position& pos, char* buf) {
+    static const char pieceChars[Piece::nPieceTypes + 1] = " KQRBNPkqrbnp";
+    int n = 0;
     // Piece placement
     for (int r = 7; r >=0; r--) {
         int numEmpty = 0;
@@ -205,75 +249,63 @@ TextIO::toFEN(const Position& pos) {
                 numEmpty++;
             } else {
                 if (numEmpty > 0) {
-                    ret += (char)('0' + numEmpty);
+                    buf[n++] = (char)('0' + numEmpty);
                     numEmpty = 0;
                 }
-                switch (p) {
-                    case Piece::WKING:   ret += 'K'; break;
-                    case Piece::WQUEEN:  ret += 'Q'; break;
-                    case Piece::WROOK:   ret += 'R'; break;
-                    case Piece::WBISHOP: ret += 'B'; break;
-                    case Piece::WKNIGHT: ret += 'N'; break;
-                    case Piece::WPAWN:   ret += 'P'; break;
-                    case Piece::BKING:   ret += 'k'; break;
-                    case Piece::BQUEEN:  ret += 'q'; break;
-                    case Piece::BROOK:   ret += 'r'; break;
-                    case Piece::BBISHOP: ret += 'b'; break;
-                    case Piece::BKNIGHT: ret += 'n'; break;
-                    case Piece::BPAWN:   ret += 'p'; break;
-                    default: assert(false); break;
-                }
+                assert(p > Piece::EMPTY && p < Piece::nPieceTypes);
+                buf[n++] = pieceChars[p];
             }
         }
         if (numEmpty > 0)
-            ret += (char)('0' + numEmpty);
+            buf[n++] = (char)('0' + numEmpty);
         if (r > 0)
-            ret += '/';
+            buf[n++] = '/';
     }
-    ret += (pos.isWhiteMove() ? " w " : " b ");
+    buf[n++] = ' ';
+    buf[n++] = pos.isWhiteMove() ? 'w' : 'b';
+    buf[n++] = ' ';
 
     // Castling rights
     bool anyCastle = false;
     if (pos.h1Castle()) {
-        ret += 'K';
+        buf[n++] = 'K';
         anyCastle = true;
     }
     if (pos.a1Castle()) {
-        ret += 'Q';
+        buf[n++] = 'Q';
         anyCastle = true;
     }
     if (pos.h8Castle()) {
-        ret += 'k';
+        buf[n++] = 'k';
         anyCastle = true;
     }
     if (pos.a8Castle()) {
-        ret += 'q';
+        buf[n++] = 'q';
         anyCastle = true;
     }
     if (!anyCastle) {
-        ret += '-';
+        buf[n++] = '-';
     }
 
     // En passant target square
-    {
-        ret += ' ';
-        if (pos.getEpSquare() >= 0) {
-            int x = Square::getX(pos.getEpSquare());
-            int y = Square::getY(pos.getEpSquare());
-            ret += ((char)(x + 'a'));
-            ret += ((char)(y + '1'));
-        } else {
-            ret += '-';
-        }
+    buf[n++] = ' ';
+    if (pos.getEpSquare() >= 0) {
+        int x = Square::getX(pos.getEpSquare());
+        int y = Square::getY(pos.getEpSquare());
+        buf[n++] = (char)(x + 'a');
+        buf[n++] = (char)(y + '1');
+    } else {
+        buf[n++] = '-';
     }
 
     // Move counters
-    ret += ' ';
-    ret += num2Str(pos.getHalfMoveClock());
-    ret += ' ';
-    ret += num2Str(pos.getFullMoveCounter());
+    buf[n++] = ' ';
+    n += writeNum(&buf[n], pos.getHalfMoveClock());
+    buf[n++] = ' ';
+    n += writeNum(&buf[n], pos.getFullMoveCounter());
 
-    return ret;
+    buf[n] = 0;
+    return n;
 }
 
 std::string
@@ -308,8 +340,8 @@ TextIO::uciStringToMove(const std::string& move) {
     Move m;
     if ((move.length() < 4) || (move.length() > 5))
         return m;
-    int fromSq = TextIO::getSquare(move.substr(0, 2));
-    int toSq   = TextIO::getSquare(move.substr(2, 2));
+    int fromSq = getSquare(move[0], move[1]);
+    int toSq   = getSquare(move[2], move[3]);
     if ((fromSq < 0) || (toSq < 0)) {
         return m;
     }
@@ -441,8 +473,7 @@ moveToString(Position& pos, const Move& move, bool longForm, const MoveList& mov
     if (MoveGen::givesCheck(pos, move)) {
         pos.makeMove(move, ui);
         MoveList nextMoves;
-        MoveGen::pseudoLegalMoves(pos, nextMoves);
-        MoveGen::removeIllegal(pos, nextMoves);
+        MoveGen::legalMoves(pos, nextMoves);
         if (nextMoves.size == 0)
             ret += '#';
         else
@@ -456,9 +487,8 @@ moveToString(Position& pos, const Move& move, bool longForm, const MoveList& mov
 std::string
 TextIO::moveToString(const Position& pos, const Move& move, bool longForm) {
     MoveList moves;
-    MoveGen::pseudoLegalMoves(pos, moves);
+    MoveGen::legalMoves(pos, moves);
     Position tmpPos(pos);
-    MoveGen::removeIllegal(tmpPos, moves);
     return ::moveToString(tmpPos, move, longForm, moves);
 }
 
@@ -471,36 +501,143 @@ namespace {
     };
 }
 
+/** Return true if s[0 ... len-1] is equal to the null terminated string str. */
+static bool
+strEqual(const char* s, int len, const char* str) {
+    int i = 0;
+    for ( ; i < len; i++)
+        if (s[i] != str[i])
+            return false;
+    return str[i] == 0;
+}
+
+/**
+ * Find the move matching info using bitboard operations, without generating all
+ * legal moves. Only handles non-king moves where the moving piece and target
+ * square are known.
+ * @return True if exactly one legal move matches. The move is stored in "move".
+ */
+static bool
+findUniqueMove(Position& pos, const MoveInfo& info, Move& move) {
+    const bool wtm = pos.isWhiteMove();
+    const int to = Square::getSquare(info.toX, info.toY);
+    const U64 toMask = 1ULL << to;
+    if (toMask & pos.colorBB(wtm))
+        return false;
+    const U64 occupied = pos.occupiedBB();
+    const int pType = Piece::makeWhite(info.piece);
+    U64 from;
+    switch (pType) {
+    case Piece::WQUEEN:
+        from = BitBoard::bishopAttacks(to, occupied) | BitBoard::rookAttacks(to, occupied);
+        break;
+    case Piece::WROOK:
+        from = BitBoard::rookAttacks(to, occupied);
+        break;
+    case Piece::WBISHOP:
+        from = BitBoard::bishopAttacks(to, occupied);
+        break;
+    case Piece::WKNIGHT:
+        from = BitBoard::knightAttacks(to);
+        break;
+    case Piece::WPAWN:
+        if ((toMask & occupied) || (to == pos.getEpSquare())) {
+            from = wtm ? BitBoard::bPawnAttacks(to) : BitBoard::wPawnAttacks(to);
+        } else if (wtm) {
+            from = toMask >> 8;
+            if ((info.toY == 3) && !(from & occupied))
+                from |= toMask >> 16;
+        } else {
+            from = toMask << 8;
+            if ((info.toY == 4) && !(from & occupied))
+                from |= toMask << 16;
+        }
+        break;
+    default:
+        return false;
+    }
+    from &= pos.pieceTypeBB((Piece::Type)info.piece);
+    if (info.fromX >= 0)
+        from &= BitBoard::maskFile[info.fromX];
+    if (info.fromY >= 0)
+        from &= 0xffULL << (info.fromY * 8);
+
+    const bool promRow = (pType == Piece::WPAWN) && (info.toY == (wtm ? 7 : 0));
+    if (promRow) {
+        if ((info.promPiece < 0) || (Piece::isWhite(info.promPiece) != wtm))
+            return false;
+        switch (Piece::makeWhite(info.promPiece)) {
+        case Piece::WQUEEN: case Piece::WROOK: case Piece::WBISHOP: case Piece::WKNIGHT:
+            break;
+        default:
+            return false;
+        }
+    } else if (info.promPiece != Piece::EMPTY) {
+        return false;
+    }
+    const int prom = promRow ? info.promPiece : (int)Piece::EMPTY;
+
+    const bool inCheck = MoveGen::inCheck(pos);
+    int nMatches = 0;
+    Move match;
+    while (from) {
+        Move m(BitBoard::extractSquare(from), to, prom);
+        if (MoveGen::isLegal(pos, m, inCheck)) {
+            if (++nMatches > 1)
+                return false;
+            match = m;
+        }
+    }
+    if (nMatches != 1)
+        return false;
+    move = match;
+    return true;
+}
+
+Move
+TextIO::stringToMove(Position& pos, const std::string& strMove) {
+    return stringToMove(pos, strMove.data(), strMove.length());
+}
+
 Move
-TextIO::stringToMove(Position& pos, const std::string& strMoveIn) {
-    std::string strMove;
-    for (size_t i = 0; i < strMoveIn.length(); i++) {
+TextIO::stringToMove(Position& pos, const char* strMoveIn, int lenIn) {
+    char strBuf[32];
+    std::string longStr;
+    char* strMove = strBuf;
+    if (lenIn > (int)sizeof(strBuf)) {
+        longStr.resize(lenIn);
+        strMove = &longStr[0];
+    }
+    int len = 0;
+    for (int i = 0; i < lenIn; i++) {
         switch (strMoveIn[i]) {
         case '=':
         case '+':
         case '#':
             break;
         default:
-            strMove += strMoveIn[i];
+            strMove[len++] = strMoveIn[i];
             break;
         }
     }
 
     Move move;
-    if (strMove == "--")
+    if (strEqual(strMove, len, "--"))
         return move;
 
     const bool wtm = pos.isWhiteMove();
 
     MoveInfo info;
     bool capture = false;
-    if ((strMove == "O-O") || (strMove =="0-0") || (strMove == "o-o")) {
+    if (strEqual(strMove, len, "O-O") || strEqual(strMove, len, "0-0") ||
+        strEqual(strMove, len, "o-o")) {
         info.piece = wtm ? Piece::WKING : Piece::BKING;
         info.fromX = 4;
         info.toX = 6;
         info.fromY = info.toY = wtm ? 0 : 7;
         info.promPiece = Piece::EMPTY;
-    } else if ((strMove == "O-O-O") || (strMove == "0-0-0") || (strMove == "o-o-o")) {
+    } else if (strEqual(strMove, len, "O-O-O") || strEqual(strMove, len, "0-0-0") ||
+               strEqual(strMove, len, "o-o-o")) {
         info.piece = wtm ? Piece::WKING : Piece::BKING;
         info.fromX = 4;
         info.toX = 2;
@@ -508,7 +645,7 @@ TextIO::stringToMove(Position& pos, const std::string& strMoveIn) {
         info.promPiece = Piece::EMPTY;
     } else {
         bool atToSq = false;
-        for (size_t i = 0; i < strMove.length(); i++) {
+        for (int i = 0; i < len; i++) {
             char c = strMove[i];
             if (i == 0) {
                 int piece = charToPiece(wtm, c);
@@ -536,7 +673,7 @@ TextIO::stringToMove(Position& pos, const std::string& strMoveIn) {
                 if (c == 'x')
                     capture = true;
             }
-            if (i == strMove.length() - 1) {
+            if (i == len - 1) {
                 int promPiece = charToPiece(wtm, c);
                 if (promPiece >= 0) {
                     info.promPiece = promPiece;
@@ -559,13 +696,25 @@ TextIO::stringToMove(Position& pos, const std::string& strMoveIn) {
         }
         if (info.promPiece < 0)
             info.promPiece = Piece::EMPTY;
+
+        // Fast path for the common case where piece and target square are known
+        if ((info.toX >= 0) && (info.toY >= 0)) {
+            MoveInfo info2 = info;
+            if ((info2.piece < 0) && (info2.fromX >= 0) && (info2.fromY >= 0)) {
+                int p = pos.getPiece(Square::getSquare(info2.fromX, info2.fromY));
+                if ((p != Piece::EMPTY) && (Piece::isWhite(p) == wtm))
+                    info2.piece = p;
+            }
+            if ((info2.piece >= 0) && findUniqueMove(pos, info2, move))
+                return move;
+        }
     }
 
     MoveList moves;
-    MoveGen::pseudoLegalMoves(pos, moves);
-    MoveGen::removeIllegal(pos, moves);
+    MoveGen::legalMoves(pos, moves);
 
-    std::vector<Move> matches;
+    int nMatches = 0;
+    Move matches[MoveList::MAX_MOVES];
     for (int i = 0; i < moves.size; i++) {
         const Move& m = moves[i];
         int p = pos.getPiece(m.from());
@@ -583,16 +732,15 @@ TextIO::stringToMove(Position& pos, const std::string& strMoveIn) {
         if ((info.promPiece >= 0) && (info.promPiece != m.promoteTo()))
             match = false;
         if (match)
-            matches.push_back(m);
+            matches[nMatches++] = m;
     }
-    int nMatches = matches.size();
     if (nMatches == 0)
         return move;
     else if (nMatches == 1)
         return matches[0];
     if (!capture)
         return move;
-    for (size_t i = 0; i < matches.size(); i++) {
+    for (int i = 0; i < nMatches; i++) {
         const Move& m = matches[i];
         int capt = pos.getPiece(m.to());
         if (capt != Piece::EMPTY) {
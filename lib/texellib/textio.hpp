@@ -46,12 +46,25 @@ public:
     /** Parse a FEN string and return a chess Position object. */
     static Position readFEN(const std::string& fen);
 
+    /** Parse a FEN string stored in fen[0 ... len-1] into pos.
+     *  Does not allocate memory. */
+    static void readFEN(const char* fen, int len, Position& pos);
+
     /** Remove pseudo-legal EP square if it is not legal, ie would leave king in check. */
     static void fixupEPSquare(Position& pos);
 
     /** Return a FEN string corresponding to a chess Position object. */
     static std::string toFEN(const Position& pos);
 
+    /** Maximum length of a FEN string created by toFEN(), including the
+     *  terminating null character. */
+    static const int MAX_FEN_LEN = 128;
+
+    /** Write a null terminated FEN string to buf, which must have room for
+     *  MAX_FEN_LEN characters. Does not allocate memory.
+     *  @return The length of the FEN string. */
+    static int toFEN(const Position& pos, char* buf);
+
     /**
      * Convert a chess move to human readable form.
      * @param pos      The chess position.
@@ -77,6 +90,11 @@ public:
      */
     static Move stringToMove(Position& pos, const std::string& strMove);
 
+    /** Like stringToMove() above, but the move string is stored in strMove[0 ... len-1].
+     *  Common SAN and UCI moves are resolved from bitboards, without generating
+     *  all legal moves. Does not allocate memory for short move strings. */
+    static Move stringToMove(Position& pos, const char* strMove, int len);
+
     /**
      * Convert a string, such as "e4" to a square number.
      * @return The square number, or -1 if not a legal square.
@@ -100,6 +118,13 @@ public:
     static std::string squareList(U64 mask);
 
 private:
+    /** Parse a FEN string into pos, which must be a default constructed Position. */
+    static void parseFEN(const char* fen, int len, Position& pos);
+
+    /** Convert file and rank characters, such as 'e' and '4', to a square
+     *  number. @return The square number, or -1 if not a legal square. */
+    static int getSquare(char file, char rank);
+
     static void safeSetPiece(Position& pos, int col, int row, int p);
 
     static int charToPiece(bool white, char c);
@@ -116,6 +141,15 @@ TextIO::getSquare(const std::string& s)
     return Square::getSquare(x, y);
 }
 
+inline int
+TextIO::getSquare(char file, char rank) {
+    int x = file - 'a';
+    int y = rank - '1';
+    if ((x < 0) || (x > 7) || (y < 0) || (y > 7))
+        return -1;
+    return Square::getSquare(x, y);
+}
+
 inline std::string
 TextIO::squareToString(int square)
 {
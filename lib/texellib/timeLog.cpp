@@ -0,0 +1,118 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * timeLog.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "timeLog.hpp"
+#include "treeLogger.hpp"
+#include "chessParseError.hpp"
+
+#include <fstream>
+
+/*
+ * File format, all values stored in native byte order:
+ *   Entry:     U64 hashKey, S32 timeLeft, S32 increment, S32 movesToGo,
+ *              S32 minTimeLimit, S32 maxTimeLimit, S32 earlyStopPercentage,
+ *              S32 timeUsed, U8 nIterations, followed by nIterations Iteration records.
+ *   Iteration: U8 depth, S32 timeMillis, U16 bestMove, U8 bestMoveChanges,
+ *              U16 bestMoveNodes, U8 flags
+ */
+static const int entrySize = 37;
+static const int iterSize = 11;
+
+void
+TimeLog::write(std::ostream& os, const Entry& e) {
+    U8 buf[entrySize];
+    const int nIter = std::min((int)e.iterations.size(), 255);
+    Serializer::serialize<sizeof(buf)>(buf, e.hashKey, (S32)e.timeLeft, (S32)e.increment,
+                                       (S32)e.movesToGo, (S32)e.minTimeLimit,
+                                       (S32)e.maxTimeLimit, (S32)e.earlyStopPercentage,
+                                       (S32)e.timeUsed, (U8)nIter);
+    os.write((const char*)buf, sizeof(buf));
+    for (int i = 0; i < nIter; i++) {
+        const Iteration& it = e.iterations[i];
+        U8 iBuf[iterSize];
+        Serializer::serialize<sizeof(iBuf)>(iBuf, (U8)it.depth, (S32)it.timeMillis, it.bestMove,
+                                            (U8)std::min(it.bestMoveChanges, 255),
+                                            (U16)it.bestMoveNodes, (U8)it.flags);
+        os.write((const char*)iBuf, sizeof(iBuf));
+    }
+}
+
+bool
+TimeLog::read(std::istream& is, Entry& e) {
+    U8 buf[entrySize];
+    is.read((char*)buf, sizeof(buf));
+    if (is.gcount() == 0)
+        return false;
+    if (is.gcount() != sizeof(buf))
+        throw ChessParseError("Truncated time log entry");
+
+    S32 timeLeft, increment, movesToGo, minTimeLimit, maxTimeLimit, esp, timeUsed;
+    U8 nIter;
+    Serializer::deSerialize<sizeof(buf)>(buf, e.hashKey, timeLeft, increment, movesToGo,
+                                         minTimeLimit, maxTimeLimit, esp, timeUsed, nIter);
+    e.timeLeft = timeLeft;
+    e.increment = increment;
+    e.movesToGo = movesToGo;
+    e.minTimeLimit = minTimeLimit;
+    e.maxTimeLimit = maxTimeLimit;
+    e.earlyStopPercentage = esp;
+    e.timeUsed = timeUsed;
+
+    e.iterations.resize(nIter);
+    for (int i = 0; i < nIter; i++) {
+        U8 iBuf[iterSize];
+        is.read((char*)iBuf, sizeof(iBuf));
+        if (is.gcount() != sizeof(iBuf))
+            throw ChessParseError("Truncated time log entry");
+        U8 depth, changes, flags;
+        S32 timeMillis;
+        U16 nodes;
+        Iteration& it = e.iterations[i];
+        Serializer::deSerialize<sizeof(iBuf)>(iBuf, depth, timeMillis, it.bestMove,
+                                              changes, nodes, flags);
+        it.depth = depth;
+        it.timeMillis = timeMillis;
+        it.bestMoveChanges = changes;
+        it.bestMoveNodes = nodes;
+        it.flags = flags;
+    }
+    return true;
+}
+
+void
+TimeLog::appendToFile(const std::string& fileName, const Entry& e) {
+    std::ofstream os(fileName, std::ios_base::out | std::ios_base::binary | std::ios_base::app);
+    write(os, e);
+}
+
+void
+TimeLog::readFile(const std::string& fileName, std::vector<Entry>& entries) {
+    std::ifstream is(fileName, std::ios_base::in | std::ios_base::binary);
+    if (!is)
+        throw ChessParseError("Failed to open file: " + fileName);
+    Entry e;
+    while (read(is, e))
+        entries.push_back(e);
+}
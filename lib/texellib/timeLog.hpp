@@ -0,0 +1,85 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * timeLog.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef TIMELOG_HPP_
+#define TIMELOG_HPP_
+
+#include "util/util.hpp"
+
+#include <vector>
+#include <iosfwd>
+
+/**
+ * Binary log describing how the thinking time was used for each move
+ * in games played with a clock. The log can be replayed offline to
+ * evaluate alternative time allocation formulas.
+ */
+namespace TimeLog {
+
+/** Information about one iterative deepening iteration. */
+struct Iteration {
+    enum Flags : U8 {
+        FAIL_LOW = 1,      // Best move failed low, more time was requested
+        FAIL_HIGH = 2,     // A move other than the first failed high
+        INCOMPLETE = 4,    // Iteration was aborted before all root moves were searched
+    };
+
+    int depth = 0;
+    S64 timeMillis = 0;     // Elapsed time at the end of the iteration
+    U16 bestMove = 0;       // Best move after the iteration, in compressed format
+    int bestMoveChanges = 0;// Number of times the best move changed during the iteration
+    int bestMoveNodes = 0;  // Fraction of nodes spent on the best move, in permille
+    int flags = 0;          // Combination of Flags values
+};
+
+/** Information about the search for one move. */
+struct Entry {
+    U64 hashKey = 0;        // Zobrist hash of the root position
+    int timeLeft = 0;       // Remaining clock time for the side to move
+    int increment = 0;      // Time increment per move
+    int movesToGo = 0;      // Moves to next time control, 0 if not specified
+    int minTimeLimit = -1;  // Time limits passed to the search
+    int maxTimeLimit = -1;
+    int earlyStopPercentage = -1;
+    S64 timeUsed = 0;       // Total time used by the search
+    std::vector<Iteration> iterations;
+};
+
+/** Append an entry to a binary stream. */
+void write(std::ostream& os, const Entry& e);
+
+/** Read next entry from a binary stream. Return false at end of file.
+ *  Throw ChessParseError if the stream is corrupt. */
+bool read(std::istream& is, Entry& e);
+
+/** Append an entry to a log file. */
+void appendToFile(const std::string& fileName, const Entry& e);
+
+/** Read all entries from a log file. */
+void readFile(const std::string& fileName, std::vector<Entry>& entries);
+
+}
+
+#endif /* TIMELOG_HPP_ */
@@ -174,8 +174,7 @@ TranspositionTable::extractPVMoves(const Position& rootPos, const Move& mFirst,
             break;
         ent.getMove(m);
         MoveList moves;
-        MoveGen::pseudoLegalMoves(pos, moves);
-        MoveGen::removeIllegal(pos, moves);
+        MoveGen::legalMoves(pos, moves);
         bool contains = false;
         for (int mi = 0; mi < moves.size; mi++)
             if (moves[mi] == m) {
@@ -201,8 +200,7 @@ TranspositionTable::extractPV(const Position& posIn) {
         Move m;
         ent.getMove(m);
         MoveList moves;
-        MoveGen::pseudoLegalMoves(pos, moves);
-        MoveGen::removeIllegal(pos, moves);
+        MoveGen::legalMoves(pos, moves);
         bool valid = false;
         for (int mi = 0; mi < moves.size; mi++)
             if (moves[mi] == m) {
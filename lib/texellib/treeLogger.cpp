@@ -32,6 +32,7 @@
 #include <iostream>
 #include <iomanip>
 #include <cassert>
+#include <limits>
 
 void
 TreeLoggerWriter::open(const std::string& filename, int threadNo0) {
@@ -90,6 +91,167 @@ TreeLoggerWriter::appendEntry(const Entry& entry) {
     }
 }
 
+TreeLoggerStats::TreeLoggerStats()
+    : opened(false), threadNo(-1), nextIndex(0), rootIndex(0) {
+    clearStats();
+}
+
+TreeLoggerStats::~TreeLoggerStats() {
+    close();
+}
+
+void
+TreeLoggerStats::open(const std::string& filename, int threadNo0) {
+    opened = true;
+    fileName = filename;
+    threadNo = threadNo0;
+    nextIndex = 0;
+    rootIndex = 0;
+    nodeStack.clear();
+    clearStats();
+}
+
+void
+TreeLoggerStats::clearStats() {
+    nodes = 0;
+    for (int i = 0; i < MAX_PLY; i++)
+        nodesByPly[i] = 0;
+    for (int i = 0; i < MAX_DEPTH; i++)
+        nodesByDepth[i] = 0;
+    iterations.clear();
+    cutNodes = 0;
+    firstMoveCuts = 0;
+    noMoveCuts = 0;
+    reSearches = 0;
+    depthReSearches = 0;
+}
+
+void
+TreeLoggerStats::close() {
+    if (!opened)
+        return;
+    opened = false;
+    if (fileName.empty() || nodes == 0)
+        return;
+    auto fn = fileName + ".stats." + num2Str(threadNo);
+    std::ofstream os(fn.c_str(), std::ios_base::out | std::ios_base::app);
+    printSummary(os);
+}
+
+U64
+TreeLoggerStats::logPosition(const Position& pos) {
+    rootIndex = nextIndex++;
+    nodeStack.clear();
+    nodeStack.push_back(NodeInfo{rootIndex, 0, 0, 0});
+    return rootIndex;
+}
+
+void
+TreeLoggerStats::popTo(U64 idx) {
+    while (!nodeStack.empty() && nodeStack.back().index > idx)
+        nodeStack.pop_back();
+}
+
+U64
+TreeLoggerStats::logNodeStart(U64 parentIndex, const Move& m, int alpha, int beta,
+                              int ply, int depth) {
+    if (!opened)
+        return 0;
+    const U64 idx = nextIndex++;
+    nodes++;
+    nodesByPly[clamp(ply, 0, MAX_PLY - 1)]++;
+    nodesByDepth[clamp(depth, 0, MAX_DEPTH - 1)]++;
+
+    popTo(parentIndex);
+    if (parentIndex == rootIndex) {
+        // Root moves can be reduced, so only a larger depth starts a new iteration
+        const int iterDepth = depth + 1;
+        if (iterations.empty() || iterations.back().depth < iterDepth) {
+            iterations.push_back(Iteration{iterDepth, 0});
+            if (!nodeStack.empty())
+                nodeStack.back().nMoves = 0;
+        }
+    }
+    if (!iterations.empty())
+        iterations.back().nodes++;
+
+    // Null move and null move verification searches use moves where from == to
+    if (!nodeStack.empty() && (nodeStack.back().index == parentIndex) && (m.from() != m.to())) {
+        NodeInfo& parent = nodeStack.back();
+        const U16 cMove = m.getCompressedMove();
+        if ((parent.nMoves > 0) && (parent.lastMove == cMove)) {
+            reSearches++;
+            if (depth > parent.lastDepth)
+                depthReSearches++;
+        } else {
+            parent.nMoves++;
+        }
+        parent.lastMove = cMove;
+        parent.lastDepth = depth;
+    }
+    nodeStack.push_back(NodeInfo{idx, 0, 0, 0});
+    return idx;
+}
+
+U64
+TreeLoggerStats::logNodeEnd(U64 startIndex, int score, int scoreType, int evalScore, U64 hashKey) {
+    if (!opened)
+        return 0;
+    popTo(startIndex);
+    if (nodeStack.empty() || (nodeStack.back().index != startIndex) || (startIndex == rootIndex))
+        return nextIndex;
+    const NodeInfo ni = nodeStack.back();
+    nodeStack.pop_back();
+    if (scoreType == TType::T_GE) {
+        cutNodes++;
+        if (ni.nMoves == 0)
+            noMoveCuts++;
+        else if (ni.nMoves == 1)
+            firstMoveCuts++;
+    }
+    return nextIndex;
+}
+
+/** Return a/b as a percentage. */
+static double
+percent(S64 a, S64 b) {
+    return b > 0 ? a * 100.0 / b : 0.0;
+}
+
+void
+TreeLoggerStats::printSummary(std::ostream& os) const {
+    std::ios oldState(nullptr);
+    oldState.copyfmt(os);
+    os << std::fixed << std::setprecision(2);
+
+    os << "search thread " << threadNo << " nodes " << nodes << '\n';
+    for (size_t i = 0; i < iterations.size(); i++) {
+        const Iteration& it = iterations[i];
+        os << "iter " << it.depth << " nodes " << it.nodes;
+        if ((i > 0) && (iterations[i-1].depth == it.depth - 1) && (iterations[i-1].nodes > 0))
+            os << " ebf " << (double)it.nodes / iterations[i-1].nodes;
+        os << '\n';
+    }
+
+    auto printBuckets = [&os](const char* name, const S64* buckets, int n) {
+        os << name;
+        for (int i = 0; i < n; i++)
+            if (buckets[i] > 0)
+                os << ' ' << i << (i == n - 1 ? "+" : "") << ':' << buckets[i];
+        os << '\n';
+    };
+    printBuckets("ply", nodesByPly, MAX_PLY);
+    printBuckets("depth", nodesByDepth, MAX_DEPTH);
+
+    const S64 moveCuts = cutNodes - noMoveCuts;
+    os << "cut " << cutNodes << " nomove " << noMoveCuts
+       << " firstmove " << firstMoveCuts << " (" << percent(firstMoveCuts, moveCuts) << "%)\n";
+    os << "research " << reSearches << " depth " << depthReSearches
+       << " window " << (reSearches - depthReSearches) << std::endl;
+
+    os.copyfmt(oldState);
+}
+
 
 TreeLoggerReader::TreeLoggerReader(const std::string& filename)
     : fs(filename.c_str(), std::ios_base::out |
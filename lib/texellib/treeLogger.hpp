@@ -38,9 +38,14 @@
 
 class TreeLoggerWriter;
 class TreeLoggerWriterDummy;
+class TreeLoggerStats;
 
+#ifdef TREE_STATS
+using TreeLogger = TreeLoggerStats;
+#else
 /** Change to TreeLoggerWriter to enable tree logging. */
 using TreeLogger = TreeLoggerWriterDummy;
+#endif
 
 
 class Position;
@@ -328,6 +333,85 @@ public:
     U64 logNodeEnd(U64 startIndex, int score, int scoreType, int evalScore, U64 hashKey) { return 0; }
 };
 
+/**
+ * Alternative to TreeLoggerWriter that keeps aggregated statistics about the
+ * shape of the search tree in memory instead of storing every node. When the
+ * logger is closed, a text summary is appended to the file
+ * "filename.stats.threadNo". Only nodes visited by negaScout are counted.
+ */
+class TreeLoggerStats {
+public:
+    TreeLoggerStats();
+    ~TreeLoggerStats();
+
+    /** Start collecting statistics for a new search. If filename is empty,
+     *  no summary file is written. */
+    void open(const std::string& filename, int threadNo);
+
+    /** Stop collecting statistics and append the summary to the stats file. */
+    void close();
+
+    bool isOpened() const;
+
+    U64 logPosition(const Position& pos);
+    U64 peekNextNodeIdx() const;
+    U64 logNodeStart(U64 parentIndex, const Move& m, int alpha, int beta, int ply, int depth);
+    U64 logNodeEnd(U64 startIndex, int score, int scoreType, int evalScore, U64 hashKey);
+
+    /** Print a summary of the collected statistics. */
+    void printSummary(std::ostream& os) const;
+
+    static const int MAX_PLY = 64;
+    static const int MAX_DEPTH = 64;
+
+    struct Iteration {
+        int depth;          // Iteration depth
+        S64 nodes;          // Number of nodes searched in this iteration
+    };
+
+    S64 getNodes() const { return nodes; }
+    S64 getNodesByPly(int ply) const { return nodesByPly[clamp(ply, 0, MAX_PLY - 1)]; }
+    S64 getNodesByDepth(int depth) const { return nodesByDepth[clamp(depth, 0, MAX_DEPTH - 1)]; }
+    const std::vector<Iteration>& getIterations() const { return iterations; }
+    S64 getCutNodes() const { return cutNodes; }
+    S64 getFirstMoveCuts() const { return firstMoveCuts; }
+    S64 getNoMoveCuts() const { return noMoveCuts; }
+    S64 getReSearches() const { return reSearches; }
+    S64 getDepthReSearches() const { return depthReSearches; }
+
+private:
+    /** Information about a node on the path from the root to the current node. */
+    struct NodeInfo {
+        U64 index;
+        int nMoves;         // Number of different moves searched so far
+        U16 lastMove;       // Compressed representation of last searched move
+        int lastDepth;      // Search depth used for last searched move
+    };
+
+    /** Set all counters to zero. */
+    void clearStats();
+
+    /** Remove nodes from the node stack until the top node has index <= idx. */
+    void popTo(U64 idx);
+
+    bool opened;
+    std::string fileName;
+    int threadNo;
+    U64 nextIndex;
+    U64 rootIndex;
+    std::vector<NodeInfo> nodeStack;
+
+    S64 nodes;
+    S64 nodesByPly[MAX_PLY];
+    S64 nodesByDepth[MAX_DEPTH];
+    std::vector<Iteration> iterations;
+    S64 cutNodes;           // Nodes failing high
+    S64 firstMoveCuts;      // Nodes failing high on the first searched move
+    S64 noMoveCuts;         // Nodes failing high without searching a move
+    S64 reSearches;         // Moves searched more than once in the same node
+    S64 depthReSearches;    // Re-searches using a larger depth, i.e. LMR re-searches
+};
+
 /**
  * Reader/analysis class for a search tree dumped to a file.
  */
@@ -410,6 +494,16 @@ private:
 };
 
 
+inline bool
+TreeLoggerStats::isOpened() const {
+    return opened;
+}
+
+inline U64
+TreeLoggerStats::peekNextNodeIdx() const {
+    return nextIndex;
+}
+
 inline
 TreeLoggerWriter::TreeLoggerWriter()
     : opened(false), nextIndex(0), threadNo(-1), nInWriteCache(0) {
@@ -0,0 +1,159 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * cpuInfo.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "cpuInfo.hpp"
+#include "util.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CPUINFO_X86
+#if _MSC_VER
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+
+#ifdef CPUINFO_X86
+/** Execute cpuid for a leaf and sub-leaf. Return false if the leaf is not supported. */
+bool
+cpuid(unsigned int leaf, unsigned int subLeaf, U32 regs[4]) {
+#if _MSC_VER
+    int r[4];
+    __cpuid(r, 0);
+    if ((unsigned int)r[0] < leaf)
+        return false;
+    __cpuidex(r, leaf, subLeaf);
+    for (int i = 0; i < 4; i++)
+        regs[i] = r[i];
+#else
+    if ((unsigned int)__get_cpuid_max(0, nullptr) < leaf)
+        return false;
+    unsigned int a, b, c, d;
+    __cpuid_count(leaf, subLeaf, a, b, c, d);
+    regs[0] = a; regs[1] = b; regs[2] = c; regs[3] = d;
+#endif
+    return true;
+}
+
+/** Return the XCR0 register, which tells which register states the OS saves. */
+U64
+xgetbv0() {
+#if _MSC_VER
+    return _xgetbv(0);
+#else
+    U32 lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((U64)hi << 32) | lo;
+#endif
+}
+#endif
+
+void
+addFeature(std::string& s, const char* name) {
+    if (!s.empty())
+        s += ',';
+    s += name;
+}
+
+}
+
+const CpuInfo&
+CpuInfo::instance() {
+    static CpuInfo inst;
+    return inst;
+}
+
+CpuInfo::CpuInfo() {
+#ifdef CPUINFO_X86
+    U32 r[4];
+    if (!cpuid(0, 0, r))
+        return;
+    const bool amd = r[1] == 0x68747541; // "Auth" from "AuthenticAMD"
+
+    if (!cpuid(1, 0, r))
+        return;
+    const U32 ecx1 = r[2];
+    int family = (r[0] >> 8) & 0xf;
+    if (family == 0xf)
+        family += (r[0] >> 20) & 0xff;
+    popcnt = (ecx1 & (1 << 23)) != 0;
+
+    bool ymmEnabled = false, zmmEnabled = false;
+    if (ecx1 & (1 << 27)) { // OSXSAVE
+        U64 xcr0 = xgetbv0();
+        ymmEnabled = (xcr0 & 0x06) == 0x06;
+        zmmEnabled = (xcr0 & 0xe6) == 0xe6;
+    }
+
+    if (cpuid(7, 0, r)) {
+        const U32 ebx7 = r[1];
+        bmi2 = (ebx7 & (1 << 8)) != 0;
+        avx2 = ymmEnabled && (ebx7 & (1 << 5)) != 0;
+        avx512 = zmmEnabled && (ebx7 & (1 << 16)) != 0 && (ebx7 & (1 << 30)) != 0;
+    }
+    fastPext = bmi2 && !(amd && family < 0x19);
+#endif
+}
+
+std::string
+CpuInfo::featureString() const {
+    std::string ret;
+    if (popcnt)
+        addFeature(ret, "POPCNT");
+    if (bmi2)
+        addFeature(ret, fastPext ? "BMI2" : "BMI2(slow pext)");
+    if (avx2)
+        addFeature(ret, "AVX2");
+    if (avx512)
+        addFeature(ret, "AVX512");
+    if (ret.empty())
+        ret = "none";
+    return ret;
+}
+
+std::string
+CpuInfo::missingFeatures() const {
+    std::string ret;
+#ifdef HAS_POPCNT
+    if (!popcnt)
+        addFeature(ret, "POPCNT");
+#endif
+#ifdef HAS_BMI2
+    if (!bmi2)
+        addFeature(ret, "BMI2");
+#endif
+#ifdef __AVX2__
+    if (!avx2)
+        addFeature(ret, "AVX2");
+#endif
+#ifdef __AVX512F__
+    if (!avx512)
+        addFeature(ret, "AVX512");
+#endif
+    return ret;
+}
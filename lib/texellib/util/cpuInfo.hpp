@@ -0,0 +1,98 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * cpuInfo.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef CPUINFO_HPP_
+#define CPUINFO_HPP_
+
+#include <string>
+
+/**
+ * Information about instruction set extensions supported by the CPU the
+ * program is running on. The information is obtained using the cpuid
+ * instruction the first time instance() is called. On non-x86 systems no
+ * extensions are reported.
+ */
+class CpuInfo {
+public:
+    /** Get the singleton instance. */
+    static const CpuInfo& instance();
+
+    /** True if the popcnt instruction is supported. */
+    bool hasPopcnt() const;
+    /** True if the BMI2 instructions are supported. */
+    bool hasBmi2() const;
+    /** True if BMI2 is supported and pext is fast. On AMD CPUs before Zen 3
+     *  pext is microcoded and much slower than a magic multiplication. */
+    bool hasFastPext() const;
+    /** True if AVX2 is supported by the CPU and enabled by the OS. */
+    bool hasAvx2() const;
+    /** True if AVX-512 F and BW are supported by the CPU and enabled by the OS. */
+    bool hasAvx512() const;
+
+    /** Comma separated list of supported features, such as "POPCNT,BMI2,AVX2",
+     *  or "none" if no feature is supported. */
+    std::string featureString() const;
+
+    /** Comma separated list of features the program was compiled to require
+     *  but which are not supported by the CPU. Empty if all required
+     *  features are supported. */
+    std::string missingFeatures() const;
+
+private:
+    CpuInfo();
+
+    bool popcnt = false;
+    bool bmi2 = false;
+    bool fastPext = false;
+    bool avx2 = false;
+    bool avx512 = false;
+};
+
+inline bool
+CpuInfo::hasPopcnt() const {
+    return popcnt;
+}
+
+inline bool
+CpuInfo::hasBmi2() const {
+    return bmi2;
+}
+
+inline bool
+CpuInfo::hasFastPext() const {
+    return fastPext;
+}
+
+inline bool
+CpuInfo::hasAvx2() const {
+    return avx2;
+}
+
+inline bool
+CpuInfo::hasAvx512() const {
+    return avx512;
+}
+
+#endif /* CPUINFO_HPP_ */
@@ -0,0 +1,265 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * benchcmp.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "benchcmp.hpp"
+#include "util/timeUtil.hpp"
+#include "chessParseError.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <memory>
+#include <cstdio>
+#include <cmath>
+
+#ifdef _MSC_VER
+#define popen _popen
+#define pclose _pclose
+#endif
+
+
+BenchCmp::BenchCmp(const Engine& a, const Engine& b, int nPairs,
+                   int hashMB, int threads, int depth)
+    : engineA(a), engineB(b), nPairs(std::max(nPairs, 2)),
+      hashMB(hashMB), threads(threads), depth(depth) {
+}
+
+BenchCmp::Comparison
+BenchCmp::run(double maxSlowdown, std::ostream& log, std::ostream* json) {
+    std::vector<double> npsA, npsB;
+    for (int i = 0; i < nPairs; i++) {
+        // Alternate the order within a pair to cancel out systematic effects
+        // such as CPU frequency changes caused by the previous run
+        bool aFirst = (i % 2) == 0;
+        RunResult rA, rB;
+        for (int k = 0; k < 2; k++) {
+            bool isA = (k == 0) == aFirst;
+            const Engine& e = isA ? engineA : engineB;
+            RunResult r = runEngine(e);
+            log << "pair " << (i+1) << '/' << nPairs << ' ' << (isA ? 'A' : 'B')
+                << " nodes " << r.nodes << " time " << r.timeMillis
+                << " nps " << r.nps << std::endl;
+            if (json)
+                writeJsonRun(*json, isA ? "A" : "B", e, i + 1, r);
+            (isA ? rA : rB) = r;
+        }
+        npsA.push_back(rA.nps);
+        npsB.push_back(rB.nps);
+    }
+    Comparison c = compare(npsA, npsB, maxSlowdown);
+    if (json)
+        writeJsonSummary(*json, c);
+    return c;
+}
+
+std::vector<std::string>
+BenchCmp::uciCommands(const Engine& e, int hashMB, int threads, int depth) {
+    std::vector<std::string> ret;
+    for (const auto& opt : e.options)
+        ret.push_back("setoption name " + opt.first + " value " + opt.second);
+    ret.push_back("isready");
+    ret.push_back("bench " + num2Str(hashMB) + " " + num2Str(threads) + " " + num2Str(depth));
+    ret.push_back("quit");
+    return ret;
+}
+
+/** Quote a string so that a POSIX shell treats it as a single word. */
+static std::string
+shellQuote(const std::string& s) {
+    std::string ret = "'";
+    for (char c : s) {
+        if (c == '\'')
+            ret += "'\\''";
+        else
+            ret += c;
+    }
+    ret += "'";
+    return ret;
+}
+
+BenchCmp::RunResult
+BenchCmp::runEngine(const Engine& e) const {
+    std::string cmdLine = "printf '%s\\n'";
+    for (const std::string& cmd : uciCommands(e, hashMB, threads, depth))
+        cmdLine += " " + shellQuote(cmd);
+    cmdLine += " | " + e.command;
+
+    std::string output;
+    {
+        std::shared_ptr<FILE> f(popen(cmdLine.c_str(), "r"),
+                                [](FILE* f) { if (f) pclose(f); });
+        if (!f)
+            throw ChessParseError("Failed to run engine: " + e.command);
+        char buf[256];
+        while (fgets(buf, sizeof(buf), f.get()))
+            output += buf;
+    }
+
+    RunResult r;
+    std::istringstream is(output);
+    if (!parseBenchOutput(is, r))
+        throw ChessParseError("No benchmark result from engine: " + e.command);
+    return r;
+}
+
+bool
+BenchCmp::parseBenchOutput(std::istream& is, RunResult& r) {
+    bool hasNodes = false, hasNps = false;
+    std::string line;
+    while (std::getline(is, line)) {
+        size_t idx = line.find(':');
+        if (idx == std::string::npos)
+            continue;
+        std::string key = trim(line.substr(0, idx));
+        std::vector<std::string> words;
+        splitString(line.substr(idx + 1), words);
+        if (words.empty())
+            continue;
+        if (key == "Total time") {
+            str2Num(words[0], r.timeMillis);
+        } else if (key == "Nodes") {
+            hasNodes = str2Num(words[0], r.nodes);
+        } else if (key == "Nodes/sec") {
+            hasNps = str2Num(words[0], r.nps);
+        } else if (key == "Build") {
+            r.build.clear();
+            for (const std::string& w : words) {
+                size_t eq = w.find('=');
+                if (eq != std::string::npos)
+                    r.build.push_back(std::make_pair(w.substr(0, eq), w.substr(eq + 1)));
+            }
+        }
+    }
+    return hasNodes && hasNps;
+}
+
+double
+BenchCmp::tQuantile975(int df) {
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+         2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+         2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+    if (df < 1)
+        return INFINITY;
+    if (df <= (int)COUNT_OF(table))
+        return table[df - 1];
+    return 1.96 + 2.4 / df; // Accurate to within 0.003 for df > 30
+}
+
+BenchCmp::Comparison
+BenchCmp::compare(const std::vector<double>& npsA, const std::vector<double>& npsB,
+                  double maxSlowdown) {
+    SampleStatistics statA, statB, statDiff;
+    const int n = std::min(npsA.size(), npsB.size());
+    for (int i = 0; i < n; i++) {
+        statA.addSample(npsA[i]);
+        statB.addSample(npsB[i]);
+        if (npsA[i] > 0)
+            statDiff.addSample((npsB[i] / npsA[i] - 1) * 100);
+    }
+
+    Comparison c;
+    c.nPairs = statDiff.numSamples();
+    c.npsA = statA.avg();
+    c.npsB = statB.avg();
+    c.diff = statDiff.avg();
+    double delta = c.nPairs > 1 ? tQuantile975(c.nPairs - 1) * statDiff.std() / ::sqrt(c.nPairs)
+                                : INFINITY;
+    c.ciLow = c.diff - delta;
+    c.ciHigh = c.diff + delta;
+    c.slowdown = c.ciHigh < -maxSlowdown;
+    return c;
+}
+
+void
+BenchCmp::printComparison(const Comparison& c, std::ostream& os) {
+    os << std::fixed << std::setprecision(0);
+    os << "pairs    : " << c.nPairs << std::endl;
+    os << "nps A    : " << c.npsA << std::endl;
+    os << "nps B    : " << c.npsB << std::endl;
+    os << std::setprecision(2);
+    os << "B vs A   : " << std::showpos << c.diff << "% (95% CI "
+       << c.ciLow << "% .. " << c.ciHigh << "%)" << std::noshowpos << std::endl;
+    os << "result   : " << (c.slowdown ? "B is significantly slower" :
+                            (c.ciLow > 0 ? "B is significantly faster" :
+                                           "no significant slowdown")) << std::endl;
+}
+
+/** Return a string as a quoted JSON string. */
+static std::string
+jsonString(const std::string& s) {
+    std::string ret = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            ret += '\\';
+            ret += c;
+        } else if ((unsigned char)c < 0x20) {
+            std::ostringstream os;
+            os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c;
+            ret += os.str();
+        } else
+            ret += c;
+    }
+    ret += "\"";
+    return ret;
+}
+
+void
+BenchCmp::writeJsonRun(std::ostream& os, const std::string& label,
+                       const Engine& e, int runNo, const RunResult& r) {
+    os << "{\"type\":\"run\",\"engine\":" << jsonString(label)
+       << ",\"command\":" << jsonString(e.command)
+       << ",\"options\":{";
+    bool first = true;
+    for (const auto& opt : e.options) {
+        os << (first ? "" : ",") << jsonString(opt.first) << ':' << jsonString(opt.second);
+        first = false;
+    }
+    os << "},\"build\":{";
+    first = true;
+    for (const auto& b : r.build) {
+        os << (first ? "" : ",") << jsonString(b.first) << ':' << jsonString(b.second);
+        first = false;
+    }
+    os << "},\"pair\":" << runNo << ",\"nodes\":" << r.nodes
+       << ",\"timeMs\":" << r.timeMillis << ",\"nps\":" << r.nps << '}' << std::endl;
+}
+
+void
+BenchCmp::writeJsonSummary(std::ostream& os, const Comparison& c) {
+    auto num = [](double v) -> std::string {
+        if (!std::isfinite(v))
+            return "null";
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(3) << v;
+        return ss.str();
+    };
+    os << "{\"type\":\"summary\",\"pairs\":" << c.nPairs
+       << ",\"npsA\":" << num(c.npsA) << ",\"npsB\":" << num(c.npsB)
+       << ",\"diffPct\":" << num(c.diff)
+       << ",\"ciLowPct\":" << num(c.ciLow) << ",\"ciHighPct\":" << num(c.ciHigh)
+       << ",\"slowdown\":" << (c.slowdown ? "true" : "false") << '}' << std::endl;
+}
@@ -0,0 +1,121 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * benchcmp.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef BENCHCMP_HPP_
+#define BENCHCMP_HPP_
+
+#include "util/util.hpp"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <iosfwd>
+
+/**
+ * Compare the search speed of two engine configurations by running the UCI
+ * "bench" command repeatedly. The configurations can be two different engine
+ * binaries, or the same binary with different UCI options.
+ *
+ * Runs are interleaved and the order within each pair of runs alternates, so
+ * that slow changes in machine load affect both configurations equally. The
+ * relative NPS difference is computed for each pair and a confidence interval
+ * for the mean difference is computed using the t distribution.
+ */
+class BenchCmp {
+public:
+    /** An engine configuration. */
+    struct Engine {
+        std::string command;   // Shell command starting the engine
+        std::vector<std::pair<std::string, std::string>> options; // UCI options
+    };
+
+    /** Result of one bench run. */
+    struct RunResult {
+        S64 nodes = 0;
+        S64 timeMillis = 0;
+        S64 nps = 0;
+        std::vector<std::pair<std::string, std::string>> build; // Build options
+    };
+
+    /** Statistical comparison of configuration B relative to configuration A. */
+    struct Comparison {
+        int nPairs = 0;
+        double npsA = 0;       // Average NPS for A
+        double npsB = 0;       // Average NPS for B
+        double diff = 0;       // Average relative NPS difference, in percent
+        double ciLow = 0;      // 95% confidence interval for diff
+        double ciHigh = 0;
+        bool slowdown = false; // True if B is significantly slower than A
+    };
+
+    /** Constructor. */
+    BenchCmp(const Engine& a, const Engine& b, int nPairs,
+             int hashMB, int threads, int depth);
+
+    /** Run all benchmarks. Progress is printed to "log". If "json" is not null,
+     *  one JSON object per run and a summary object are written to it.
+     *  @param maxSlowdown  B is only considered slower if the confidence interval
+     *                      upper limit is below -maxSlowdown percent. */
+    Comparison run(double maxSlowdown, std::ostream& log, std::ostream* json);
+
+    /** Return the UCI commands that set the options and run the benchmark. */
+    static std::vector<std::string> uciCommands(const Engine& e, int hashMB,
+                                                int threads, int depth);
+
+    /** Parse output from the bench command.
+     *  @return False if the output does not contain the benchmark result. */
+    static bool parseBenchOutput(std::istream& is, RunResult& r);
+
+    /** Compare NPS samples. npsA[i] and npsB[i] are measured in the same pair of runs. */
+    static Comparison compare(const std::vector<double>& npsA,
+                              const std::vector<double>& npsB,
+                              double maxSlowdown);
+
+    /** Return the 97.5% quantile of the t distribution with "df" degrees of freedom. */
+    static double tQuantile975(int df);
+
+    /** Print a comparison as human readable text. */
+    static void printComparison(const Comparison& c, std::ostream& os);
+
+    /** Write one run as a JSON object on a single line. */
+    static void writeJsonRun(std::ostream& os, const std::string& label,
+                             const Engine& e, int runNo, const RunResult& r);
+
+    /** Write a comparison as a JSON object on a single line. */
+    static void writeJsonSummary(std::ostream& os, const Comparison& c);
+
+private:
+    /** Run the bench command once for an engine configuration. */
+    RunResult runEngine(const Engine& e) const;
+
+    const Engine engineA;
+    const Engine engineB;
+    const int nPairs;
+    const int hashMB;
+    const int threads;
+    const int depth;
+};
+
+#endif /* BENCHCMP_HPP_ */
@@ -0,0 +1,155 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * perft.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "perft.hpp"
+#include "threadpool.hpp"
+#include "moveGen.hpp"
+#include "textio.hpp"
+#include "util/timeUtil.hpp"
+
+#include <iostream>
+#include <iomanip>
+
+
+static U64
+hashTableEntries(int hashSizeMB, size_t entrySize) {
+    if (hashSizeMB <= 0)
+        return 0;
+    U64 maxEntries = (U64)hashSizeMB * (1 << 20) / entrySize;
+    U64 n = 1;
+    while (n * 2 <= maxEntries)
+        n *= 2;
+    return n;
+}
+
+PerfT::PerfT(int nThreads, int hashSizeMB)
+    : nThreads(std::max(nThreads, 1)),
+      hashTable(hashTableEntries(hashSizeMB, sizeof(HashEntry))) {
+}
+
+U64
+PerfT::perfT(const Position& pos, int depth, std::vector<MoveCount>& divide) {
+    divide.clear();
+    if (depth <= 0)
+        return 1;
+
+    Position rootPos(pos);
+    MoveList moves;
+    MoveGen::legalMoves(rootPos, moves);
+    for (int mi = 0; mi < moves.size; mi++)
+        divide.push_back(MoveCount{moves[mi], 1});
+    if (depth == 1)
+        return moves.size;
+
+    ThreadPool<std::pair<int,U64>> pool(nThreads);
+    for (int mi = 0; mi < moves.size; mi++) {
+        auto func = [this,&rootPos,&moves,mi,depth](int workerNo) {
+            Position pos(rootPos);
+            UndoInfo ui;
+            pos.makeMove(moves[mi], ui);
+            return std::make_pair(mi, perfTRecursive(pos, depth - 1));
+        };
+        pool.addTask(func);
+    }
+
+    U64 nodes = 0;
+    std::pair<int,U64> result;
+    while (pool.getResult(result)) {
+        divide[result.first].nodes = result.second;
+        nodes += result.second;
+    }
+    return nodes;
+}
+
+U64
+PerfT::perfTRecursive(Position& pos, int depth) {
+    const U64 key = pos.zobristHash();
+    U64 nodes;
+    if ((depth > 1) && probe(key, depth, nodes))
+        return nodes;
+
+    MoveList moves;
+    MoveGen::legalMoves(pos, moves);
+    if (depth == 1)
+        return moves.size;
+
+    nodes = 0;
+    UndoInfo ui;
+    for (int mi = 0; mi < moves.size; mi++) {
+        const Move& m = moves[mi];
+        pos.makeMove(m, ui);
+        nodes += perfTRecursive(pos, depth - 1);
+        pos.unMakeMove(m, ui);
+    }
+    store(key, depth, nodes);
+    return nodes;
+}
+
+bool
+PerfT::probe(U64 key, int depth, U64& nodes) const {
+    if (hashTable.empty())
+        return false;
+    const HashEntry& ent = hashTable[key & (hashTable.size() - 1)];
+    U64 data = ent.data.load(std::memory_order_relaxed);
+    if ((ent.key.load(std::memory_order_relaxed) ^ data) != key)
+        return false;
+    if ((int)(data & 0xff) != depth)
+        return false;
+    nodes = data >> 8;
+    return true;
+}
+
+void
+PerfT::store(U64 key, int depth, U64 nodes) {
+    if (hashTable.empty())
+        return;
+    HashEntry& ent = hashTable[key & (hashTable.size() - 1)];
+    U64 data = (nodes << 8) | depth;
+    ent.key.store(key ^ data, std::memory_order_relaxed);
+    ent.data.store(data, std::memory_order_relaxed);
+}
+
+void
+PerfT::run(const Position& pos, int depth, bool divide, std::ostream& os) {
+    std::vector<MoveCount> moveCounts;
+    S64 t0 = currentTimeMillis();
+    U64 nodes = perfT(pos, depth, moveCounts);
+    S64 t1 = currentTimeMillis();
+
+    if (divide) {
+        for (const MoveCount& mc : moveCounts) {
+            os << std::setw(7) << std::left
+               << TextIO::moveToString(pos, mc.move, false)
+               << std::right << ' ' << mc.nodes << '\n';
+        }
+    }
+
+    double t = (t1 - t0) * 1e-3;
+    os << "perft(" << depth << ") = " << nodes
+       << " t=" << std::fixed << std::setprecision(3) << t << "s";
+    if (t1 > t0)
+        os << " nps=" << (S64)(nodes / t);
+    os << std::endl;
+}
@@ -0,0 +1,82 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * perft.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef PERFT_HPP_
+#define PERFT_HPP_
+
+#include "position.hpp"
+#include "move.hpp"
+
+#include <vector>
+#include <atomic>
+#include <iosfwd>
+
+/**
+ * Multi-threaded perft computation. Root moves are distributed over the
+ * worker threads. Counting is done in bulk at the last ply and an optional
+ * hash table, shared by all threads, stores node counts for sub trees.
+ */
+class PerfT {
+public:
+    /** Constructor.
+     * @param nThreads    Number of worker threads.
+     * @param hashSizeMB  Size of the hash table. 0 disables hashing. */
+    PerfT(int nThreads, int hashSizeMB);
+
+    /** Number of leaf nodes below a root move. */
+    struct MoveCount {
+        Move move;
+        U64 nodes;
+    };
+
+    /** Compute perft(depth) for pos. The node count for each legal root move
+     *  is stored in "divide", in move generator order. */
+    U64 perfT(const Position& pos, int depth, std::vector<MoveCount>& divide);
+
+    /** Compute perft(depth) for pos and print the result and the speed to os.
+     *  If "divide" is true, also print the node count for each root move. */
+    void run(const Position& pos, int depth, bool divide, std::ostream& os);
+
+private:
+    /** Compute perft for the sub tree below pos. */
+    U64 perfTRecursive(Position& pos, int depth);
+
+    /** Look up node count for a position/depth in the hash table. */
+    bool probe(U64 key, int depth, U64& nodes) const;
+    /** Store node count for a position/depth in the hash table. */
+    void store(U64 key, int depth, U64 nodes);
+
+    /** Hash table entry. The key is stored XORed with the data to detect
+     *  entries that have been partially overwritten by another thread. */
+    struct HashEntry {
+        std::atomic<U64> key;
+        std::atomic<U64> data; // 0-7: depth, 8-63: node count
+    };
+
+    const int nThreads;
+    std::vector<HashEntry> hashTable;
+};
+
+#endif /* PERFT_HPP_ */
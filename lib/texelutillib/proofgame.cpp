@@ -192,8 +192,7 @@ ProofGame::search(const std::string& initialFen, std::vector<Move>& movePath) {
 #endif
 
         MoveList moves;
-        MoveGen::pseudoLegalMoves(pos, moves);
-        MoveGen::removeIllegal(pos, moves);
+        MoveGen::legalMoves(pos, moves);
         for (int i = 0; i < moves.size; i++) {
             if (((1ULL << moves[i].from()) | (1ULL << moves[i].to())) & blocked)
                 continue;
@@ -244,8 +243,7 @@ ProofGame::getSolution(const Position& startPos, int idx, std::vector<Move>& mov
         Position pos;
         pos.deSerialize(nodes[tn.parent].psd);
         MoveList moves;
-        MoveGen::pseudoLegalMoves(pos, moves);
-        MoveGen::removeIllegal(pos, moves);
+        MoveGen::legalMoves(pos, moves);
         UndoInfo ui;
         for (int i = 0; i < moves.size; i++) {
             pos.makeMove(moves[i], ui);
@@ -0,0 +1,211 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * smpbench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "smpbench.hpp"
+#include "search.hpp"
+#include "parallel.hpp"
+#include "killerTable.hpp"
+#include "history.hpp"
+#include "evaluate.hpp"
+#include "treeLogger.hpp"
+#include "moveGen.hpp"
+#include "textio.hpp"
+#include "numa.hpp"
+#include "parameters.hpp"
+#include "sharedEvalHash.hpp"
+#include "util/timeUtil.hpp"
+
+#include <iostream>
+#include <iomanip>
+
+
+SmpBench::SmpBench(int maxThreads, int depth, int hashSizeMB,
+                   bool compareSharedEvalHash)
+    : maxThreads(std::max(maxThreads, 1)), depth(depth),
+      compareSharedEvalHash(compareSharedEvalHash),
+      tt(((U64)std::max(hashSizeMB, 1)) * (1 << 20) / sizeof(TranspositionTable::TTEntry)) {
+}
+
+std::vector<int>
+SmpBench::threadCounts(int maxThreads) {
+    std::vector<int> ret;
+    for (int n = 1; n < maxThreads; n *= 2)
+        ret.push_back(n);
+    ret.push_back(std::max(maxThreads, 1));
+    return ret;
+}
+
+std::vector<Position>
+SmpBench::defaultPositions() {
+    static const char* fens[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 10",
+        "4rrk1/pp1n3p/3q2pQ/2p1pb2/2PP4/2P3N1/P2B2PP/4RRK1 b - - 7 19",
+        "rq3rk1/ppp2ppp/1bnpb3/3N2B1/3NP3/7P/PPPQ1PP1/2KR3R w - - 7 14",
+        "r1bq1r1k/b1p1npp1/p2p3p/1p6/3PP3/1B2NN2/PP3PPP/R2Q1RK1 w - - 1 16",
+        "r2q1rk1/pb2bppp/1pn1pn2/2pp4/3P4/1PNBPN2/PB3PPP/R2Q1RK1 w - - 2 10",
+        "6k1/6p1/6Pp/ppp5/3pn2P/1P3K2/1PP2P2/3N4 b - - 0 1",
+        "8/pp2r1k1/2p1p3/3pP2p/1P1P1P1P/P5KR/8/8 w - - 0 1",
+    };
+    std::vector<Position> ret;
+    for (const char* fen : fens)
+        ret.push_back(TextIO::readFEN(fen));
+    return ret;
+}
+
+void
+SmpBench::run(const std::vector<Position>& positions, std::vector<Result>& results,
+              std::ostream& log) {
+    Numa::instance().bindThread(0);
+    Parameters& params = Parameters::instance();
+    const bool oldSharedEvalHash = params.getBoolPar("SharedEvalHash");
+    results.clear();
+    for (int nThreads : threadCounts(maxThreads)) {
+        results.push_back(runThreads(positions, nThreads, false, log));
+        if (compareSharedEvalHash)
+            results.push_back(runThreads(positions, nThreads, true, log));
+    }
+    params.set("SharedEvalHash", oldSharedEvalHash ? "true" : "false");
+    SharedEvalHash::instance().reset();
+}
+
+SmpBench::Result
+SmpBench::runThreads(const std::vector<Position>& positions, int nThreads,
+                     bool sharedEvalHash, std::ostream& log) {
+    Parameters::instance().set("SharedEvalHash", sharedEvalHash ? "true" : "false");
+    SharedEvalHash::instance().reset();
+
+    Notifier notifier;
+    ThreadCommunicator comm(nullptr, tt, notifier, false);
+    std::vector<std::shared_ptr<WorkerThread>> children;
+    WorkerThread::createWorkers(1, &comm, nThreads - 1, tt, children);
+
+    KillerTable kt;
+    History ht;
+    auto et = Evaluate::getEvalHashTables();
+    TreeLogger treeLog;
+    std::vector<U64> posHashList(SearchConst::MAX_SEARCH_DEPTH * 2);
+
+    class Handler : public Communicator::CommandHandler {
+    public:
+        explicit Handler(Communicator& comm) : comm(comm) {}
+        void stopAck() override { comm.sendStopAck(true); }
+    private:
+        Communicator& comm;
+    };
+    Handler handler(comm);
+
+    Result res;
+    res.nThreads = nThreads;
+    res.sharedEvalHash = sharedEvalHash;
+    for (size_t i = 0; i < positions.size(); i++) {
+        Position pos = positions[i];
+        tt.clear();
+        ht.init();
+        Search::SearchTables st(comm.getCTT(), kt, ht, *et);
+        Search sc(pos, posHashList, 0, st, comm, treeLog);
+
+        MoveList moves;
+        MoveGen::legalMoves(pos, moves);
+        sc.scoreMoveList(moves, 0);
+        S64 t0 = currentTimeMillis();
+        sc.iterativeDeepening(moves, depth, -1, 1, false, 0, true);
+        S64 t1 = currentTimeMillis();
+
+        comm.sendStopSearch();
+        comm.sendStopAck(false);
+        while (!comm.hasStopAck()) {
+            comm.poll(handler);
+            if (!comm.hasStopAck())
+                notifier.wait();
+        }
+
+        S64 nodes = sc.getTotalNodesThisThread() + comm.getNumSearchedNodes();
+        res.timeMillis += t1 - t0;
+        res.nodes += nodes;
+        res.helperJobs += sc.getNumHelperJobs();
+        res.helperResults += sc.getNumHelperResults();
+        res.helperResultsUsed += sc.getNumHelperResultsUsed();
+        log << "threads " << nThreads << (sharedEvalHash ? " shared" : "")
+            << " position " << (i+1) << '/' << positions.size()
+            << " time " << (t1 - t0) << " nodes " << nodes << std::endl;
+    }
+    return res;
+}
+
+/** Return a/b, or 0 if b is 0. */
+static double
+ratio(double a, double b) {
+    return b != 0 ? a / b : 0.0;
+}
+
+static S64
+nps(const SmpBench::Result& r) {
+    return (S64)ratio(r.nodes * 1000.0, std::max(r.timeMillis, (S64)1));
+}
+
+void
+SmpBench::printTable(const std::vector<Result>& results, std::ostream& os) {
+    if (results.empty())
+        return;
+    const Result& base = results[0];
+    os << "threads evalhash     time speedup       nodes        nps npsscale extranodes"
+          "     jobs  results    used" << std::endl;
+    for (const Result& r : results) {
+        os << std::setw(7) << r.nThreads
+           << ' ' << std::setw(8) << (r.sharedEvalHash ? "shared" : "thread")
+           << ' ' << std::setw(8) << r.timeMillis
+           << ' ' << std::setw(7) << std::fixed << std::setprecision(2)
+           << ratio(base.timeMillis, r.timeMillis)
+           << ' ' << std::setw(11) << r.nodes
+           << ' ' << std::setw(10) << nps(r)
+           << ' ' << std::setw(8) << ratio(nps(r), nps(base))
+           << ' ' << std::setw(9) << std::setprecision(1)
+           << (ratio(r.nodes, base.nodes) - 1) * 100 << '%'
+           << ' ' << std::setw(8) << r.helperJobs
+           << ' ' << std::setw(8) << r.helperResults
+           << ' ' << std::setw(6) << ratio(r.helperResultsUsed, r.helperJobs) * 100 << '%'
+           << std::endl;
+    }
+}
+
+void
+SmpBench::printCsv(const std::vector<Result>& results, std::ostream& os) {
+    if (results.empty())
+        return;
+    const Result& base = results[0];
+    os << "threads,shared_eval_hash,time_ms,speedup,nodes,nps,nps_scaling,extra_nodes,"
+          "helper_jobs,helper_results,helper_results_used" << std::endl;
+    os << std::fixed << std::setprecision(3);
+    for (const Result& r : results) {
+        os << r.nThreads << ',' << (r.sharedEvalHash ? 1 : 0) << ',' << r.timeMillis
+           << ',' << ratio(base.timeMillis, r.timeMillis)
+           << ',' << r.nodes << ',' << nps(r)
+           << ',' << ratio(nps(r), nps(base))
+           << ',' << ratio(r.nodes, base.nodes) - 1
+           << ',' << r.helperJobs << ',' << r.helperResults
+           << ',' << r.helperResultsUsed << std::endl;
+    }
+}
@@ -0,0 +1,90 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * smpbench.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SMPBENCH_HPP_
+#define SMPBENCH_HPP_
+
+#include "position.hpp"
+#include "transpositionTable.hpp"
+
+#include <vector>
+#include <iosfwd>
+
+/**
+ * Measure how the parallel search scales with the number of threads.
+ * A set of positions is searched to a fixed depth using 1, 2, 4, ... threads.
+ * The search uses the same WorkerThread/Communicator code as the engine.
+ */
+class SmpBench {
+public:
+    /** Constructor.
+     * @param maxThreads  Largest number of threads to test.
+     * @param depth       Search depth for each position.
+     * @param hashSizeMB  Transposition table size.
+     * @param compareSharedEvalHash  If true, search with both per-thread and
+     *                               shared pawn/king safety hash tables. */
+    SmpBench(int maxThreads, int depth, int hashSizeMB,
+             bool compareSharedEvalHash = false);
+
+    /** Search result for one thread count, summed over all positions. */
+    struct Result {
+        int nThreads = 0;
+        bool sharedEvalHash = false; // True if shared pawn/king safety hash tables were used
+        S64 timeMillis = 0;        // Time to reach the search depth
+        S64 nodes = 0;             // Number of searched nodes, all threads
+        S64 helperJobs = 0;        // Number of jobs sent to helper threads
+        S64 helperResults = 0;     // Number of results received from helper threads
+        S64 helperResultsUsed = 0; // Number of helper results used by the main thread
+    };
+
+    /** Search all positions for each thread count. Progress is printed to log. */
+    void run(const std::vector<Position>& positions, std::vector<Result>& results,
+             std::ostream& log);
+
+    /** Print results as a table. Speedup, NPS scaling and extra nodes are
+     *  computed relative to the first result. */
+    static void printTable(const std::vector<Result>& results, std::ostream& os);
+
+    /** Print results in CSV format. */
+    static void printCsv(const std::vector<Result>& results, std::ostream& os);
+
+    /** Return the thread counts to test: 1, 2, 4, ..., maxThreads. */
+    static std::vector<int> threadCounts(int maxThreads);
+
+    /** Return the default set of test positions. */
+    static std::vector<Position> defaultPositions();
+
+private:
+    /** Search all positions using nThreads threads. */
+    Result runThreads(const std::vector<Position>& positions, int nThreads,
+                      bool sharedEvalHash, std::ostream& log);
+
+    const int maxThreads;
+    const int depth;
+    const bool compareSharedEvalHash;
+    TranspositionTable tt;
+};
+
+#endif /* SMPBENCH_HPP_ */
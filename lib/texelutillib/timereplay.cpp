@@ -0,0 +1,190 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * timereplay.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "timereplay.hpp"
+#include "search.hpp"
+#include "parameters.hpp"
+#include "chessParseError.hpp"
+
+#include <iostream>
+#include <iomanip>
+
+
+TimeReplay::Formula::Formula()
+    : name("current"),
+      maxRemainingMoves(timeMaxRemainingMoves),
+      bufferTime(::bufferTime),
+      minTimeUsage(::minTimeUsage),
+      maxTimeUsage(::maxTimeUsage),
+      useHardFactor(true) {
+}
+
+TimeReplay::Formula
+TimeReplay::Formula::parse(const std::string& spec) {
+    Formula f;
+    f.name = spec;
+    std::string s = spec;
+    for (char& c : s)
+        if (c == ',')
+            c = ' ';
+    std::vector<std::string> items;
+    splitString(s, items);
+    for (const std::string& item : items) {
+        size_t idx = item.find('=');
+        int value;
+        if (idx == std::string::npos || !str2Num(item.substr(idx + 1), value))
+            throw ChessParseError("Invalid formula item: " + item);
+        std::string key = item.substr(0, idx);
+        if (key == "moves")
+            f.maxRemainingMoves = std::max(value, 1);
+        else if (key == "buffer")
+            f.bufferTime = value;
+        else if (key == "min")
+            f.minTimeUsage = value;
+        else if (key == "max")
+            f.maxTimeUsage = value;
+        else if (key == "hard")
+            f.useHardFactor = value != 0;
+        else
+            throw ChessParseError("Invalid formula key: " + key);
+    }
+    return f;
+}
+
+void
+TimeReplay::computeLimits(const Formula& f, const TimeLog::Entry& e,
+                          int& minTimeLimit, int& maxTimeLimit) {
+    int moves = e.movesToGo;
+    if (moves == 0)
+        moves = 999;
+    moves = std::min(moves, f.maxRemainingMoves);
+    const int time = e.timeLeft;
+    const int margin = std::min(f.bufferTime, time * 9 / 10);
+    minTimeLimit = (time + e.increment * (moves - 1) - margin) / moves;
+    maxTimeLimit = (int)(minTimeLimit * clamp(moves * 0.5, 2.0, f.maxTimeUsage * 0.01));
+    minTimeLimit = clamp(minTimeLimit, 1, time - margin);
+    maxTimeLimit = clamp(maxTimeLimit, 1, time - margin);
+}
+
+S64
+TimeReplay::replayEntry(const Formula& f, const TimeLog::Entry& e,
+                        int& lastIter, bool& censored) {
+    using Iteration = TimeLog::Iteration;
+    int minT, maxT;
+    computeLimits(f, e, minT, maxT);
+    lastIter = -1;
+    censored = false;
+    double hardFactor = 1.0;
+    for (int i = 0; i < (int)e.iterations.size(); i++) {
+        const Iteration& it = e.iterations[i];
+        if (i > 0) {
+            // Search stops at the next root move when the time limit is exceeded
+            S64 limit = (it.flags & Iteration::FAIL_LOW) ? maxT : minT;
+            if (it.timeMillis > limit)
+                return std::max(limit, e.iterations[i-1].timeMillis);
+        }
+        lastIter = i;
+        if (it.flags & Iteration::INCOMPLETE) {
+            censored = true;
+            return it.timeMillis;
+        }
+        if (f.useHardFactor) {
+            if (it.flags & Iteration::FAIL_LOW)
+                hardFactor = std::max(hardFactor, 2.0);
+            if (it.flags & Iteration::FAIL_HIGH)
+                hardFactor = std::max(hardFactor, 1.0);
+            hardFactor = (hardFactor + Search::nodeFractionHardFactor(it.bestMoveNodes * 1e-3)) / 2;
+        }
+        if ((it.timeMillis > minT * 0.01 * f.minTimeUsage * hardFactor) ||
+            (it.timeMillis >= maxT))
+            return it.timeMillis;
+    }
+    censored = true;
+    return e.timeUsed;
+}
+
+void
+TimeReplay::addEntry(Result& res, const TimeLog::Entry& e, S64 timeUsed,
+                     int lastIter, bool censored) {
+    res.nMoves++;
+    res.timeUsed += timeUsed;
+    if (censored)
+        res.nCensored++;
+    if (lastIter < 0)
+        return;
+    const auto& iters = e.iterations;
+    res.depthSum += iters[lastIter].depth;
+    if (iters[lastIter].flags & TimeLog::Iteration::INCOMPLETE)
+        res.depthSum--;
+    const U16 move = iters[lastIter].bestMove;
+    if (move != iters.back().bestMove)
+        res.nChanged++;
+    int stable = lastIter;
+    while ((stable > 0) && (iters[stable-1].bestMove == move))
+        stable--;
+    res.wastedTime += std::max(timeUsed - iters[stable].timeMillis, (S64)0);
+}
+
+TimeReplay::Result
+TimeReplay::replay(const Formula& f, const std::vector<TimeLog::Entry>& entries) {
+    Result res;
+    res.name = f.name;
+    for (const TimeLog::Entry& e : entries) {
+        int lastIter;
+        bool censored;
+        S64 t = replayEntry(f, e, lastIter, censored);
+        addEntry(res, e, t, lastIter, censored);
+    }
+    return res;
+}
+
+TimeReplay::Result
+TimeReplay::logged(const std::vector<TimeLog::Entry>& entries) {
+    Result res;
+    res.name = "logged";
+    for (const TimeLog::Entry& e : entries)
+        addEntry(res, e, e.timeUsed, (int)e.iterations.size() - 1, false);
+    return res;
+}
+
+void
+TimeReplay::printResults(const std::vector<Result>& results, std::ostream& os) {
+    if (results.empty())
+        return;
+    const Result& base = results[0];
+    auto ratio = [](double a, double b) { return b != 0 ? a / b : 0.0; };
+    os << "   moves    time_s  time% avg_ms  depth changed wasted% censored  formula" << std::endl;
+    for (const Result& r : results) {
+        os << std::setw(8) << r.nMoves
+           << ' ' << std::setw(9) << std::fixed << std::setprecision(1) << r.timeUsed * 1e-3
+           << ' ' << std::setw(6) << ratio(r.timeUsed, base.timeUsed) * 100
+           << ' ' << std::setw(6) << (S64)ratio(r.timeUsed, r.nMoves)
+           << ' ' << std::setw(6) << std::setprecision(2) << ratio(r.depthSum, r.nMoves)
+           << ' ' << std::setw(7) << r.nChanged
+           << ' ' << std::setw(7) << std::setprecision(1) << ratio(r.wastedTime, r.timeUsed) * 100
+           << ' ' << std::setw(8) << r.nCensored
+           << "  " << r.name << std::endl;
+    }
+}
@@ -0,0 +1,102 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * timereplay.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef TIMEREPLAY_HPP_
+#define TIMEREPLAY_HPP_
+
+#include "timeLog.hpp"
+
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+/**
+ * Replay a time log against alternative time allocation formulas.
+ *
+ * For each logged move, the time limits are recomputed from the logged clock
+ * information, and the search stop rules are applied to the logged iteration
+ * data to determine when the search would have stopped and which move it
+ * would have played. The simulation is approximate. Time used within an
+ * aborted iteration is not known, and a search that would have continued past
+ * the end of the logged search is cut at the logged time ("censored").
+ */
+class TimeReplay {
+public:
+    /** Parameters defining a time allocation formula. The default values
+     *  correspond to the formula currently used by the engine. Pondering is
+     *  not modeled. */
+    struct Formula {
+        Formula();
+
+        /** Create from a string like "min=70,max=300,moves=35,buffer=1000,hard=1". */
+        static Formula parse(const std::string& spec);
+
+        std::string name;
+        int maxRemainingMoves;   // Assume at most this many moves until end of game
+        int bufferTime;          // Time to keep on the clock, in milliseconds
+        int minTimeUsage;        // Can stop after this percentage of the minimum time limit
+        int maxTimeUsage;        // Maximum time limit, in percent of the minimum time limit
+        bool useHardFactor;      // Adjust stop time depending on search difficulty
+    };
+
+    /** Replay result for one formula, summed over all log entries. */
+    struct Result {
+        std::string name;
+        int nMoves = 0;
+        S64 timeUsed = 0;        // Total thinking time
+        S64 depthSum = 0;        // Sum of depths of last completed iterations
+        int nChanged = 0;        // Number of moves different from the logged played move
+        S64 wastedTime = 0;      // Time used after the played move became stable
+        int nCensored = 0;       // Number of searches cut at the logged search time
+    };
+
+    /** Compute time limits for a formula and the clock information in a log entry. */
+    static void computeLimits(const Formula& f, const TimeLog::Entry& e,
+                              int& minTimeLimit, int& maxTimeLimit);
+
+    /** Replay one log entry.
+     * @param lastIter   Set to the index of the iteration providing the played move.
+     * @param censored   Set to true if the search would have used more time
+     *                   than the logged search.
+     * @return Time used by the simulated search. */
+    static S64 replayEntry(const Formula& f, const TimeLog::Entry& e,
+                           int& lastIter, bool& censored);
+
+    /** Replay all log entries for a formula. */
+    static Result replay(const Formula& f, const std::vector<TimeLog::Entry>& entries);
+
+    /** Return the result corresponding to what actually happened when the log was created. */
+    static Result logged(const std::vector<TimeLog::Entry>& entries);
+
+    /** Print results as a table. Time is also given relative to the first result. */
+    static void printResults(const std::vector<Result>& results, std::ostream& os);
+
+private:
+    /** Add result for one entry to a Result object. */
+    static void addEntry(Result& res, const TimeLog::Entry& e, S64 timeUsed,
+                         int lastIter, bool censored);
+};
+
+#endif /* TIMEREPLAY_HPP_ */
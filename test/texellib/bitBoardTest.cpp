@@ -26,6 +26,7 @@
 #include "bitBoardTest.hpp"
 #include "bitBoard.hpp"
 #include "textio.hpp"
+#include "util/random.hpp"
 
 #include <algorithm>
 
@@ -376,11 +377,52 @@ BitBoardTest::testMaskAndMirror() {
     }
 }
 
+/** Compute slider attacks by following rays until the board edge or an occupied square. */
+static U64 sliderAttacksSlow(int sq, U64 occupied, bool rook) {
+    static const int rookDirs[4][2] = { {1,0}, {-1,0}, {0,1}, {0,-1} };
+    static const int bishopDirs[4][2] = { {1,1}, {-1,1}, {1,-1}, {-1,-1} };
+    U64 ret = 0;
+    for (int d = 0; d < 4; d++) {
+        const int dx = rook ? rookDirs[d][0] : bishopDirs[d][0];
+        const int dy = rook ? rookDirs[d][1] : bishopDirs[d][1];
+        int x = Square::getX(sq) + dx;
+        int y = Square::getY(sq) + dy;
+        while ((x >= 0) && (x < 8) && (y >= 0) && (y < 8)) {
+            U64 m = 1ULL << Square::getSquare(x, y);
+            ret |= m;
+            if (occupied & m)
+                break;
+            x += dx;
+            y += dy;
+        }
+    }
+    return ret;
+}
+
 void
 BitBoardTest::testSliders() {
     Position pos = TextIO::readFEN("4k3/8/8/8/8/8/8/R3K3 w Q - 0 1");
     ASSERT_EQUAL(BitBoard::sqMask(B1,C1,D1,E1,A2,A3,A4,A5,A6,A7,A8),
                  BitBoard::rookAttacks(A1, pos.occupiedBB()));
+
+    // Test all occupancy patterns on the rays for all squares, with random
+    // squares outside the rays also occupied
+    Random rnd(13);
+    for (int sq = 0; sq < 64; sq++) {
+        for (int rook = 0; rook < 2; rook++) {
+            const U64 rays = sliderAttacksSlow(sq, 0, rook);
+            U64 occ = 0;
+            do {
+                U64 occupied = occ | (rnd.nextU64() & ~rays);
+                U64 expected = sliderAttacksSlow(sq, occupied, rook);
+                U64 atks = rook ? BitBoard::rookAttacks(sq, occupied)
+                                : BitBoard::bishopAttacks(sq, occupied);
+                if (atks != expected)
+                    ASSERT_EQUAL(expected, atks);
+                occ = (occ - rays) & rays;
+            } while (occ != 0);
+        }
+    }
 }
 
 cute::suite
@@ -29,6 +29,9 @@
 #include "position.hpp"
 #include "textio.hpp"
 #include "parameters.hpp"
+#include "testUtil.hpp"
+
+#include <algorithm>
 
 #include "cute.h"
 
@@ -1462,6 +1465,257 @@ EvaluateTest::testContactChecks() {
     ASSERT_EQUAL(0, getNContactChecks("r1b1qr2/pp2npp1/1b2p2k/nP1pP1NP/6Q1/2P5/P4PP1/RNB1K2R b KQ - 2 14"));
 }
 
+void
+EvaluateTest::testHashTableSize() {
+    auto et = Evaluate::getEvalHashTables();
+    ASSERT_EQUAL(1 << 16, et->pawnHash.size());
+    ASSERT_EQUAL(1 << 15, et->kingSafetyHash.size());
+    ASSERT_EQUAL(1 << 16, et->evalHash.size());
+
+    Parameters& pars = Parameters::instance();
+    pars.set("PawnHashEntries", "1000");
+    pars.set("EvalHashEntries", "1");
+    et->updateSize();
+    ASSERT_EQUAL(512, et->pawnHash.size());
+    ASSERT_EQUAL(1 << 15, et->kingSafetyHash.size());
+    ASSERT_EQUAL(1, et->evalHash.size());
+
+    Evaluate eval(*et);
+    Position pos = TextIO::readFEN(TextIO::startPosFEN);
+    ASSERT_EQUAL(evalWhite(pos), eval.evalPos(pos));
+    ASSERT_EQUAL(evalWhite(pos), eval.evalPos(pos));
+
+    pars.set("PawnHashEntries", num2Str(1 << 16));
+    pars.set("EvalHashEntries", num2Str(1 << 16));
+    et->updateSize();
+    ASSERT_EQUAL(1 << 16, et->pawnHash.size());
+    ASSERT_EQUAL(1 << 16, et->evalHash.size());
+}
+
+void
+EvaluateTest::testLazyEval() {
+    auto et = Evaluate::getEvalHashTables();
+    Evaluate eval(*et);
+    auto etLazy = Evaluate::getEvalHashTables();
+    Evaluate evalLazy(*etLazy);
+    const int windows[] = { -2000, -800, -400, -100, -1, 0, 1, 100, 400, 800, 2000 };
+    int nBound = 0, nWrong = 0;
+    randomGames(10, 80, 4711, [&](const Position& pos, const Move& m) {
+        const int score = eval.evalPos(pos);
+        for (int w : windows) {
+            const int alpha = score + w - 10;
+            const int beta = score + w + 10;
+            int lazyScore = evalLazy.evalPos(pos, alpha, beta);
+            if (lazyScore <= alpha) {
+                if (score > alpha)
+                    nWrong++;
+            } else if (lazyScore >= beta) {
+                if (score < beta)
+                    nWrong++;
+            } else {
+                ASSERT_EQUAL(score, lazyScore);
+            }
+            if (lazyScore != score)
+                nBound++;
+        }
+        // Bounds must not be stored in the eval hash table
+        ASSERT_EQUAL(score, evalLazy.evalPos(pos));
+    });
+    ASSERT(nBound > 0);
+    // The margin is not a strict bound, but it must be exceeded only rarely
+    ASSERT(nWrong * 100 <= nBound);
+}
+
+void
+EvaluateTest::testEvalBatch() {
+    std::vector<Position::SerializeData> data;
+    randomGames(10, 60, 17, [&data](const Position& pos, const Move& m) {
+        Position::SerializeData d;
+        pos.serialize(d);
+        data.push_back(d);
+    });
+    const int n = data.size();
+
+    std::vector<int> order;
+    Evaluate::batchOrder(&data[0], n, order);
+    ASSERT_EQUAL(n, order.size());
+    std::vector<int> sorted(order);
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = 0; i < n; i++)
+        ASSERT_EQUAL(i, sorted[i]);
+    for (int i = 1; i < n; i++) { // Same pawn structure must be adjacent
+        Position p0, p1;
+        p0.deSerialize(data[order[i-1]]);
+        p1.deSerialize(data[order[i]]);
+        if (p0.pawnZobristHash() != p1.pawnZobristHash()) {
+            for (int j = i + 1; j < n; j++) {
+                Position p2;
+                p2.deSerialize(data[order[j]]);
+                ASSERT(p2.pawnZobristHash() != p0.pawnZobristHash());
+            }
+        }
+    }
+
+    auto et = Evaluate::getEvalHashTables();
+    Evaluate eval(*et);
+    std::vector<int> scores(n);
+    eval.evalBatch(&data[0], n, &scores[0]);
+    for (int i = 0; i < n; i++) {
+        Position pos;
+        pos.deSerialize(data[i]);
+        ASSERT_EQUAL(evalWhite(pos), scores[i]);
+    }
+
+    et->clear();
+    eval.evalBatch(&data[0], n, &scores[0]);
+    for (int i = 0; i < n; i++) {
+        Position pos;
+        pos.deSerialize(data[i]);
+        ASSERT_EQUAL(evalWhite(pos), scores[i]);
+    }
+}
+
+void
+EvaluateTest::testSharedEvalHash() {
+    SharedEvalHash::Tables tables(4, 4);
+    ASSERT_EQUAL(4, tables.pawnSize());
+    ASSERT_EQUAL(4, tables.kingSafetySize());
+    U64 data[SharedEvalHash::nPawnData] = { 1, 2, 3, 4, 5 };
+    U64 data2[SharedEvalHash::nPawnData];
+    ASSERT(!tables.probePawn(17, data2));
+    tables.storePawn(17, data);
+    ASSERT(tables.probePawn(17, data2));
+    for (int i = 0; i < SharedEvalHash::nPawnData; i++)
+        ASSERT_EQUAL(data[i], data2[i]);
+    ASSERT(!tables.probePawn(21, data2));
+    int ks;
+    ASSERT(!tables.probeKingSafety(17, ks));
+    tables.storeKingSafety(17, -123);
+    ASSERT(tables.probeKingSafety(17, ks));
+    ASSERT_EQUAL(-123, ks);
+    tables.clear();
+    ASSERT(!tables.probePawn(17, data2));
+    ASSERT(!tables.probeKingSafety(17, ks));
+
+    auto et0 = Evaluate::getEvalHashTables();
+    Evaluate eval0(*et0);
+
+    Parameters& pars = Parameters::instance();
+    pars.set("SharedEvalHash", "true");
+    pars.set("PawnHashEntries", "2");
+    pars.set("KingSafetyHashEntries", "2");
+    pars.set("EvalHashEntries", "1");
+    SharedEvalHash::instance().reset();
+    auto et1 = Evaluate::getEvalHashTables();
+    auto et2 = Evaluate::getEvalHashTables();
+    ASSERT(et1->shared);
+    ASSERT_EQUAL(et1->shared, et2->shared);
+    Evaluate eval1(*et1);
+    Evaluate eval2(*et2);
+
+    randomGames(10, 80, 11, [&](const Position& pos, const Move& m) {
+        int score = eval0.evalPos(pos);
+        ASSERT_EQUAL(score, eval1.evalPos(pos));
+        ASSERT_EQUAL(score, eval2.evalPos(pos)); // Uses data stored by eval1
+        ASSERT_EQUAL(score, eval1.evalPos(pos));
+    });
+
+    // Tables in use stay valid after reset. updateSize() selects new tables.
+    Position pos0 = TextIO::readFEN("r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3");
+    int score = eval0.evalPos(pos0);
+    pars.set("SharedPawnHashEntries", "8");
+    SharedEvalHash::instance().reset();
+    SharedEvalHash::instance().clear();
+    ASSERT_EQUAL(score, eval1.evalPos(pos0));
+    et1->updateSize();
+    ASSERT(et1->shared);
+    ASSERT(et1->shared != et2->shared);
+    ASSERT_EQUAL(8, et1->shared->pawnSize());
+    ASSERT_EQUAL(score, Evaluate(*et1).evalPos(pos0));
+
+    // Per-thread tables are limited in size when shared tables are used
+    pars.set("PawnHashEntries", num2Str(1 << 16));
+    et1->updateSize();
+    ASSERT_EQUAL(1 << 12, et1->pawnHash.size());
+    ASSERT_EQUAL(2, et1->kingSafetyHash.size());
+
+    pars.set("SharedEvalHash", "false");
+    pars.set("SharedPawnHashEntries", num2Str(1 << 20));
+    pars.set("PawnHashEntries", num2Str(1 << 16));
+    pars.set("KingSafetyHashEntries", num2Str(1 << 15));
+    pars.set("EvalHashEntries", num2Str(1 << 16));
+    SharedEvalHash::instance().reset();
+    auto et3 = Evaluate::getEvalHashTables();
+    ASSERT(!et3->shared);
+    ASSERT_EQUAL(1 << 16, et3->pawnHash.size());
+}
+
+void
+EvaluateTest::testMaterialTable() {
+    for (int mId : { 0, (int)MatId::WP * 8 + MatId::BP * 8 + MatId::WQ + MatId::BQ +
+                        (MatId::WR + MatId::BR + MatId::WN + MatId::BN +
+                         MatId::WB + MatId::BB) * 2 }) {
+        int idx = Evaluate::materialTableIndex(mId);
+        ASSERT(idx >= 0);
+        ASSERT(idx < Evaluate::nMaterialSide * Evaluate::nMaterialSide);
+    }
+    ASSERT_EQUAL(-1, Evaluate::materialTableIndex(MatId::WQ * 2));
+    ASSERT_EQUAL(-1, Evaluate::materialTableIndex(MatId::BN * 3 + MatId::BP * 5));
+    ASSERT_EQUAL(-1, Evaluate::materialTableIndex(MatId::WR * 3 + MatId::BB));
+
+    // Table lookups must give the same result as computing the material score
+    auto et = Evaluate::getEvalHashTables();
+    Evaluate eval(*et);
+    std::vector<std::string> fens = {
+        TextIO::startPosFEN,
+        "4k3/8/8/8/8/8/8/4K3 w - - 0 1",
+        "r1bqk2r/pp3ppp/8/8/8/8/PPP2PPP/RN1QKBNR w KQkq - 0 1",
+        "4k3/8/8/3Q4/8/8/8/Q3K3 w - - 0 1",     // Two queens, not in table
+        "4k3/2nnn3/8/8/8/8/8/4K3 b - - 0 1",    // Three knights, not in table
+        "4k3/pppppppp/8/8/8/8/PPPPPPPP/1QQQK3 w - - 0 1",
+    };
+    for (const std::string& fen : fens) {
+        randomGames(1, 100, 4711, [&eval](const Position& pos, const Move& m) {
+            Evaluate::MaterialHashData mhd;
+            Evaluate::computeMaterialScore(pos, mhd, false);
+            ASSERT_EQUAL(mhd.score, eval.materialScore(pos, false));
+            const Evaluate::MaterialHashData& t = *eval.mhd;
+            ASSERT_EQUAL(mhd.id, t.id);
+            ASSERT_EQUAL(mhd.endGame, t.endGame);
+            ASSERT_EQUAL(mhd.pawnIPF, t.pawnIPF);
+            ASSERT_EQUAL(mhd.knightIPF, t.knightIPF);
+            ASSERT_EQUAL(mhd.castleIPF, t.castleIPF);
+            ASSERT_EQUAL(mhd.queenIPF, t.queenIPF);
+            ASSERT_EQUAL(mhd.wPassedPawnIPF, t.wPassedPawnIPF);
+            ASSERT_EQUAL(mhd.bPassedPawnIPF, t.bPassedPawnIPF);
+            ASSERT_EQUAL(mhd.kingSafetyIPF, t.kingSafetyIPF);
+            ASSERT_EQUAL(mhd.diffColorBishopIPF, t.diffColorBishopIPF);
+            ASSERT_EQUAL(mhd.knightOutPostIPF, t.knightOutPostIPF);
+            ASSERT_EQUAL(Evaluate::materialTableIndex(pos.materialId()) >= 0,
+                         eval.mhd != &eval.extraMaterial);
+        }, fen);
+    }
+
+    // Evaluate objects share the table until a parameter changes. Objects
+    // created before the change keep using their own table.
+    Position pos = TextIO::readFEN(TextIO::startPosFEN);
+    const int score = eval.evalPos(pos);
+    {
+        Evaluate eval2(*et);
+        ASSERT_EQUAL(eval.materialTable, eval2.materialTable);
+    }
+    Evaluate::updateEvalParams();
+    Evaluate eval2(*et);
+    ASSERT(eval.materialTable != eval2.materialTable);
+    Evaluate::updateEvalParams();
+    Evaluate eval3(*et);
+    ASSERT(eval2.materialTable != eval3.materialTable);
+    ASSERT_EQUAL(score, eval.evalPos(pos));
+    ASSERT_EQUAL(score, eval2.evalPos(pos));
+    ASSERT_EQUAL(score, eval3.evalPos(pos));
+    ASSERT_EQUAL(eval.materialTable, eval.mhd - Evaluate::materialTableIndex(pos.materialId()));
+}
+
 cute::suite
 EvaluateTest::getSuite() const {
     cute::suite s;
@@ -1496,5 +1750,10 @@ EvaluateTest::getSuite() const {
     s.push_back(CUTE(testSwindleScore));
     s.push_back(CUTE(testStalePawns));
     s.push_back(CUTE(testContactChecks));
+    s.push_back(CUTE(testHashTableSize));
+    s.push_back(CUTE(testLazyEval));
+    s.push_back(CUTE(testEvalBatch));
+    s.push_back(CUTE(testSharedEvalHash));
+    s.push_back(CUTE(testMaterialTable));
     return s;
 }
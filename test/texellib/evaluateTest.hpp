@@ -67,6 +67,11 @@ private:
     static void testStalePawns();
     static int getNContactChecks(const std::string& fen);
     static void testContactChecks();
+    static void testHashTableSize();
+    static void testLazyEval();
+    static void testEvalBatch();
+    static void testSharedEvalHash();
+    static void testMaterialTable();
 };
 
 class Position;
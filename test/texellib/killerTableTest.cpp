@@ -73,6 +73,12 @@ testGetKillerScore() {
     kt.addKiller(2, m2);
     ASSERT_EQUAL(4, kt.getKillerScore(2, m2));
     ASSERT_EQUAL(3, kt.getKillerScore(0, m2));
+
+    ASSERT(kt.getKiller(0, 0) == m3);
+    ASSERT(kt.getKiller(0, 1) == m2);
+    ASSERT(kt.getKiller(2, 0) == m2);
+    ASSERT(kt.getKiller(2, 1).isEmpty());
+    ASSERT(kt.getKiller(1, 0).isEmpty());
 }
 
 
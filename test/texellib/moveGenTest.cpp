@@ -88,10 +88,74 @@ getCheckEvasions(Position& pos, bool onlyLegal) {
     return strMoves;
 }
 
+/** Check that isPseudoLegal() accepts exactly the moves in the pseudo-legal move list. */
+static void
+checkPseudoLegal(const Position& pos, const MoveList& moves) {
+    std::vector<Move> pseudoLegal;
+    for (int mi = 0; mi < moves.size; mi++)
+        pseudoLegal.push_back(moves[mi]);
+    const bool wtm = pos.isWhiteMove();
+    const int promotions[] = { Piece::EMPTY,
+                               wtm ? Piece::WQUEEN : Piece::BQUEEN,
+                               wtm ? Piece::WROOK : Piece::BROOK,
+                               wtm ? Piece::WBISHOP : Piece::BBISHOP,
+                               wtm ? Piece::WKNIGHT : Piece::BKNIGHT,
+                               wtm ? Piece::BQUEEN : Piece::WQUEEN,
+                               wtm ? Piece::WPAWN : Piece::BPAWN };
+    for (int from = 0; from < 64; from++) {
+        for (int to = 0; to < 64; to++) {
+            for (int prom : promotions) {
+                Move m(from, to, prom);
+                ASSERT_EQUAL(contains(pseudoLegal, m), MoveGen::isPseudoLegal(pos, m));
+            }
+        }
+    }
+}
+
+/** Check that legalMoves() generates the legal subset of the pseudo-legal moves, in the same order. */
+static void
+checkLegalMoves(const Position& pos, const MoveList& moves) {
+    MoveList pseudoLegal(moves);
+    Position tmpPos(pos);
+    MoveGen::removeIllegal(tmpPos, pseudoLegal);
+    MoveList legal;
+    MoveGen::legalMoves(pos, legal);
+    ASSERT_EQUAL(pseudoLegal.size, legal.size);
+    for (int mi = 0; mi < legal.size; mi++)
+        ASSERT_EQUAL(pseudoLegal[mi], legal[mi]);
+}
+
+/** Check that the AttackInfo versions of inCheck, isLegal and givesCheck
+ *  agree with the versions that do not use cached information. */
+static void
+checkAttackInfo(const Position& pos, const MoveList& moves) {
+    Position tmpPos(pos);
+    AttackInfo ai;
+    const bool inCheck = MoveGen::inCheck(tmpPos);
+    ASSERT_EQUAL(inCheck, MoveGen::inCheck(tmpPos, ai));
+    UndoInfo ui;
+    for (int mi = 0; mi < moves.size; mi++) {
+        const Move& m = moves[mi];
+        bool legal = MoveGen::isLegal(tmpPos, m, inCheck);
+        ASSERT_EQUAL(legal, MoveGen::isLegal(tmpPos, m, ai));
+        if (!legal)
+            continue;
+        bool givesCheck = MoveGen::givesCheck(tmpPos, m, ai);
+        ASSERT_EQUAL(MoveGen::givesCheck(tmpPos, m), givesCheck);
+        tmpPos.makeMove(m, ui);
+        ASSERT_EQUAL(MoveGen::inCheck(tmpPos), givesCheck);
+        tmpPos.unMakeMove(m, ui);
+    }
+}
+
 static std::vector<std::string>
 getMoveList0(Position& pos, bool onlyLegal) {
     MoveList moves;
     MoveGen::pseudoLegalMoves(pos, moves);
+    if (!onlyLegal)
+        checkPseudoLegal(pos, moves);
+    checkLegalMoves(pos, moves);
+    checkAttackInfo(pos, moves);
     if (onlyLegal)
         removeIllegal(pos, moves);
     std::vector<std::string> strMoves;
@@ -514,6 +578,48 @@ testCheckEvasions() {
     ASSERT(contains(evList, "b7c6"));
 }
 
+/** Check legalMoves() for all positions reachable in "depth" plies from pos. */
+static void
+checkLegalMovesTree(Position& pos, int depth) {
+    MoveList moves;
+    MoveGen::pseudoLegalMoves(pos, moves);
+    checkLegalMoves(pos, moves);
+    checkAttackInfo(pos, moves);
+    if (depth <= 0)
+        return;
+    moves.clear();
+    MoveGen::legalMoves(pos, moves);
+    UndoInfo ui;
+    for (int mi = 0; mi < moves.size; mi++) {
+        pos.makeMove(moves[mi], ui);
+        checkLegalMovesTree(pos, depth - 1);
+        pos.unMakeMove(moves[mi], ui);
+    }
+}
+
+static void
+testLegalMoves() {
+    std::vector<std::string> fens = {
+        TextIO::startPosFEN,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "8/8/8/KPp4r/8/8/8/4k3 w - c6 0 2",      // En passant exposes king
+        "8/8/8/1k6/2Pp4/8/8/3KQ3 b - c3 0 1",     // En passant captures checking pawn
+        "4k3/8/8/2KPp2r/8/8/8/8 w - e6 0 2",      // Pinned pawn, en passant
+        "4k3/8/4r3/8/8/8/3PPN2/r3K2R w K - 0 1",  // Pinned pieces, castling
+        "4k3/8/8/8/1b6/8/3N4/R3K1r1 w Q - 0 1",   // Pinned knight, check
+        "4k3/8/8/8/1b6/8/8/R3K1r1 w Q - 0 1",     // Double check
+    };
+    for (const std::string& fen : fens) {
+        Position pos = TextIO::readFEN(fen);
+        checkLegalMovesTree(pos, 2);
+        pos = swapColors(pos);
+        checkLegalMovesTree(pos, 2);
+    }
+}
+
 
 cute::suite
 MoveGenTest::getSuite() const {
@@ -525,5 +631,6 @@ MoveGenTest::getSuite() const {
     s.push_back(CUTE(testRemoveIllegal));
     s.push_back(CUTE(testCaptureList));
     s.push_back(CUTE(testCheckEvasions));
+    s.push_back(CUTE(testLegalMoves));
     return s;
 }
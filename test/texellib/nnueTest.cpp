@@ -0,0 +1,198 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * nnueTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "nnueTest.hpp"
+#include "nnue.hpp"
+#include "position.hpp"
+#include "moveGen.hpp"
+#include "textio.hpp"
+#include "testUtil.hpp"
+
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+#include "cute.h"
+
+static bool
+accEqual(const NNUE::Accumulator& a1, const NNUE::Accumulator& a2) {
+    return memcmp(a1.acc, a2.acc, sizeof(a1.acc)) == 0;
+}
+
+static void
+setRandomNetwork() {
+    std::string errMsg;
+    ASSERT(NNUE::setNetwork(NNUE::randomNetwork(17), errMsg));
+    ASSERT(NNUE::hasNetwork());
+}
+
+static void
+testLoadNetwork() {
+    const std::string fileName = "nnueTest.tmp";
+    std::vector<U8> data = NNUE::randomNetwork(1);
+    {
+        std::ofstream os(fileName, std::ios::binary);
+        os.write((const char*)data.data(), data.size());
+    }
+    std::string errMsg;
+    ASSERT(NNUE::loadNetwork(fileName, errMsg));
+    ASSERT(NNUE::hasNetwork());
+    U32 id = NNUE::currentNetId();
+    ASSERT(id != 0);
+
+    Position pos = TextIO::readFEN(TextIO::startPosFEN);
+    NNUE::Accumulator acc1, acc2;
+    NNUE::refresh(pos, acc1);
+    ASSERT_EQUAL(id, acc1.netId);
+    int score1 = NNUE::evaluate(acc1, true);
+
+    ASSERT(NNUE::setNetwork(data, errMsg));
+    ASSERT(NNUE::currentNetId() != id);
+    NNUE::refresh(pos, acc2);
+    ASSERT(accEqual(acc1, acc2));
+    ASSERT_EQUAL(score1, NNUE::evaluate(acc2, true));
+
+    // Truncated file
+    {
+        std::ofstream os(fileName, std::ios::binary);
+        os.write((const char*)data.data(), data.size() - 1);
+    }
+    ASSERT(!NNUE::loadNetwork(fileName, errMsg));
+    ASSERT(!errMsg.empty());
+    ASSERT(!NNUE::hasNetwork());
+    std::remove(fileName.c_str());
+
+    errMsg.clear();
+    ASSERT(!NNUE::loadNetwork(fileName, errMsg));
+    ASSERT(!errMsg.empty());
+    ASSERT(NNUE::loadNetwork("", errMsg));
+    ASSERT(!NNUE::hasNetwork());
+    ASSERT(!NNUE::isActive());
+}
+
+static void
+testIncremental() {
+    setRandomNetwork();
+    randomGames(10, 100, 4711, [](const Position& pos, const Move& m) {
+        NNUE::Accumulator acc0, acc;
+        NNUE::refresh(pos, acc0);
+        int p = pos.getPiece(m.from());
+
+        acc = acc0;
+        NNUE::removePiece(acc, p, m.from());
+        ASSERT(!accEqual(acc, acc0));
+        NNUE::addPiece(acc, p, m.from());
+        ASSERT(accEqual(acc, acc0));
+
+        if (pos.getPiece(m.to()) == Piece::EMPTY) {
+            acc = acc0;
+            NNUE::movePiece(acc, p, m.from(), m.to());
+            Position pos2(pos);
+            pos2.setPiece(m.from(), Piece::EMPTY);
+            pos2.setPiece(m.to(), p);
+            NNUE::Accumulator acc2;
+            NNUE::refresh(pos2, acc2);
+            ASSERT(accEqual(acc, acc2));
+        }
+    });
+
+    // AccumulatorStack updates from the closest computed parent accumulator
+    for (int g = 0; g < 10; g++) {
+        NNUE::AccumulatorStack stack;
+        bool pushed = false;
+        randomGames(1, 100, 11 + g, [&stack,&pushed](const Position& pos0, const Move& m) {
+            if (pushed)
+                stack.setKey(pos0.zobristHash());
+            NNUE::Accumulator acc0;
+            NNUE::refresh(pos0, acc0);
+            ASSERT(accEqual(stack.get(pos0), acc0));
+
+            Position pos(pos0);
+            MoveList moves;
+            MoveGen::pseudoLegalMoves(pos, moves);
+            MoveGen::removeIllegal(pos, moves);
+            UndoInfo ui;
+            for (int mi = 0; mi < moves.size; mi++) {
+                stack.push(pos, moves[mi]);
+                pos.makeMove(moves[mi], ui);
+                stack.setKey(pos.zobristHash());
+                if (mi % 2 == 0) {
+                    NNUE::Accumulator acc1;
+                    NNUE::refresh(pos, acc1);
+                    ASSERT(accEqual(stack.get(pos), acc1));
+                }
+                pos.unMakeMove(moves[mi], ui);
+                stack.pop();
+                ASSERT(accEqual(stack.get(pos), acc0));
+            }
+
+            stack.push(pos0, m);
+            pushed = true;
+        });
+    }
+
+    std::string errMsg;
+    NNUE::loadNetwork("", errMsg);
+}
+
+static void
+testEvaluate() {
+    setRandomNetwork();
+    int nDiff = 0;
+    randomGames(10, 100, 4711, [&nDiff](const Position& pos, const Move& m) {
+        NNUE::Accumulator acc;
+        NNUE::refresh(pos, acc);
+        const bool wtm = pos.isWhiteMove();
+        int score = NNUE::evaluate(acc, wtm);
+        ASSERT_EQUAL(NNUE::evaluateScalar(acc, wtm), score);
+        if (score != NNUE::evaluate(acc, !wtm))
+            nDiff++;
+
+        // Color flipped position must have the same score
+        Position sym;
+        for (int sq = 0; sq < 64; sq++) {
+            int p = pos.getPiece(sq);
+            if (p != Piece::EMPTY)
+                p = Piece::isWhite(p) ? Piece::makeBlack(p) : Piece::makeWhite(p);
+            sym.setPiece(Square::mirrorY(sq), p);
+        }
+        NNUE::Accumulator symAcc;
+        NNUE::refresh(sym, symAcc);
+        ASSERT_EQUAL(score, NNUE::evaluate(symAcc, !wtm));
+    });
+    ASSERT(nDiff > 0);
+
+    std::string errMsg;
+    NNUE::loadNetwork("", errMsg);
+}
+
+cute::suite
+NNUETest::getSuite() const {
+    cute::suite s;
+    s.push_back(CUTE(testLoadNetwork));
+    s.push_back(CUTE(testIncremental));
+    s.push_back(CUTE(testEvaluate));
+    return s;
+}
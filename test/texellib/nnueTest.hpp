@@ -0,0 +1,38 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * nnueTest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef NNUETEST_HPP_
+#define NNUETEST_HPP_
+
+#include "suiteBase.hpp"
+
+class NNUETest : public SuiteBase {
+public:
+    std::string getName() const override { return "NNUETest"; }
+
+    cute::suite getSuite() const override;
+};
+
+#endif /* NNUETEST_HPP_ */
@@ -229,7 +229,11 @@ ParallelTest::testCommunicator() {
     ASSERT_EQUAL(0, child2.getTbHits());
     ASSERT_EQUAL(0, child3.getTbHits());
 
-    child3.sendReportStats(100, 10, true);
+    const S64 statsFactor = SearchStats::enabled ? 1 : 0;
+    SearchStats stats3;
+    stats3.add(SearchStats::NODES, 7);
+    stats3.addDepth(SearchStats::TT_HITS, 3);
+    child3.sendReportStats(100, 10, stats3, true);
     ASSERT_EQUAL(0, root.getNumSearchedNodes());
     ASSERT_EQUAL(100, child2.getNumSearchedNodes());
     ASSERT_EQUAL(0, child3.getNumSearchedNodes());
@@ -249,7 +253,15 @@ ParallelTest::testCommunicator() {
     ASSERT_EQUAL(3, getCount(c2, 3));
     ASSERT_EQUAL(2, getCount(c3, 2));
 
-    child2.sendReportStats(200, 30, true);
+    ASSERT_EQUAL(7 * statsFactor, child2.getSearchStats().get(SearchStats::NODES));
+    ASSERT_EQUAL(0, root.getSearchStats().get(SearchStats::NODES));
+
+    SearchStats stats2;
+    stats2.add(SearchStats::NODES, 5);
+    child2.sendReportStats(200, 30, stats2, true);
+    ASSERT_EQUAL(12 * statsFactor, root.getSearchStats().get(SearchStats::NODES));
+    ASSERT_EQUAL(1 * statsFactor, root.getSearchStats().getDepth(SearchStats::TT_HITS, 3));
+    ASSERT_EQUAL(0, child2.getSearchStats().get(SearchStats::NODES));
     ASSERT_EQUAL(300, root.getNumSearchedNodes());
     ASSERT_EQUAL(0, child3.getNumSearchedNodes());
     ASSERT_EQUAL(0, child2.getNumSearchedNodes());
@@ -83,6 +83,18 @@ testSetPiece() {
     ASSERT_EQUAL(Piece::EMPTY, instance.getPiece(Square::getSquare(0, 0)));
     instance.setPiece(Square::getSquare(3, 4), Piece::WKING);
     ASSERT_EQUAL(Piece::WKING, instance.getPiece(Square::getSquare(3, 4)));
+
+    for (int sq = 0; sq < 64; sq++) {
+        for (int p = 0; p < Piece::nPieceTypes; p++) {
+            instance.setPiece(sq, p);
+            ASSERT_EQUAL(p, instance.getPiece(sq));
+            ASSERT_EQUAL(p != Piece::EMPTY, (instance.occupiedBB() & (1ULL << sq)) != 0);
+        }
+        instance.setPiece(sq, Piece::EMPTY);
+    }
+#ifdef COMPACT_POSITION
+    ASSERT(sizeof(Position) <= 5 * 64);
+#endif
 }
 
 static void
@@ -460,6 +460,97 @@ SearchTest::testSEE() {
     ASSERT_EQUAL(h1, h2);
 }
 
+/** Check that batch SEE computation of a move list matches signSEE for each move. */
+void
+SearchTest::testSEEBatch() {
+    std::vector<std::string> fens = {
+        "r2qk2r/ppp2ppp/1bnp1nb1/1N2p3/3PP3/1PP2N2/1P3PPP/R1BQRBK1 w kq - 0 1",
+        "r2qk2r/ppp2ppp/1bnp4/1N2p1b1/3PP1n1/1PP2N2/1P3PPP/R1BQRBK1 b kq - 0 1",
+        "Q7/q6k/R7/r7/P7/8/4K3/8 b - - 0 1",
+        "8/3k4/5R2/8/4pP2/8/8/3K4 b - f3 0 1",
+        "1r1q1rk1/pP3ppp/2n1bn2/3pp3/1b1PP3/2NB1N2/PPPBQPPP/R3K2R w KQ - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "4k3/8/8/2rRr3/3P4/2B1Q3/8/4K3 b - - 0 1",
+        "k7/4P3/8/8/8/8/7K/4r3 w - - 0 1",
+        "4R3/7k/8/8/8/8/4p3/K7 b - - 0 1",
+    };
+    for (const std::string& fen : fens) {
+        Position pos = TextIO::readFEN(fen);
+        Search sc(pos, nullHist, 0, st, comm, treeLog);
+        MoveList moves;
+        MoveGen::pseudoLegalMoves(pos, moves);
+        int signs[MoveList::MAX_MOVES];
+        Search::signSEE(pos, moves, 0, signs);
+        for (int i = 0; i < moves.size; i++) {
+            const Move& m = moves[i];
+            bool isCapture = (pos.getPiece(m.to()) != Piece::EMPTY) ||
+                             (m.promoteTo() != Piece::EMPTY);
+            int expected = 0;
+            if (isCapture) {
+                int see = getSEE(sc, m);
+                expected = (see > 0) ? 1 : (see < 0) ? -1 : 0;
+            }
+            ASSERT_EQUAL(expected, signs[i]);
+        }
+    }
+
+    // Promotion push with a rook behind the pawn
+    Position pos = TextIO::readFEN("k7/4P3/8/8/8/8/7K/4r3 w - - 0 1");
+    Search sc(pos, nullHist, 0, st, comm, treeLog);
+    Move m = TextIO::stringToMove(pos, "e7e8q");
+    ASSERT(getSEE(sc, m) < 0);
+    MoveList moves;
+    moves.addMove(m.from(), m.to(), m.promoteTo());
+    int signs[MoveList::MAX_MOVES];
+    Search::signSEE(pos, moves, 0, signs);
+    ASSERT_EQUAL(-1, signs[0]);
+}
+
+void
+SearchTest::testQuiesceBatch() {
+    std::vector<std::string> fens = {
+        TextIO::startPosFEN,
+        "r2qk2r/ppp2ppp/1bnp1nb1/1N2p3/3PP3/1PP2N2/1P3PPP/R1BQRBK1 w kq - 0 1",
+        "r2qk2r/ppp2ppp/1bnp4/1N2p1b1/3PP1n1/1PP2N2/1P3PPP/R1BQRBK1 b kq - 0 1",
+        "r2qk2r/ppp2ppp/1bnp4/1N2p1b1/3PP1n1/1PP2N2/1P3PPP/R1BQRBK1 w kq - 0 1",
+        "1r1q1rk1/pP3ppp/2n1bn2/3pp3/1b1PP3/2NB1N2/PPPBQPPP/R3K2R w KQ - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "4k3/8/8/2rRr3/3P4/2B1Q3/8/4K3 b - - 0 1",
+        "rnbqkbnr/ppp2ppp/8/3pp2Q/4P3/8/PPPP1PPP/RNB1KBNR b KQkq - 0 1",
+    };
+    const int n = fens.size();
+    std::vector<Position::SerializeData> data(n);
+    for (int i = 0; i < n; i++)
+        TextIO::readFEN(fens[i]).serialize(data[i]);
+
+    Position pos = TextIO::readFEN(TextIO::startPosFEN);
+    Search sc(pos, nullHist, 0, st, comm, treeLog);
+    std::vector<int> scores(n);
+    sc.quiesceBatch(&data[0], n, &scores[0]);
+    ASSERT(sc.eval.getUseEvalHash());
+
+    // The eval hash setting is restored after the batch
+    std::vector<int> scores2(n);
+    sc.eval.setUseEvalHash(false);
+    sc.quiesceBatch(&data[0], n, &scores2[0]);
+    ASSERT(!sc.eval.getUseEvalHash());
+    ASSERT(scores == scores2);
+
+    const int mate0 = SearchConst::MATE0;
+    for (int i = 0; i < n; i++) {
+        Position pos = TextIO::readFEN(fens[i]);
+        Search sc2(pos, nullHist, 0, st, comm, treeLog);
+        sc2.q0Eval = SearchConst::UNKNOWN_SCORE;
+        int score = sc2.quiesce(-mate0, mate0, 0, 0, MoveGen::inCheck(pos));
+        if (!pos.isWhiteMove())
+            score = -score;
+        ASSERT_EQUAL(score, scores[i]);
+    }
+}
+
 void
 SearchTest::testScoreMoveList() {
     Position pos = TextIO::readFEN("r2qk2r/ppp2ppp/1bnp1nb1/1N2p3/3PP3/1PP2N2/1P3PPP/R1BQRBK1 w kq - 0 1");
@@ -502,6 +593,96 @@ SearchTest::testScoreMoveList() {
     ASSERT_EQUAL(m, moves[0]);
 }
 
+void
+SearchTest::testMovePicker() {
+    Position pos = TextIO::readFEN("r2qk2r/ppp2ppp/1bnp1nb1/1N2p3/3PP3/1PP2N2/1P3PPP/R1BQRBK1 w kq - 0 1");
+    Search sc(pos, nullHist, 0, st, comm, treeLog);
+    const int ply = 1;
+    kt.clear();
+    Move killer = TextIO::stringToMove(pos, "h3");
+    kt.addKiller(ply, TextIO::stringToMove(pos, "Kh1")); // Not pseudo-legal
+    kt.addKiller(ply, killer);
+    kt.addKiller(ply + 1, TextIO::stringToMove(pos, "a4"));
+    Move hashMove = TextIO::stringToMove(pos, "Ra6");
+
+    MoveList allMoves;
+    MoveGen::pseudoLegalMoves(pos, allMoves);
+    std::vector<Move> expected;
+    for (int i = 0; i < allMoves.size; i++)
+        expected.push_back(allMoves[i]);
+
+    MoveList moves;
+    Search::MovePicker picker(sc, moves, hashMove, ply, false);
+    ASSERT(picker.hashMoveSelected());
+    std::vector<Move> returned;
+    int stage = -1; // 0 = hash move, 1 = good captures, 2 = killer, 3 = other moves, 4 = losing captures
+    for (int mi = 0; picker.next(mi, true); mi++) {
+        const Move& m = moves[mi];
+        ASSERT(!contains(returned, m));
+        returned.push_back(m);
+        bool capture = pos.getPiece(m.to()) != Piece::EMPTY;
+        int s;
+        if (mi == 0) {
+            ASSERT_EQUAL(hashMove, m);
+            s = 0;
+        } else if (m == killer) {
+            s = 2;
+        } else if (capture) {
+            s = sc.signSEE(m) >= 0 ? 1 : 4;
+        } else {
+            s = 3;
+        }
+        ASSERT(s >= stage);
+        if (s == stage && s != 2)
+            ASSERT(m.score() <= moves[mi-1].score());
+        stage = s;
+    }
+    ASSERT_EQUAL(4, stage);
+    ASSERT_EQUAL(expected.size(), returned.size());
+    for (const Move& m : expected)
+        ASSERT(contains(returned, m));
+    ASSERT_EQUAL((int)returned.size(), moves.size);
+
+    // Hash move that is not pseudo-legal
+    Search::MovePicker picker2(sc, moves, TextIO::uciStringToMove("a1a8"), ply, false);
+    ASSERT(!picker2.hashMoveSelected());
+    int n = 0;
+    while (picker2.next(n, false))
+        n++;
+    ASSERT_EQUAL((int)expected.size(), n);
+
+    // Check evasions
+    pos = TextIO::readFEN("rnbqk1nr/pppp1ppp/8/4p3/1b1P4/8/PPP1PPPP/RNBQKBNR w KQkq - 1 3");
+    sc.init(pos, nullHist, 0);
+    allMoves.clear();
+    MoveGen::legalMoves(pos, allMoves);
+    hashMove = TextIO::stringToMove(pos, "c3");
+    Search::MovePicker picker3(sc, moves, hashMove, ply, true);
+    ASSERT(picker3.hashMoveSelected());
+    n = 0;
+    while (picker3.next(n, true)) {
+        if (n == 0)
+            ASSERT_EQUAL(hashMove, moves[0]);
+        n++;
+    }
+    ASSERT_EQUAL(allMoves.size, n);
+
+    // Quiescence search moves, ordered by MVV/LVA
+    pos = TextIO::readFEN("r2qk2r/ppp2ppp/1bnp1nb1/1N2p3/3PP3/1PP2N2/1P3PPP/R1BQRBK1 w kq - 0 1");
+    sc.init(pos, nullHist, 0);
+    allMoves.clear();
+    MoveGen::pseudoLegalCaptures(pos, allMoves);
+    Search::MovePicker picker4(sc, moves, false, false);
+    n = 0;
+    while (picker4.next(n, true)) {
+        if (n > 0)
+            ASSERT(moves[n].score() <= moves[n-1].score());
+        n++;
+    }
+    ASSERT_EQUAL(allMoves.size, n);
+    kt.clear();
+}
+
 void
 SearchTest::testTBSearch() {
     const int mate0 = SearchConst::MATE0;
@@ -564,7 +745,10 @@ SearchTest::getSuite() const {
     s.push_back(CUTE(testStalemateTrap));
     s.push_back(CUTE(testKQKRNullMove));
     s.push_back(CUTE(testSEE));
+    s.push_back(CUTE(testSEEBatch));
+    s.push_back(CUTE(testQuiesceBatch));
     s.push_back(CUTE(testScoreMoveList));
+    s.push_back(CUTE(testMovePicker));
     s.push_back(CUTE(testTBSearch));
     s.push_back(CUTE(testFortress));
     return s;
@@ -58,7 +58,10 @@ private:
     static void testKQKRNullMove();
     static int getSEE(Search& sc, const Move& m);
     static void testSEE();
+    static void testSEEBatch();
+    static void testQuiesceBatch();
     static void testScoreMoveList();
+    static void testMovePicker();
     static void testTBSearch();
     static void testFortress();
 };
@@ -31,6 +31,7 @@
 #include "evaluate.hpp"
 #include "textio.hpp"
 #include "tbprobe.hpp"
+#include "tbStats.hpp"
 #include "constants.hpp"
 
 #include "syzygy/rtb-probe.hpp"
@@ -655,6 +656,56 @@ TBTest::testMaxSubMate() {
     ASSERT_EQUAL(TBProbe::getMaxDTZ(MI::WQ), maxSub);
 }
 
+void
+TBTest::testTBStats() {
+    using MI = MatId;
+    ASSERT_EQUAL("KvK", TBStats::materialName(0));
+    ASSERT_EQUAL("KQvK", TBStats::materialName(MI::WQ));
+    ASSERT_EQUAL("KRPvKR", TBStats::materialName(MI::WR + MI::WP + MI::BR));
+    ASSERT_EQUAL("KBNvKPP", TBStats::materialName(MI::WB + MI::WN + 2 * MI::BP));
+    ASSERT_EQUAL("KQQQvKRRNN", TBStats::materialName(3 * MI::WQ + 2 * MI::BR + 2 * MI::BN));
+
+    ASSERT_EQUAL(0, TBStats::latencyBucket(0));
+    ASSERT_EQUAL(0, TBStats::latencyBucket(0.9e-6));
+    ASSERT_EQUAL(1, TBStats::latencyBucket(1.5e-6));
+    ASSERT_EQUAL(2, TBStats::latencyBucket(2e-6));
+    ASSERT_EQUAL(11, TBStats::latencyBucket(1.5e-3));
+    ASSERT_EQUAL(TBStats::N_BUCKETS - 1, TBStats::latencyBucket(10));
+
+    TBStats::clear();
+    const int krk = MI::WR;
+    const int kqkr = MI::WQ + MI::BR;
+    TBStats::addProbe(TBStats::RTB_WDL, krk, true, 0.5e-6);
+    TBStats::addProbe(TBStats::RTB_WDL, krk, false, 3e-6);
+    TBStats::addProbe(TBStats::RTB_WDL, kqkr, true, 3e-6);
+    TBStats::addProbe(TBStats::GTB_DTM, kqkr, true, 1e-3);
+    ASSERT_EQUAL(3, TBStats::getProbes(TBStats::RTB_WDL));
+    ASSERT_EQUAL(2, TBStats::getHits(TBStats::RTB_WDL));
+    ASSERT_EQUAL(1, TBStats::getLatencyCount(TBStats::RTB_WDL, 0));
+    ASSERT_EQUAL(2, TBStats::getLatencyCount(TBStats::RTB_WDL, 2));
+    ASSERT_EQUAL(1, TBStats::getLatencyCount(TBStats::GTB_DTM, 10));
+    ASSERT_EQUAL(2, TBStats::getProbes(TBStats::RTB_WDL, krk));
+    ASSERT_EQUAL(1, TBStats::getHits(TBStats::RTB_WDL, krk));
+    ASSERT_EQUAL(1, TBStats::getProbes(TBStats::RTB_WDL, kqkr));
+    ASSERT_EQUAL(1, TBStats::getProbes(TBStats::GTB_DTM, kqkr));
+    ASSERT_EQUAL(0, TBStats::getProbes(TBStats::GTB_DTM, krk));
+    ASSERT_EQUAL(0, TBStats::getProbes(TBStats::RTB_DTZ, MI::WP));
+
+    // Probes made by the search are only counted if statistics are enabled
+    initTB(gtbDefaultPath, gtbDefaultCacheMB, rtbDefaultPath);
+    TBStats::clear();
+    ASSERT_EQUAL(0, TBStats::getProbes(TBStats::RTB_WDL, krk));
+    Position pos = TextIO::readFEN("8/8/8/8/8/2k5/8/1R2K3 w - - 0 1");
+    TranspositionTable& tt = SearchTest::tt;
+    TranspositionTable::TTEntry ent;
+    TBProbe::tbProbe(pos, 0, -SearchConst::MATE0, SearchConst::MATE0, tt, ent);
+    if (TBStats::enabled)
+        ASSERT_EQUAL(1, TBStats::getProbes(TBStats::ON_DEMAND, krk));
+    else
+        ASSERT_EQUAL(0, TBStats::getProbes(TBStats::ON_DEMAND, krk));
+    TBStats::clear();
+}
+
 cute::suite
 TBTest::getSuite() const {
     cute::suite s;
@@ -664,5 +715,6 @@ TBTest::getSuite() const {
     s.push_back(CUTE(tbTest));
     s.push_back(CUTE(testMissingTables));
     s.push_back(CUTE(testMaxSubMate));
+    s.push_back(CUTE(testTBStats));
     return s;
 }
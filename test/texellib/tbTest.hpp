@@ -53,6 +53,7 @@ private:
     static void tbTest();
     static void testMissingTables();
     static void testMaxSubMate();
+    static void testTBStats();
 };
 
 #endif /* TBTEST_HPP_ */
@@ -0,0 +1,59 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * testUtil.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef TESTUTIL_HPP_
+#define TESTUTIL_HPP_
+
+#include "position.hpp"
+#include "moveGen.hpp"
+#include "textio.hpp"
+#include "util/random.hpp"
+
+/** Play nGames games of random legal moves, starting from the position given
+ *  by fen. Each game ends after maxLen moves or when there are no legal moves.
+ *  func(pos, m) is called for each position reached, before random move m is
+ *  made. The same seed gives the same games. */
+template <typename Func>
+void
+randomGames(int nGames, int maxLen, U64 seed, Func func,
+            const std::string& fen = TextIO::startPosFEN) {
+    Random rnd(seed);
+    for (int g = 0; g < nGames; g++) {
+        Position pos = TextIO::readFEN(fen);
+        for (int i = 0; i < maxLen; i++) {
+            MoveList moves;
+            MoveGen::pseudoLegalMoves(pos, moves);
+            MoveGen::removeIllegal(pos, moves);
+            if (moves.size == 0)
+                break;
+            const Move& m = moves[rnd.nextInt(moves.size)];
+            func(pos, m);
+            UndoInfo ui;
+            pos.makeMove(m, ui);
+        }
+    }
+}
+
+#endif /* TESTUTIL_HPP_ */
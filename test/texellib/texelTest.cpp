@@ -29,6 +29,7 @@
 #include "killerTableTest.hpp"
 #include "moveGenTest.hpp"
 #include "moveTest.hpp"
+#include "nnueTest.hpp"
 #include "pieceTest.hpp"
 #include "positionTest.hpp"
 #include "searchTest.hpp"
@@ -71,6 +72,7 @@ int main(int argc, char* argv[]) {
     runSuite(KillerTableTest(), suiteNames);
     runSuite(MoveGenTest(), suiteNames);
     runSuite(MoveTest(), suiteNames);
+    runSuite(NNUETest(), suiteNames);
     runSuite(PieceTest(), suiteNames);
     runSuite(PositionTest(), suiteNames);
     runSuite(SearchTest(), suiteNames);
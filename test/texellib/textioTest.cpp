@@ -25,6 +25,7 @@
 
 #include "textioTest.hpp"
 #include "textio.hpp"
+#include "moveGen.hpp"
 
 #include "cute.h"
 
@@ -121,6 +122,20 @@ testReadFEN() {
 
     pos = TextIO::readFEN("rnbqkbnr/pp1ppppp/8/8/2pPP3/3P4/PP3PPP/RNBQKBNR b KQkq d3 0 1");
     ASSERT(pos == TextIO::readFEN("rnbqkbnr/pp1ppppp/8/8/2pPP3/3P4/PP3PPP/RNBQKBNR b KQkq - 0 1"));
+
+    // Test buffer based functions. The input does not have to be null terminated.
+    fen = "8/3k4/8/5pP1/1P6/1NB5/2QP4/R3K2R w KQ f6 12 345";
+    std::string buf = fen + " extra";
+    Position pos2;
+    TextIO::readFEN(buf.data(), fen.length(), pos2);
+    ASSERT(pos2 == TextIO::readFEN(fen));
+    char fenBuf[TextIO::MAX_FEN_LEN];
+    int len = TextIO::toFEN(pos2, fenBuf);
+    ASSERT_EQUAL((int)fen.length(), len);
+    ASSERT_EQUAL(fen, std::string(fenBuf));
+    pos2.setHalfMoveClock(-3);
+    ASSERT_EQUAL(TextIO::toFEN(pos2), std::string(fenBuf, TextIO::toFEN(pos2, fenBuf)));
+    ASSERT_EQUAL(std::string("8/3k4/8/5pP1/1P6/1NB5/2QP4/R3K2R w KQ f6 -3 345"), std::string(fenBuf));
 }
 
 static void
@@ -336,6 +351,55 @@ testStringToMove() {
     ASSERT_EQUAL(mNf3, TextIO::stringToMove(pos, "Nf"));
 }
 
+/** Check that all legal moves in a position can be parsed from short SAN,
+ *  long algebraic and UCI notation. */
+static void
+testStringToMoveAll() {
+    std::vector<std::string> fens = {
+        TextIO::startPosFEN,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        "1Q6/1K2q2k/1QQ5/8/7P/8/8/8 w - - 3 88",
+        "rnbqkbnr/ppp2ppp/8/2Ppp3/8/8/PP1PPPPP/RNBQKBNR w KQkq d6 0 1",
+        "4k3/8/8/8/1b6/8/3N4/4K2N w - - 0 1",
+        "4k3/1P6/8/8/8/8/6p1/4K2R b K - 0 1",
+    };
+    for (const std::string& fen : fens) {
+        Position pos = TextIO::readFEN(fen);
+        MoveList moves;
+        MoveGen::legalMoves(pos, moves);
+        for (int i = 0; i < moves.size; i++) {
+            const Move& m = moves[i];
+            std::string sShort = TextIO::moveToString(pos, m, false);
+            std::string sLong = TextIO::moveToString(pos, m, true);
+            std::string sUci = TextIO::moveToUCIString(m);
+            ASSERT_EQUAL(m, TextIO::stringToMove(pos, sShort));
+            ASSERT_EQUAL(m, TextIO::stringToMove(pos, sLong));
+            if (Piece::makeWhite(m.promoteTo()) != Piece::WBISHOP) // 'b' is parsed as a file
+                ASSERT_EQUAL(m, TextIO::stringToMove(pos, sUci));
+            ASSERT_EQUAL(fen, TextIO::toFEN(pos));
+        }
+    }
+
+    // Pinned piece is not a candidate, so no disambiguation is needed
+    Position pos = TextIO::readFEN("4k3/8/8/8/1b6/8/3N4/4K2N w - - 0 1");
+    ASSERT_EQUAL(Move(TextIO::getSquare("h1"), TextIO::getSquare("f2"), Piece::EMPTY),
+                 TextIO::stringToMove(pos, "Nf2"));
+    ASSERT_EQUAL(Move(TextIO::getSquare("h1"), TextIO::getSquare("f2"), Piece::EMPTY),
+                 TextIO::stringToMove(pos, "Nhf2"));
+    ASSERT(TextIO::stringToMove(pos, "Ndf3").isEmpty());
+
+    // Promotion piece must be specified
+    pos = TextIO::readFEN("4k3/1P6/8/8/8/8/8/4K3 w - - 0 1");
+    ASSERT(TextIO::stringToMove(pos, "b8").isEmpty());
+    ASSERT_EQUAL(Move(TextIO::getSquare("b7"), TextIO::getSquare("b8"), Piece::WKNIGHT),
+                 TextIO::stringToMove(pos, "b8=N"));
+    ASSERT(TextIO::stringToMove(pos, "b8=K").isEmpty());
+}
+
 static void
 testGetSquare() {
     ASSERT_EQUAL(Square::getSquare(0, 0), TextIO::getSquare("a1"));
@@ -422,6 +486,7 @@ TextIOTest::getSuite() const {
     s.push_back(CUTE(testMoveToStringMate));
     s.push_back(CUTE(testMoveToStringShortForm));
     s.push_back(CUTE(testStringToMove));
+    s.push_back(CUTE(testStringToMoveAll));
     s.push_back(CUTE(testGetSquare));
     s.push_back(CUTE(testSquareToString));
     s.push_back(CUTE(testAsciiBoard));
@@ -27,7 +27,9 @@
 #include "treeLogger.hpp"
 #include "position.hpp"
 #include "textio.hpp"
+#include "transpositionTable.hpp"
 #include <iostream>
+#include <sstream>
 #include <cstring>
 
 #include "cute.h"
@@ -167,10 +169,76 @@ TreeLoggerTest::testLoggerData() {
     }
 }
 
+void
+TreeLoggerTest::testLoggerStats() {
+    Position pos = TextIO::readFEN(TextIO::startPosFEN);
+    Move e4 = TextIO::stringToMove(pos, "e4");
+    Move d4 = TextIO::stringToMove(pos, "d4");
+    Move nf3 = TextIO::stringToMove(pos, "Nf3");
+    Move nullMove;
+    nullMove.setMove(A1, A1, 0, 0);
+
+    TreeLoggerStats log;
+    log.open("", 0);
+    ASSERT(log.isOpened());
+    U64 root = log.logPosition(pos);
+
+    // Iteration 1
+    U64 n = log.logNodeStart(root, e4, -100, 100, 1, 0);
+    log.logNodeEnd(n, 10, TType::T_EXACT, 10, 0);
+    n = log.logNodeStart(root, d4, 10, 11, 1, 0);
+    log.logNodeEnd(n, 5, TType::T_LE, 5, 0);
+
+    // Iteration 2
+    U64 r1 = log.logNodeStart(root, e4, -100, 100, 1, 1);
+    n = log.logNodeStart(r1, nullMove, -101, -100, 2, 0);   // Null move, not a real move
+    log.logNodeEnd(n, -90, TType::T_GE, -90, 0);
+    n = log.logNodeStart(r1, e4, -100, 100, 2, 0);
+    log.logNodeEnd(n, 20, TType::T_GE, 20, 0);              // No move cut
+    U64 c = log.logNodeStart(r1, d4, -100, -99, 2, 0);      // Reduced search
+    n = log.logNodeStart(c, nf3, 99, 100, 3, 0);
+    log.logNodeEnd(n, 101, TType::T_GE, 101, 0);
+    log.logNodeEnd(c, -99, TType::T_GE, 0, 0);              // First move cut
+    n = log.logNodeStart(r1, d4, -100, -99, 2, 1);          // Depth re-search
+    log.logNodeEnd(n, -99, TType::T_GE, 0, 0);              // No move cut
+    n = log.logNodeStart(r1, d4, -100, 100, 2, 1);          // Window re-search
+    log.logNodeEnd(n, -50, TType::T_EXACT, 0, 0);
+    log.logNodeEnd(r1, 50, TType::T_EXACT, 0, 0);
+    n = log.logNodeStart(root, d4, 50, 51, 1, 0);           // Reduced root move
+    log.logNodeEnd(n, 20, TType::T_LE, 0, 0);
+    log.close();
+    ASSERT(!log.isOpened());
+
+    ASSERT_EQUAL(10, log.getNodes());
+    ASSERT_EQUAL(4, log.getNodesByPly(1));
+    ASSERT_EQUAL(5, log.getNodesByPly(2));
+    ASSERT_EQUAL(1, log.getNodesByPly(3));
+    ASSERT_EQUAL(7, log.getNodesByDepth(0));
+    ASSERT_EQUAL(3, log.getNodesByDepth(1));
+
+    const auto& iters = log.getIterations();
+    ASSERT_EQUAL(2, iters.size());
+    ASSERT_EQUAL(1, iters[0].depth);
+    ASSERT_EQUAL(2, iters[0].nodes);
+    ASSERT_EQUAL(2, iters[1].depth);
+    ASSERT_EQUAL(8, iters[1].nodes);
+
+    ASSERT_EQUAL(5, log.getCutNodes());
+    ASSERT_EQUAL(4, log.getNoMoveCuts());
+    ASSERT_EQUAL(1, log.getFirstMoveCuts());
+    ASSERT_EQUAL(2, log.getReSearches());
+    ASSERT_EQUAL(1, log.getDepthReSearches());
+
+    std::stringstream ss;
+    log.printSummary(ss);
+    ASSERT(ss.str().find("iter 2 nodes 8 ebf 4.00") != std::string::npos);
+}
+
 cute::suite
 TreeLoggerTest::getSuite() const {
     cute::suite s;
     s.push_back(CUTE(testSerialize));
     s.push_back(CUTE(testLoggerData));
+    s.push_back(CUTE(testLoggerStats));
     return s;
 }
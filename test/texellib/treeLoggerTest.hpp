@@ -37,6 +37,7 @@ public:
 private:
     static void testSerialize();
     static void testLoggerData();
+    static void testLoggerStats();
 };
 
 #endif /* TREELOGGERTEST_HPP_ */
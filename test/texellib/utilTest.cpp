@@ -27,6 +27,8 @@
 #include "util/util.hpp"
 #include "util/timeUtil.hpp"
 #include "util/histogram.hpp"
+#include "util/cpuInfo.hpp"
+#include "bitBoard.hpp"
 
 #include <iostream>
 #include <memory>
@@ -186,6 +188,30 @@ UtilTest::testFloorLog2() {
     }
 }
 
+void
+UtilTest::testCpuInfo() {
+    const CpuInfo& ci = CpuInfo::instance();
+    ASSERT(!ci.hasFastPext() || ci.hasBmi2());
+    ASSERT(!ci.hasAvx512() || ci.hasAvx2());
+    ASSERT_EQUAL("", ci.missingFeatures());
+
+    std::string features = ci.featureString();
+    ASSERT(!features.empty());
+    ASSERT_EQUAL(std::string::npos, features.find(' '));
+    ASSERT_EQUAL(ci.hasPopcnt(), features.find("POPCNT") != std::string::npos);
+    ASSERT_EQUAL(ci.hasBmi2(), features.find("BMI2") != std::string::npos);
+    ASSERT_EQUAL(ci.hasAvx2(), features.find("AVX2") != std::string::npos);
+
+    if (BitBoard::pextAttacks())
+        ASSERT(ci.hasBmi2());
+    if (BitBoard::popcntBitCount())
+        ASSERT(ci.hasPopcnt());
+#ifdef HAS_CPU_DISPATCH
+    ASSERT_EQUAL(ci.hasFastPext(), BitBoard::pextAttacks());
+    ASSERT_EQUAL(ci.hasPopcnt(), BitBoard::popcntBitCount());
+#endif
+}
+
 cute::suite
 UtilTest::getSuite() const {
     cute::suite s;
@@ -194,5 +220,6 @@ UtilTest::getSuite() const {
     s.push_back(CUTE(testTime));
     s.push_back(CUTE(testHistogram));
     s.push_back(CUTE(testFloorLog2));
+    s.push_back(CUTE(testCpuInfo));
     return s;
 }
@@ -40,6 +40,7 @@ private:
     static void testTime();
     static void testHistogram();
     static void testFloorLog2();
+    static void testCpuInfo();
 };
 
 
@@ -0,0 +1,122 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * benchCmpTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "benchCmpTest.hpp"
+#include "benchcmp.hpp"
+
+#include "cute.h"
+
+#include <sstream>
+
+void
+BenchCmpTest::testParseOutput() {
+    std::string output =
+        "Position  1/42 bestmove e2e4 nodes 12345\n"
+        "===========================\n"
+        "Engine     : Texel 1.08\n"
+        "Build      : USE_BMI2=ON USE_POPCNT=ON CPU_TYPE=corei7\n"
+        "Hash (MB)  : 16\n"
+        "Threads    : 1\n"
+        "Depth      : 12\n"
+        "Total time : 2500 ms\n"
+        "Nodes      : 5000000\n"
+        "Nodes/sec  : 2000000\n"
+        "Signature  : 5000000\n";
+    std::istringstream is(output);
+    BenchCmp::RunResult r;
+    ASSERT(BenchCmp::parseBenchOutput(is, r));
+    ASSERT_EQUAL(5000000, r.nodes);
+    ASSERT_EQUAL(2500, r.timeMillis);
+    ASSERT_EQUAL(2000000, r.nps);
+    ASSERT_EQUAL(3, r.build.size());
+    ASSERT_EQUAL("USE_BMI2", r.build[0].first);
+    ASSERT_EQUAL("ON", r.build[0].second);
+    ASSERT_EQUAL("CPU_TYPE", r.build[2].first);
+    ASSERT_EQUAL("corei7", r.build[2].second);
+
+    std::istringstream is2("info string Usage: bench [hashMB [threads [depth]]]\n");
+    BenchCmp::RunResult r2;
+    ASSERT(!BenchCmp::parseBenchOutput(is2, r2));
+
+    BenchCmp::Engine e;
+    e.command = "./texel";
+    e.options.push_back(std::make_pair("Threads", "2"));
+    std::vector<std::string> cmds = BenchCmp::uciCommands(e, 16, 1, 10);
+    ASSERT_EQUAL(std::vector<std::string>({"setoption name Threads value 2", "isready",
+                                           "bench 16 1 10", "quit"}), cmds);
+
+    std::ostringstream json;
+    BenchCmp::writeJsonRun(json, "A", e, 3, r);
+    ASSERT_EQUAL("{\"type\":\"run\",\"engine\":\"A\",\"command\":\"./texel\","
+                 "\"options\":{\"Threads\":\"2\"},\"build\":{\"USE_BMI2\":\"ON\","
+                 "\"USE_POPCNT\":\"ON\",\"CPU_TYPE\":\"corei7\"},\"pair\":3,"
+                 "\"nodes\":5000000,\"timeMs\":2500,\"nps\":2000000}\n", json.str());
+}
+
+void
+BenchCmpTest::testCompare() {
+    ASSERT_EQUAL_DELTA(12.706, BenchCmp::tQuantile975(1), 1e-9);
+    ASSERT_EQUAL_DELTA(2.042, BenchCmp::tQuantile975(30), 1e-9);
+    ASSERT_EQUAL_DELTA(2.000, BenchCmp::tQuantile975(60), 0.003);
+    ASSERT_EQUAL_DELTA(1.980, BenchCmp::tQuantile975(120), 0.003);
+
+    // B consistently 2% slower, with noise
+    std::vector<double> a = { 1000, 1010,  990, 1005,  995 };
+    std::vector<double> b = {  980,  990,  970,  985,  975 };
+    BenchCmp::Comparison c = BenchCmp::compare(a, b, 0);
+    ASSERT_EQUAL(5, c.nPairs);
+    ASSERT_EQUAL_DELTA(1000, c.npsA, 1e-9);
+    ASSERT_EQUAL_DELTA(980, c.npsB, 1e-9);
+    ASSERT(c.diff < -1.9 && c.diff > -2.1);
+    ASSERT(c.ciLow < c.diff && c.ciHigh > c.diff);
+    ASSERT(c.ciHigh < 0);
+    ASSERT(c.slowdown);
+    ASSERT(!BenchCmp::compare(a, b, 5).slowdown);
+    ASSERT(!BenchCmp::compare(b, a, 0).slowdown);
+
+    // Large noise, no significant difference
+    std::vector<double> b2 = { 1100,  900, 1050,  950, 1000 };
+    BenchCmp::Comparison c2 = BenchCmp::compare(a, b2, 0);
+    ASSERT(c2.ciLow < 0 && c2.ciHigh > 0);
+    ASSERT(!c2.slowdown);
+
+    // One pair is not enough to compute a confidence interval
+    BenchCmp::Comparison c3 = BenchCmp::compare({1000}, {500}, 0);
+    ASSERT_EQUAL(1, c3.nPairs);
+    ASSERT(!c3.slowdown);
+
+    std::ostringstream json;
+    BenchCmp::writeJsonSummary(json, c3);
+    ASSERT(json.str().find("\"ciLowPct\":null") != std::string::npos);
+    ASSERT(json.str().find("\"slowdown\":false") != std::string::npos);
+}
+
+cute::suite
+BenchCmpTest::getSuite() const {
+    cute::suite s;
+    s.push_back(CUTE(testParseOutput));
+    s.push_back(CUTE(testCompare));
+    return s;
+}
@@ -0,0 +1,83 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * perftTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "perftTest.hpp"
+#include "perft.hpp"
+#include "textio.hpp"
+
+#include "cute.h"
+
+void
+PerfTTest::testPerfT() {
+    struct Data {
+        std::string fen;
+        std::vector<U64> nodes;
+    };
+    std::vector<Data> data = {
+        { TextIO::startPosFEN, { 20, 400, 8902, 197281 } },
+        { "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq -",
+          { 48, 2039, 97862 } },
+        { "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - -", { 14, 191, 2812, 43238 } },
+    };
+    for (int nThreads = 1; nThreads <= 3; nThreads += 2) {
+        for (int hashMB = 0; hashMB <= 1; hashMB++) {
+            PerfT perfT(nThreads, hashMB);
+            for (const Data& d : data) {
+                Position pos = TextIO::readFEN(d.fen);
+                std::vector<PerfT::MoveCount> divide;
+                for (int depth = 1; depth <= (int)d.nodes.size(); depth++)
+                    ASSERT_EQUAL(d.nodes[depth-1], perfT.perfT(pos, depth, divide));
+            }
+        }
+    }
+}
+
+void
+PerfTTest::testDivide() {
+    Position pos = TextIO::readFEN(TextIO::startPosFEN);
+    PerfT perfT(2, 1);
+    std::vector<PerfT::MoveCount> divide;
+    U64 nodes = perfT.perfT(pos, 3, divide);
+    ASSERT_EQUAL(8902, nodes);
+    ASSERT_EQUAL(20, divide.size());
+    U64 sum = 0;
+    for (const PerfT::MoveCount& mc : divide) {
+        sum += mc.nodes;
+        std::string s = TextIO::moveToUCIString(mc.move);
+        if (s == "e2e4")
+            ASSERT_EQUAL(600, mc.nodes);
+        else if (s == "g1f3")
+            ASSERT_EQUAL(440, mc.nodes);
+    }
+    ASSERT_EQUAL(nodes, sum);
+}
+
+cute::suite
+PerfTTest::getSuite() const {
+    cute::suite s;
+    s.push_back(CUTE(testPerfT));
+    s.push_back(CUTE(testDivide));
+    return s;
+}
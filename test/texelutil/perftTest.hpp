@@ -0,0 +1,40 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * perftTest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef PERFTTEST_HPP_
+#define PERFTTEST_HPP_
+
+#include "utilSuiteBase.hpp"
+
+class PerfTTest : public UtilSuiteBase {
+    std::string getName() const override { return "PerfTTest"; }
+
+    cute::suite getSuite() const override;
+private:
+    static void testPerfT();
+    static void testDivide();
+};
+
+#endif /* PERFTTEST_HPP_ */
@@ -0,0 +1,107 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * smpbenchTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "smpbenchTest.hpp"
+#include "smpbench.hpp"
+#include "parameters.hpp"
+
+#include "cute.h"
+
+#include <sstream>
+
+void
+SmpBenchTest::testThreadCounts() {
+    ASSERT_EQUAL(std::vector<int>({1}), SmpBench::threadCounts(1));
+    ASSERT_EQUAL(std::vector<int>({1, 2}), SmpBench::threadCounts(2));
+    ASSERT_EQUAL(std::vector<int>({1, 2, 3}), SmpBench::threadCounts(3));
+    ASSERT_EQUAL(std::vector<int>({1, 2, 4, 8}), SmpBench::threadCounts(8));
+    ASSERT_EQUAL(std::vector<int>({1, 2, 4, 8, 12}), SmpBench::threadCounts(12));
+}
+
+void
+SmpBenchTest::testRun() {
+    std::vector<Position> positions = SmpBench::defaultPositions();
+    positions.resize(2);
+    SmpBench bench(2, 6, 1);
+    std::vector<SmpBench::Result> results;
+    std::stringstream log;
+    bench.run(positions, results, log);
+    ASSERT_EQUAL(2, results.size());
+    for (int i = 0; i < 2; i++) {
+        const SmpBench::Result& r = results[i];
+        ASSERT_EQUAL(i + 1, r.nThreads);
+        ASSERT(r.nodes > 0);
+        ASSERT(r.helperJobs > 0);
+        ASSERT(r.helperResultsUsed <= r.helperResults);
+    }
+    ASSERT_EQUAL(0, results[0].helperResults);
+
+    std::stringstream csv;
+    SmpBench::printCsv(results, csv);
+    std::string line;
+    int nLines = 0;
+    while (std::getline(csv, line))
+        nLines++;
+    ASSERT_EQUAL(3, nLines);
+}
+
+void
+SmpBenchTest::testSharedEvalHash() {
+    std::vector<Position> positions = SmpBench::defaultPositions();
+    positions.resize(2);
+    SmpBench bench(2, 6, 1, true);
+    std::vector<SmpBench::Result> results;
+    std::stringstream log;
+    bench.run(positions, results, log);
+    ASSERT_EQUAL(4, results.size());
+    for (int i = 0; i < 4; i++) {
+        const SmpBench::Result& r = results[i];
+        ASSERT_EQUAL(i / 2 + 1, r.nThreads);
+        ASSERT_EQUAL(i % 2 != 0, r.sharedEvalHash);
+        ASSERT(r.nodes > 0);
+    }
+    // Shared tables must not change the evaluation, so the single
+    // threaded search trees are identical
+    ASSERT_EQUAL(results[0].nodes, results[1].nodes);
+
+    // The SharedEvalHash setting is restored after the benchmark
+    Parameters& params = Parameters::instance();
+    for (bool shared : { true, false }) {
+        params.set("SharedEvalHash", shared ? "true" : "false");
+        SmpBench bench2(1, 4, 1, true);
+        positions.resize(1);
+        bench2.run(positions, results, log);
+        ASSERT_EQUAL(shared, params.getBoolPar("SharedEvalHash"));
+    }
+}
+
+cute::suite
+SmpBenchTest::getSuite() const {
+    cute::suite s;
+    s.push_back(CUTE(testThreadCounts));
+    s.push_back(CUTE(testRun));
+    s.push_back(CUTE(testSharedEvalHash));
+    return s;
+}
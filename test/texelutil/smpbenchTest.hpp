@@ -0,0 +1,41 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * smpbenchTest.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef SMPBENCHTEST_HPP_
+#define SMPBENCHTEST_HPP_
+
+#include "utilSuiteBase.hpp"
+
+class SmpBenchTest : public UtilSuiteBase {
+    std::string getName() const override { return "SmpBenchTest"; }
+
+    cute::suite getSuite() const override;
+private:
+    static void testThreadCounts();
+    static void testRun();
+    static void testSharedEvalHash();
+};
+
+#endif /* SMPBENCHTEST_HPP_ */
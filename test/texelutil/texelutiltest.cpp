@@ -6,6 +6,10 @@
 #include "bookBuildTest.hpp"
 #include "proofgameTest.hpp"
 #include "gameTreeTest.hpp"
+#include "perftTest.hpp"
+#include "smpbenchTest.hpp"
+#include "timeReplayTest.hpp"
+#include "benchCmpTest.hpp"
 
 
 static void
@@ -19,6 +23,10 @@ runTests() {
     runSuite(BookBuildTest());
     runSuite(ProofGameTest());
     runSuite(GameTreeTest());
+    runSuite(PerfTTest());
+    runSuite(SmpBenchTest());
+    runSuite(TimeReplayTest());
+    runSuite(BenchCmpTest());
 }
 
 
@@ -0,0 +1,189 @@
+/*
+    Texel - A UCI chess engine.
+    Copyright (C) 2026  agent
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * timeReplayTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "timeReplayTest.hpp"
+#include "timereplay.hpp"
+#include "chessParseError.hpp"
+
+#include "cute.h"
+
+#include <sstream>
+
+using Iteration = TimeLog::Iteration;
+
+static Iteration
+makeIter(int depth, S64 timeMillis, U16 bestMove, int flags = 0) {
+    Iteration it;
+    it.depth = depth;
+    it.timeMillis = timeMillis;
+    it.bestMove = bestMove;
+    it.bestMoveNodes = 500;
+    it.flags = flags;
+    return it;
+}
+
+/** 60s left, no increment. Played move (3) found in the last iteration. */
+static TimeLog::Entry
+makeEntry() {
+    TimeLog::Entry e;
+    e.hashKey = 0x123456789abcdefULL;
+    e.timeLeft = 60000;
+    e.minTimeLimit = 1685;
+    e.maxTimeLimit = 6740;
+    e.earlyStopPercentage = 85;
+    e.timeUsed = 3000;
+    e.iterations.push_back(makeIter(1, 10, 1));
+    e.iterations.push_back(makeIter(2, 400, 2));
+    e.iterations.push_back(makeIter(3, 1000, 2));
+    e.iterations.push_back(makeIter(4, 1500, 2));
+    e.iterations.push_back(makeIter(5, 3000, 3));
+    return e;
+}
+
+void
+TimeReplayTest::testSerialize() {
+    TimeLog::Entry e1 = makeEntry();
+    TimeLog::Entry e2;
+    e2.timeLeft = 1234;
+    e2.increment = 100;
+    e2.movesToGo = 17;
+    e2.timeUsed = 77;
+    Iteration it = makeIter(17, 77, 0x4321, Iteration::FAIL_LOW | Iteration::INCOMPLETE);
+    it.bestMoveChanges = 3;
+    it.bestMoveNodes = 999;
+    e2.iterations.push_back(it);
+
+    std::stringstream ss;
+    TimeLog::write(ss, e1);
+    TimeLog::write(ss, e2);
+
+    TimeLog::Entry r;
+    ASSERT(TimeLog::read(ss, r));
+    ASSERT_EQUAL(e1.hashKey, r.hashKey);
+    ASSERT_EQUAL(60000, r.timeLeft);
+    ASSERT_EQUAL(1685, r.minTimeLimit);
+    ASSERT_EQUAL(6740, r.maxTimeLimit);
+    ASSERT_EQUAL(85, r.earlyStopPercentage);
+    ASSERT_EQUAL(3000, r.timeUsed);
+    ASSERT_EQUAL(5, r.iterations.size());
+    ASSERT_EQUAL(1500, r.iterations[3].timeMillis);
+    ASSERT_EQUAL(3, r.iterations[4].bestMove);
+
+    ASSERT(TimeLog::read(ss, r));
+    ASSERT_EQUAL(100, r.increment);
+    ASSERT_EQUAL(17, r.movesToGo);
+    ASSERT_EQUAL(1, r.iterations.size());
+    ASSERT_EQUAL(17, r.iterations[0].depth);
+    ASSERT_EQUAL(0x4321, r.iterations[0].bestMove);
+    ASSERT_EQUAL(3, r.iterations[0].bestMoveChanges);
+    ASSERT_EQUAL(999, r.iterations[0].bestMoveNodes);
+    ASSERT_EQUAL(Iteration::FAIL_LOW | Iteration::INCOMPLETE, r.iterations[0].flags);
+
+    ASSERT(!TimeLog::read(ss, r));
+}
+
+void
+TimeReplayTest::testFormula() {
+    TimeReplay::Formula f = TimeReplay::Formula::parse("min=70,max=300,moves=40,buffer=500,hard=0");
+    ASSERT_EQUAL(70, f.minTimeUsage);
+    ASSERT_EQUAL(300, f.maxTimeUsage);
+    ASSERT_EQUAL(40, f.maxRemainingMoves);
+    ASSERT_EQUAL(500, f.bufferTime);
+    ASSERT(!f.useHardFactor);
+
+    ASSERT_THROWS(TimeReplay::Formula::parse("min"), ChessParseError);
+    ASSERT_THROWS(TimeReplay::Formula::parse("foo=1"), ChessParseError);
+
+    f = TimeReplay::Formula::parse("moves=35,buffer=1000,max=400");
+    TimeLog::Entry e = makeEntry();
+    int minT, maxT;
+    TimeReplay::computeLimits(f, e, minT, maxT);
+    ASSERT_EQUAL(1685, minT);
+    ASSERT_EQUAL(6740, maxT);
+
+    e.movesToGo = 2;
+    TimeReplay::computeLimits(f, e, minT, maxT);
+    ASSERT_EQUAL(29500, minT);
+    ASSERT_EQUAL(59000, maxT);
+}
+
+void
+TimeReplayTest::testReplay() {
+    const TimeLog::Entry e = makeEntry();
+    const std::string base = "moves=35,buffer=1000,max=400,hard=0";
+    int lastIter;
+    bool censored;
+
+    // Stops after iteration 4, since 1500 > 0.85 * 1685
+    auto f = TimeReplay::Formula::parse(base + ",min=85");
+    ASSERT_EQUAL(1500, TimeReplay::replayEntry(f, e, lastIter, censored));
+    ASSERT_EQUAL(3, lastIter);
+    ASSERT(!censored);
+
+    // Iteration 5 is aborted when the minimum time limit is reached
+    f = TimeReplay::Formula::parse(base + ",min=100");
+    ASSERT_EQUAL(1685, TimeReplay::replayEntry(f, e, lastIter, censored));
+    ASSERT_EQUAL(3, lastIter);
+    ASSERT(!censored);
+
+    // Fail low allows using up to the maximum time limit
+    TimeLog::Entry e2 = makeEntry();
+    e2.iterations[4].flags = Iteration::FAIL_LOW;
+    ASSERT_EQUAL(3000, TimeReplay::replayEntry(f, e2, lastIter, censored));
+    ASSERT_EQUAL(4, lastIter);
+    ASSERT(!censored);
+
+    // Formula wants more time than the logged search used
+    e2.iterations[4].flags = Iteration::FAIL_LOW | Iteration::INCOMPLETE;
+    ASSERT_EQUAL(3000, TimeReplay::replayEntry(f, e2, lastIter, censored));
+    ASSERT_EQUAL(4, lastIter);
+    ASSERT(censored);
+
+    std::vector<TimeLog::Entry> entries { e, e };
+    TimeReplay::Result r = TimeReplay::logged(entries);
+    ASSERT_EQUAL(2, r.nMoves);
+    ASSERT_EQUAL(6000, r.timeUsed);
+    ASSERT_EQUAL(10, r.depthSum);
+    ASSERT_EQUAL(0, r.nChanged);
+    ASSERT_EQUAL(0, r.wastedTime);
+
+    f = TimeReplay::Formula::parse(base + ",min=85");
+    r = TimeReplay::replay(f, entries);
+    ASSERT_EQUAL(2, r.nMoves);
+    ASSERT_EQUAL(3000, r.timeUsed);
+    ASSERT_EQUAL(8, r.depthSum);
+    ASSERT_EQUAL(2, r.nChanged);
+    ASSERT_EQUAL(2 * (1500 - 400), r.wastedTime);
+    ASSERT_EQUAL(0, r.nCensored);
+}
+
+cute::suite
+TimeReplayTest::getSuite() const {
+    cute::suite s;
+    s.push_back(CUTE(testSerialize));
+    s.push_back(CUTE(testFormula));
+    s.push_back(CUTE(testReplay));
+    return s;
+}